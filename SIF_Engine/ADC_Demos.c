@@ -12,12 +12,29 @@ u32 ADC_NormalCompleted(u32 u) {
   return 0;
 }
 
+// The conversions to mV are the slow part: they run from PendSV (SebPendSV), after the ADC interrupt, and still before the main loop sees InjectedDone
+static u32 ADC_DeferredTable[8];
+static StuffsArtery_t ADC_Deferred;
+static OneJob_t ADC_InjectedJob;
+
+u32 ADC_InjectedConverted(u32 u) { // bottom half, from PendSV: ctJobs[0] is the ADC_t*
+  
+  ADC_t* A = (ADC_t*) ((u32*)u)[0];
+  ADC_ConvertInjectedTo_mV(A); // convert them to the mV and save in the structure for easy debug live watch monitoring
+  return 0;
+}
+
 u32 ADC_InjectedCompleted(u32 u) {
   
   ADC_t* A = (ADC_t*) u;
   Toggle_LED_2();
-  ADC_BackupInjected(A); // copy the injected DR values in the structure
-  ADC_ConvertInjectedTo_mV(A); // convert them to the mV and save in the structure for easy debug live watch monitoring
+  ADC_BackupInjected(A); // copy the injected DR values in the structure, before the next conversion overwrites them
+  ADC_InjectedJob.ctJobs[0] = u;
+#ifdef SebPendSV
+  DeferJob((u32)&ADC_InjectedJob);
+#else
+  ADC_InjectedConverted((u32)ADC_InjectedJob.ctJobs); // no PendSV handler here, convert in the interrupt
+#endif
   return 0;
 }
 
@@ -103,6 +120,10 @@ void ADC_Demo(void) {
   EnableADC(Adc2);
   EnableADC(Adc3);  
   
+  ADC_InjectedJob.fnJob = ADC_InjectedConverted;
+#ifdef SebPendSV
+  NewNVIC_Deferred((u32)NewSA_MPSC(&ADC_Deferred, (u32)ADC_DeferredTable, countof(ADC_DeferredTable)));
+#endif
   HookADC(Adc1, ADC_IT_EOC, (u32) ADC_NormalCompleted, (u32)Adc1);
   HookADC(Adc1, ADC_IT_JEOC, (u32) ADC_InjectedCompleted, (u32)Adc1);
   HookADC(Adc1, ADC_IT_AWD, (u32) ADC_Threshold, (u32)Adc1);
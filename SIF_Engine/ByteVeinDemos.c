@@ -1,7 +1,9 @@
 #include "SebEngine.h"
+#include <string.h>
 
 static ByteVein_t BV; // for test program
 static u8 BVR[512]; // the assigned buffer for this byte strand
+static u8 BVSpan[200]; // a span to glue and clip in one go
 
 
 void BV_Test(void) {
@@ -28,6 +30,139 @@ void BV_Test(void) {
   for(n=0;n<32;n++) 
     ClipBV_Up(&BV);
   
+  // batch watermarks, no hook: watch FlagHighWater and FlagLowWater go up once per batch
+  HookBV_HighWater(&BV, 150, 0, 0);
+  HookBV_LowWater(&BV, 50, 0, 0);
+
+  // bulk span, crossing the rollover point
+  for(n=0;n<sizeof(BVSpan);n++)
+    BVSpan[n] = n;
+  GlueBV_UpN(&BV, (u32)BVSpan, 100); // keep 100 bytes inside so the span walks around the buffer
+  for(n=0;n<8;n++) {
+    GlueBV_UpN(&BV, (u32)BVSpan, 200);
+    ClipBV_DownN(&BV, (u32)BVSpan, 200);
+  };
+
+  // zero copy reserve/commit, with partial completions crossing the rollover point (as a stopped DMA would do)
+  for(n=0;n<8;n++) {
+    u32 r = ReserveBV_Up(&BV);
+    memset((u8*)BV.pbUpReserved, n, r);
+    CommitBV_Up(&BV, r/2); // producer stopped half way
+    r = ReserveBV_Down(&BV);
+    CommitBV_Down(&BV, r - (r/3)); // consumer left some for later
+  };
+
+  while(1);
+}
+
+//==========================================================
+// Per byte versus bulk span throughput, run on target using the core cycle counter
+// Results are in cycles and bytes per second (watch them in the debugger), the host figures are ByteVein/PerByte and /Span in HostTests/QueueBench.c
+static u32 BV_Bench_cy[2]; // [0] per byte, [1] bulk span
+static u32 BV_Bench_Bps[2];
+
+void BV_Bench(void) {
+  
+  u32 n, loop, Start_cy;
+  NewBV(&BV, (u32)BVR, (s32)sizeof(BVR));
+  for(n=0;n<sizeof(BVSpan);n++)
+    BVSpan[n] = n;
+  
+  CoreDebug->DEMCR |= CoreDebug_DEMCR_TRCENA_Msk; // enable the DWT cycle counter
+  DWT->CYCCNT = 0;
+  DWT->CTRL |= DWT_CTRL_CYCCNTENA_Msk;
+  
+  Start_cy = DWT->CYCCNT;
+  for(loop=0;loop<100;loop++) {
+    for(n=0;n<sizeof(BVSpan);n++)
+      AddToBV(&BV, BVSpan[n]);
+    for(n=0;n<sizeof(BVSpan);n++)
+      ClipBV_Down(&BV);
+  };
+  BV_Bench_cy[0] = DWT->CYCCNT - Start_cy;
+  
+  Start_cy = DWT->CYCCNT;
+  for(loop=0;loop<100;loop++) {
+    GlueBV_UpN(&BV, (u32)BVSpan, sizeof(BVSpan));
+    ClipBV_DownN(&BV, (u32)BVSpan, sizeof(BVSpan));
+  };
+  BV_Bench_cy[1] = DWT->CYCCNT - Start_cy;
+  
+  // 100 x 200 bytes in and out
+  for(n=0;n<2;n++)
+    BV_Bench_Bps[n] = (u32)(((uint64_t)MCU_Clocks.OutCoreClk_Hz.Value * 100 * sizeof(BVSpan)) / BV_Bench_cy[n]);
+  
+  while(1);
+}
+
+
+//==========================================================
+// Rollover test versus power of two mask, for FIFO, LIFO and deque access patterns: one driver runs them all, Queue_BenchRun()
+// Compare QB_Results[0][][] with QB_Results[1][][] (watch them in the debugger), on a PC ByteVein versus ByteVeinPow2 in HostTests/QueueBench.c
+void BV_Pow2_Bench(void) {
+  
+  Queue_BenchRun(0);
+  while(1);
+}
+
+
+//==========================================================
+// Bit vein: a whole frame is built per field, then sent bit by bit (or per any width), crossing the rollover point
+static BitVein_t BiV;
+static u32 BiVR[4]; // 128 bits
+
+void BitV_Test(void) {
+
+  u32 n;
+  NewBitV(&BiV, (u32)BiVR, (s32)sizeof(BiVR));
+
+  for(n=0;n<8;n++) {
+    GlueBitV_Up(&BiV, 0, 1); // start
+    GlueBitV_Up(&BiV, __RBIT(0xA0<<24), 8); // address, MSB first
+    GlueBitV_Up(&BiV, 0x5, 4);
+    GlueBitV_Up(&BiV, 0x1234, 16);
+    GlueBitV_Up(&BiV, 0xABCDEF, 24);
+    GlueBitV_Up(&BiV, 0xDEADBEEF, 32); // 85 bits
+
+    ClipBitV_Down(&BiV, 1);
+    ClipBitV_Down(&BiV, 8);
+    ClipBitV_Down(&BiV, 4);
+    ClipBitV_Down(&BiV, 16);
+    ClipBitV_Down(&BiV, 24);
+    ClipBitV_Down(&BiV, 32); // BiV.Out = 0xDEADBEEF
+  };
+
+  GlueBitV_Down(&BiV, 0x3, 2); // the other side
+  ClipBitV_Down(&BiV, 2);
+
   while(1);
 }
 
+//==========================================================
+// Native width veins: 12 bit ADC samples and 32 bit timer captures, no packing
+static Vein16_t Samples;
+static u16 SamplesR[100];
+static u16 SamplesSpan[64];
+static Vein32_t Captures;
+static u32 CapturesR[16];
+
+void WideVein_Test(void) {
+
+  u32 n;
+  NewVein16(&Samples, (u32)SamplesR, countof(SamplesR));
+  NewVein32(&Captures, (u32)CapturesR, countof(CapturesR));
+
+  for(n=0;n<countof(SamplesSpan);n++)
+    SamplesSpan[n] = (n * 64) & 0xFFF;
+  for(n=0;n<8;n++) { // crossing the rollover point
+    GlueVein16_UpN(&Samples, (u32)SamplesSpan, countof(SamplesSpan));
+    ClipVein16_DownN(&Samples, (u32)SamplesSpan, countof(SamplesSpan));
+  };
+
+  for(n=0;n<16;n++)
+    AddToVein32(&Captures, 0x10000 + n * 1000);
+  for(n=0;n<16;n++)
+    ClipVein32_Down(&Captures);
+
+  while(1);
+}
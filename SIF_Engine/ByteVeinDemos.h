@@ -3,5 +3,9 @@
 #define _BYTE_VEIN_DEMO_H_
 
 void BV_Test(void);
+void BV_Bench(void);
+void BV_Pow2_Bench(void);
+void BitV_Test(void);
+void WideVein_Test(void);
 
 #endif
@@ -0,0 +1,96 @@
+#include "HostTests.h"
+
+// Bus utilization, one bus at a time (as StartJobToDoInForeground does) versus the round robin BusDispatcher_t, simulated
+// 3 buses, each job costs CPU ticks then keeps its bus busy (the DMA or the bit timing, callback armed) for some more ticks
+// [0] one bus at a time, [1] dispatcher: the total ticks and the average bus busy time in percent
+static u32 BusSim_Ticks[2];
+static u32 BusSim_Utilization_pc[2];
+
+#define BUS_SIM_BUSES 3
+#define BUS_SIM_JOBS 40 // per bus
+
+static BusDispatcher_t BusSim;
+static StuffsArtery_t BusSimSA[BUS_SIM_BUSES];
+static u32 BusSimSAR[BUS_SIM_BUSES][BUS_SIM_JOBS];
+static OneJob_t BusSimJobs[BUS_SIM_BUSES][BUS_SIM_JOBS];
+static u32 BusSimTicks;
+static u32 BusSimDone[BUS_SIM_BUSES]; // tick at which the bus is done, 0: not busy
+static u32 BusSimBusy; // sum of the bus busy ticks
+
+static u32 sq_BusSimJob(u32 u) { // p[0] bus, p[1] CPU ticks, p[2] bus ticks
+
+  u32* p = (u32*)u;
+  BusSimTicks += p[1];
+  BusSimBusy += p[1] + p[2];
+  if(p[2]==0) return 0;
+  BusSimDone[p[0]] = BusSimTicks + p[2];
+  return 1; // callback armed
+}
+
+static void BusSimTick(void) { // time goes on, the buses finishing call their interrupt hook
+
+  u32 b;
+  BusSimTicks++;
+  for(b=0;b<BUS_SIM_BUSES;b++)
+    if(BusSimDone[b] && ((s32)(BusSimTicks - BusSimDone[b])>=0)) {
+      BusSimDone[b] = 0;
+      ResumeJobToDo((u32)&BusSimSA[b]);
+    };
+}
+
+static u32 BusSimRemaining(void) {
+
+  u32 b, n = 0;
+  for(b=0;b<BUS_SIM_BUSES;b++)
+    n += BusSimSA[b].bCount + BusSimSA[b].JobArmed;
+  return n;
+}
+
+static void BusSimRun(u32 Dispatcher) {
+
+  u32 b, n;
+
+  BusSimTicks = BusSimBusy = 0;
+  NewBusDispatcher(&BusSim);
+  for(b=0;b<BUS_SIM_BUSES;b++) {
+    NewSA(&BusSimSA[b], (u32)BusSimSAR[b], countof(BusSimSAR[b]));
+    for(n=0;n<BUS_SIM_JOBS;n++) { // a mix of short register accesses and longer block moves
+      BusSimJobs[b][n] = (OneJob_t) { sq_BusSimJob, { b, 2, (n & 3) ? 10 : 40 } };
+      AddToSA(&BusSimSA[b], (u32)&BusSimJobs[b][n]);
+    };
+    if(Dispatcher)
+      AddBusToDispatcher(&BusSim, &BusSimSA[b]);
+  };
+
+  if(Dispatcher) {
+    while(BusSimRemaining())
+      if(BusDispatcherJobToDo((u32)&BusSim)==0)
+        BusSimTick(); // no bus ready: idle
+  }else{
+    for(b=0;b<BUS_SIM_BUSES;b++) { // each bus drained before the next one, the CPU waits for the interrupts
+      NewBusDispatcher(&BusSim);
+      AddBusToDispatcher(&BusSim, &BusSimSA[b]);
+      while(BusSimSA[b].bCount + BusSimSA[b].JobArmed)
+        if(BusDispatcherJobToDo((u32)&BusSim)==0)
+          BusSimTick();
+    };
+  };
+
+  BusSim_Ticks[Dispatcher] = BusSimTicks;
+  BusSim_Utilization_pc[Dispatcher] = BusSimBusy * 100 / (BusSimTicks * BUS_SIM_BUSES);
+}
+
+// A bus is busy 40 x 2 CPU ticks + 10 x 40 + 30 x 10 bus ticks = 780 ticks: one bus at a time runs the 3 of them in a row,
+// the round robin overlaps them and ends 6 ticks after one bus alone would (the CPU ticks of the other buses when they collide)
+#define BUS_SIM_BUSY (BUS_SIM_JOBS * 2 + (BUS_SIM_JOBS/4) * 40 + (BUS_SIM_JOBS - BUS_SIM_JOBS/4) * 10)
+
+int main(void) {
+
+  BusSimRun(0);
+  BusSimRun(1);
+  CHECK((BusSim_Ticks[0]==BUS_SIM_BUSES * BUS_SIM_BUSY) && (BusSim_Ticks[0]==2340) && (BusSim_Utilization_pc[0]==33));
+  CHECK((BusSim_Ticks[1]==786) && (BusSim_Utilization_pc[1]>=99));
+  printf("BusDispatcher_Tests ok, %u ticks %u%% busy one bus at a time, %u ticks %u%% busy round robin\n",
+    (unsigned)BusSim_Ticks[0], (unsigned)BusSim_Utilization_pc[0], (unsigned)BusSim_Ticks[1], (unsigned)BusSim_Utilization_pc[1]);
+  return 0;
+}
@@ -0,0 +1,113 @@
+#include "HostTests.h"
+
+// CoalesceSA_Moves(): what is merged, what is not, the pool slots over several passes and the queue rollover
+// Move stands for an SPI move { bus, TX, RX, count }, MoveMore for a write only I2C move { bus, block, count, more coming }
+static u32 Move(u32 u) { return u; }
+static u32 MoveMore(u32 u) { return u; }
+static u32 Other(u32 u) { return u; }
+static const MoveJobLayout_t Layouts[] = { { Move, 1, 2, 3, 0 }, { MoveMore, 1, 0, 2, 3 } };
+
+static StuffsArtery_t SA;
+static u32 SAR[8];
+static JobCoalescer_t JC;
+static OneJob_t Pool[2];
+static OneJob_t Jobs[8];
+static u8 TX[0x30000], RX[256];
+
+static void Queue(u32 n) { AddToSA(&SA, (u32)&Jobs[n]); }
+
+static OneJob_t* Clip(void) { ClipSA_Down(&SA); return (OneJob_t*)SA.Out; }
+
+int main(void) {
+
+  OneJob_t* J;
+  u32 n;
+
+  NewSA(&SA, (u32)SAR, countof(SAR));
+  NewJobCoalescer(&JC, Layouts, countof(Layouts), Pool, countof(Pool));
+
+  // 3 contiguous moves with their RX contiguous too: one transfer from a pool slot, the queued jobs untouched
+  for(n=0;n<3;n++) {
+    Jobs[n] = (OneJob_t) { Move, { 1, (u32)&TX[4*n], (u32)&RX[4*n], 4 } };
+    Queue(n);
+  };
+  CHECK(CoalesceSA_Moves(&SA, &JC)==2);
+  CHECK((SA.bCount==1) && (JC.Merged==1) && (JC.PoolUsed==1) && (JC.BytesMerged==12));
+  CHECK((SA.Table[SA.pbDown]==(u32)&Pool[0]) && (Pool[0].ctJobs[1]==(u32)TX) && (Pool[0].ctJobs[2]==(u32)RX) && (Pool[0].ctJobs[3]==12));
+  CHECK(Jobs[0].ctJobs[3]==4);
+
+  // a second pass: the merged job still queued keeps its slot and grows in place
+  Jobs[3] = (OneJob_t) { Move, { 1, (u32)&TX[12], (u32)&RX[12], 4 } };
+  Queue(3);
+  CHECK(CoalesceSA_Moves(&SA, &JC)==1);
+  CHECK((SA.bCount==1) && (JC.Merged==1) && (JC.PoolUsed==1) && (Pool[0].ctJobs[3]==16) && (JC.Passes==2));
+
+  // once it left the queue its slot is free again
+  CHECK(Clip()==&Pool[0]);
+  Jobs[4] = (OneJob_t) { Move, { 1, (u32)&TX[100], (u32)&RX[100], 2 } };
+  Jobs[5] = (OneJob_t) { Move, { 1, (u32)&TX[102], (u32)&RX[102], 2 } };
+  Queue(4); Queue(5);
+  CHECK(CoalesceSA_Moves(&SA, &JC)==1);
+  CHECK((JC.PoolUsed==1) && (Clip()==&Pool[0]) && (Pool[0].ctJobs[1]==(u32)&TX[100]) && (Pool[0].ctJobs[3]==4));
+
+  // the pool full: the other groups stay as queued
+  for(n=0;n<6;n++) {
+    Jobs[n] = (OneJob_t) { Move, { 1 + n/2, (u32)&TX[4*n], (u32)&RX[4*n], 4 } }; // 3 buses, 2 moves each
+    Queue(n);
+  };
+  CHECK(CoalesceSA_Moves(&SA, &JC)==2);
+  CHECK((SA.bCount==4) && (JC.PoolUsed==2));
+  CHECK((Clip()==&Pool[0]) && (Clip()==&Pool[1]) && (Clip()==&Jobs[4]) && (Clip()==&Jobs[5]));
+
+  // an SPI move needs its RX contiguous as well, or both without RX
+  Jobs[0] = (OneJob_t) { Move, { 1, (u32)&TX[0], (u32)&RX[0], 4 } };
+  Jobs[1] = (OneJob_t) { Move, { 1, (u32)&TX[4], (u32)&RX[8], 4 } }; // RX gap
+  Jobs[2] = (OneJob_t) { Move, { 1, (u32)&TX[8], 0, 4 } }; // RX after a move with one
+  Jobs[3] = (OneJob_t) { Move, { 1, (u32)&TX[12], 0, 4 } }; // TX only after TX only: with an RX index, both buffers must be non zero
+  Queue(0); Queue(1); Queue(2); Queue(3);
+  CHECK(CoalesceSA_Moves(&SA, &JC)==0);
+  CHECK(SA.bCount==4);
+  while(SA.bCount) Clip();
+
+  // the 64KB cap, SQ_MOVE_MAX 65535 bytes
+  Jobs[0] = (OneJob_t) { Move, { 1, (u32)&TX[0], 0x10000 + (u32)RX, 30000 } };
+  Jobs[1] = (OneJob_t) { Move, { 1, (u32)&TX[30000], 0x10000 + (u32)RX + 30000, 35535 } }; // 65535 in all
+  Jobs[2] = (OneJob_t) { Move, { 1, (u32)&TX[65535], 0x10000 + (u32)RX + 65535, 1 } }; // one more byte
+  Queue(0); Queue(1); Queue(2);
+  CHECK(CoalesceSA_Moves(&SA, &JC)==1);
+  CHECK((SA.bCount==2) && (Clip()==&Pool[0]) && (Pool[0].ctJobs[3]==65535) && (Clip()==&Jobs[2]));
+
+  // the more coming flag: merged only while the bus doesn't stop, the merged job takes the flag of the last one
+  Jobs[0] = (OneJob_t) { MoveMore, { 1, (u32)&TX[0], 2, 1 } };
+  Jobs[1] = (OneJob_t) { MoveMore, { 1, (u32)&TX[2], 2, 0 } }; // the stop
+  Jobs[2] = (OneJob_t) { MoveMore, { 1, (u32)&TX[4], 2, 1 } };
+  Queue(0); Queue(1); Queue(2);
+  CHECK(CoalesceSA_Moves(&SA, &JC)==1);
+  CHECK((Clip()==&Pool[0]) && (Pool[0].ctJobs[2]==4) && (Pool[0].ctJobs[3]==0) && (Clip()==&Jobs[2]));
+
+  // I2C_MasterIO is not in MoveJobLayouts[]: a read clocks one more byte than its count, two reads merged are not the same transaction
+  CHECK((MoveJobLayoutsCount==1) && (MoveJobLayouts[0].fnMove==sq_SPI_MHW_MoveJob));
+
+  // the queue wraps around the end of its table: the jobs are compacted across the rollover
+  NewJobCoalescer(&JC, Layouts, countof(Layouts), Pool, countof(Pool));
+  Jobs[6] = (OneJob_t) { Other, { 0 } }; // not a move
+  Queue(6);
+  for(n=0;n<5;n++) { Queue(6); Clip(); }; // one job left, the tail at 5 of 8
+  for(n=0;n<5;n++) {
+    Jobs[n] = (OneJob_t) { Move, { 1, (u32)&TX[4*n], (u32)&RX[4*n], 4 } };
+    Queue(n);
+  };
+  Jobs[5] = (OneJob_t) { Move, { 2, (u32)&TX[20], (u32)&RX[20], 4 } }; // another bus
+  Queue(5);
+  CHECK((SA.pbDown==5) && (SA.pbUp==3));
+  CHECK(CoalesceSA_Moves(&SA, &JC)==4);
+  CHECK((SA.bCount==3) && (SA.pbDown==5) && (SA.pbUp==7));
+  CHECK(Clip()==&Jobs[6]);
+  J = Clip();
+  CHECK((J==&Pool[0]) && (J->ctJobs[1]==(u32)TX) && (J->ctJobs[3]==20));
+  Queue(0); // the artery goes on from there, across the end of the table
+  CHECK((SA.pbUp==0) && (Clip()==&Jobs[5]) && (Clip()==&Jobs[0]));
+
+  printf("Coalesce_Tests ok\n");
+  return 0;
+}
@@ -0,0 +1,171 @@
+#include "HostTests.h"
+
+// The deadline scheduler: released jobs by deadline, waiting ones by release, the misses counted
+static DeadlineScheduler_t E;
+static DeadlineJob_t Table[8];
+static Timer_t Timer; // only Ticks is used
+static u32 Log[8], nLog, Misses;
+
+static u32 Rec(u32 u) { Log[nLog++] = *(u32*)u; return 0; } // u: ctJobs
+static u32 Missed(u32 u) { Misses++; return u; }
+static OneJob_t Jobs[4] = { { Rec, { 0 } }, { Rec, { 1 } }, { Rec, { 2 } }, { Rec, { 3 } } };
+
+// Deadline miss rate, earliest deadline first versus the FIFO main loop servicing, under the same synthetic periodic load
+// The time base is a Timer_t whose Ticks are advanced by the simulated jobs (their cost) or by the idle loop
+// [0] the FIFO main loop (MainLoopServicingSA() of myMCU.c, one job per call), [1] EDFJobToDo(). Miss rates in per mille of the jobs
+static u32 EDF_Sim_Jobs[2];
+static u32 EDF_Sim_Missed[2];
+static u32 EDF_Sim_MissRate_pm[2];
+static u32 EDF_Sim_WorstLateness[2];
+
+typedef struct {
+  u16 Period;
+  u16 Cost;
+  u16 Deadline; // relative to the release
+} EDF_SimTask_t;
+
+static const EDF_SimTask_t EDF_SimTasks[] = { // about 90% load, non preemptive
+  { 10, 2, 6 },
+  { 20, 4, 20 },
+  { 40, 10, 40 },
+  { 50, 12, 50 },
+};
+
+#define EDF_SIM_TICKS 100000
+
+static Timer_t EDF_SimTimer; // only Ticks is used
+static OneJob_t EDF_SimJobs[64]; // the posted instances, reused round robin
+static u32 EDF_SimNext;
+static StuffsArtery_t EDF_SimSA;
+static u32 EDF_SimSAR[64];
+static DeadlineScheduler_t EDF_Sim;
+static DeadlineJob_t EDF_SimR[64];
+
+static u32 MainLoopServicingSA(u32 u) { // as in myMCU.c, which does not build on a PC
+
+  StuffsArtery_t* SA = (StuffsArtery_t*) u;
+  OneJob_t* Job;
+
+  if(SA->bCount==0) return 0; // nothing to do
+  ClipSA_Down(SA);
+  Job = (OneJob_t*)SA->Out;
+  return Job->fnJob((u32)Job->ctJobs);
+}
+
+static u32 sq_EDF_SimWork(u32 u) { // p[0] cost, p[1] deadline, p[2] policy
+
+  u32* p = (u32*)u;
+  EDF_SimTimer.Ticks += p[0];
+  EDF_Sim_Jobs[p[2]]++;
+  if((s32)(EDF_SimTimer.Ticks - p[1])>0) { // too late
+    EDF_Sim_Missed[p[2]]++;
+    if((EDF_SimTimer.Ticks - p[1])>EDF_Sim_WorstLateness[p[2]])
+      EDF_Sim_WorstLateness[p[2]] = EDF_SimTimer.Ticks - p[1];
+  };
+  return 0;
+}
+
+static void EDF_SimRun(u32 Policy) {
+
+  u32 t, Dispatched;
+  u32 Release[countof(EDF_SimTasks)];
+  OneJob_t* Job;
+
+  EDF_SimTimer.Ticks = 0;
+  for(t=0;t<countof(EDF_SimTasks);t++)
+    Release[t] = t; // a bit of phase
+
+  while(EDF_SimTimer.Ticks<EDF_SIM_TICKS) {
+
+    for(t=0;t<countof(EDF_SimTasks);t++) // post the released instances
+      while((s32)(EDF_SimTimer.Ticks - Release[t])>=0) {
+        Job = &EDF_SimJobs[EDF_SimNext++ % countof(EDF_SimJobs)];
+        *Job = (OneJob_t) { sq_EDF_SimWork, { EDF_SimTasks[t].Cost, Release[t] + EDF_SimTasks[t].Deadline, Policy } };
+        if(Policy==0) {
+          AddToSA(&EDF_SimSA, (u32)Job);
+        }else{
+          AddJobToEDF(&EDF_Sim, Job, Release[t], Release[t] + EDF_SimTasks[t].Deadline);
+        };
+        Release[t] += EDF_SimTasks[t].Period;
+      };
+
+    if(Policy==0) {
+      Dispatched = EDF_SimSA.bCount;
+      MainLoopServicingSA((u32)&EDF_SimSA);
+    }else{
+      Dispatched = EDF_Sim.Dispatched;
+      EDFJobToDo((u32)&EDF_Sim);
+      Dispatched = EDF_Sim.Dispatched - Dispatched;
+    };
+    if(Dispatched==0) // idle
+      EDF_SimTimer.Ticks++;
+  };
+
+  EDF_Sim_MissRate_pm[Policy] = EDF_Sim_Missed[Policy] * 1000 / EDF_Sim_Jobs[Policy];
+}
+
+int main(void) {
+
+  NewEDF(&E, (u32)Table, countof(Table), &Timer);
+  CHECK(E.FlagEmptied && (E.FlagMissed==0));
+
+  Timer.Ticks = 100;
+  AddJobToEDF(&E, &Jobs[0], 100, 130);
+  AddJobToEDF(&E, &Jobs[1], 100, 110);
+  AddJobToEDF(&E, &Jobs[2], 105, 106); // the earliest deadline, not released yet
+  AddJobToEDF(&E, &Jobs[3], 100, 120);
+  CHECK((E.FlagEmptied==0) && (E.bReady==3) && (E.bWaiting==1));
+
+  EDFJobToDo((u32)&E);
+  EDFJobToDo((u32)&E);
+  Timer.Ticks = 105;
+  EDFJobToDo((u32)&E);
+  CHECK((nLog==3) && (Log[0]==1) && (Log[1]==3) && (Log[2]==2));
+  CHECK((E.Missed==0) && (E.FlagEmptied==0));
+
+  Timer.Ticks = 140; // job 0 returns 10 ticks late
+  EDFJobToDo((u32)&E);
+  CHECK((nLog==4) && (Log[3]==0));
+  CHECK((E.Missed==1) && (E.WorstLateness==10) && E.FlagMissed && E.FlagEmptied);
+  CHECK(EDFJobToDo((u32)&E)==0);
+  CHECK(E.Dispatched==4);
+
+  // adding a job (from an interrupt) only touches FlagEmptied
+  AddJobToEDF(&E, &Jobs[0], 140, 141);
+  CHECK((E.FlagEmptied==0) && E.FlagMissed);
+
+  // with a hook, the miss goes there
+  HookEDF_Missed(&E, Missed, 0);
+  E.FlagMissed = 0;
+  Timer.Ticks = 150;
+  EDFJobToDo((u32)&E);
+  CHECK((Misses==1) && (E.Missed==2) && (E.FlagMissed==0) && (E.WorstLateness==10));
+
+  // the 32 bit tick wrap: order and lateness across 0xFFFFFFFF
+  NewEDF(&E, (u32)Table, countof(Table), &Timer);
+  nLog = 0;
+  Timer.Ticks = 0xFFFFFFF0;
+  AddJobToEDF(&E, &Jobs[0], 0xFFFFFFF0, 0x00000010);
+  AddJobToEDF(&E, &Jobs[1], 0xFFFFFFF0, 0xFFFFFFF8);
+  AddJobToEDF(&E, &Jobs[2], 0x00000002, 0x00000004); // released after the wrap
+  CHECK((E.bReady==2) && (E.bWaiting==1));
+  EDFJobToDo((u32)&E);
+  Timer.Ticks = 0x00000008;
+  EDFJobToDo((u32)&E);
+  EDFJobToDo((u32)&E);
+  CHECK((nLog==3) && (Log[0]==1) && (Log[1]==2) && (Log[2]==0));
+  CHECK((E.Missed==1) && (E.WorstLateness==4)); // job 2, 4 ticks after its deadline
+
+  // the simulation, about 90% load: EDF misses fewer jobs and by less. Not none, non preemptive: a 12 tick job still blocks the 6 tick deadlines
+  NewSA(&EDF_SimSA, (u32)EDF_SimSAR, countof(EDF_SimSAR));
+  NewEDF(&EDF_Sim, (u32)EDF_SimR, countof(EDF_SimR), &EDF_SimTimer);
+  EDF_SimRun(0);
+  EDF_SimRun(1);
+  CHECK((EDF_Sim_Jobs[0]==19500) && (EDF_Sim_Jobs[1]==19500));
+  CHECK((EDF_Sim_MissRate_pm[0]==256) && (EDF_Sim_WorstLateness[0]==14));
+  CHECK((EDF_Sim_MissRate_pm[1]==205) && (EDF_Sim_WorstLateness[1]==6));
+  CHECK((EDF_Sim.Missed==EDF_Sim_Missed[1]) && (EDF_Sim.WorstLateness==EDF_Sim_WorstLateness[1]));
+
+  printf("EDF_Tests ok, simulated miss rate %u per mille by FIFO, %u by EDF\n", (unsigned)EDF_Sim_MissRate_pm[0], (unsigned)EDF_Sim_MissRate_pm[1]);
+  return 0;
+}
@@ -0,0 +1,229 @@
+#include "HostBench.h"
+#include <time.h>
+
+u8 BenchTimed;
+
+static uint64_t* Samples; // per call ns of the distribution pass
+static u32 nSamples;
+static uint64_t Overhead_ns; // reading the clock twice
+
+#define BENCH_NAMES 256
+
+typedef struct {
+  char Name[64];
+  double ns_per_op;
+  double Cost; // ns_per_op in calibration ops, the figure compared
+} BenchEntry_t;
+
+static BenchEntry_t Baseline[BENCH_NAMES], Record[BENCH_NAMES];
+static u32 nBaseline, nRecord;
+static const char* File;
+static u8 Recording;
+static u32 Tolerance_percent = 30;
+static u32 Regressions, Unrecorded;
+
+// A fixed amount of work timed next to each run: a host running slower (clock, other loads, a busy sibling thread) slows both,
+// so the figures are compared with the baseline as a cost in calibration ops, not in plain ns.
+// The work is a plain ring called through pointers as the benches call the engine, it suffers from the host the same way
+#define CAL_OPS (512*64)
+
+static u8 CalRing[64];
+static u32 CalHead, CalTail;
+volatile u32 CalSink;
+
+static __attribute__((noinline)) void CalGlue(void) { CalRing[CalHead & 63] = CalHead; CalHead++; }
+static __attribute__((noinline)) void CalClip(void) { CalSink = CalRing[CalTail & 63]; CalTail++; }
+static void (* volatile fnCalGlue)(void) = CalGlue;
+static void (* volatile fnCalClip)(void) = CalClip;
+
+static double Calibrate_ns_per_op(void) {
+
+  uint64_t Start_ns = BenchNow_ns();
+  u32 i, n;
+
+  for(n=0;n<CAL_OPS/64;n++) {
+    for(i=0;i<32;i++) fnCalGlue();
+    for(i=0;i<32;i++) fnCalClip();
+  };
+  return (double)(BenchNow_ns() - Start_ns) / CAL_OPS;
+}
+
+uint64_t BenchNow_ns(void) {
+
+  struct timespec T;
+  clock_gettime(CLOCK_MONOTONIC, &T);
+  return (uint64_t)T.tv_sec * 1000000000 + T.tv_nsec;
+}
+
+void BenchSample(uint64_t Start_ns) {
+
+  uint64_t ns = BenchNow_ns() - Start_ns;
+  if(nSamples<BENCH_SAMPLES)
+    Samples[nSamples++] = (ns>Overhead_ns) ? ns - Overhead_ns : 0;
+}
+
+static int Ascending(const void* a, const void* b) {
+
+  uint64_t x = *(const uint64_t*)a, y = *(const uint64_t*)b;
+  return (x>y) - (x<y);
+}
+
+static int AscendingDouble(const void* a, const void* b) {
+
+  double x = *(const double*)a, y = *(const double*)b;
+  return (x>y) - (x<y);
+}
+
+static BenchEntry_t* Find(BenchEntry_t* Table, u32 n, const char* Name) {
+
+  u32 i;
+  for(i=0;i<n;i++)
+    if(strcmp(Table[i].Name, Name)==0) return &Table[i];
+  return 0;
+}
+
+static void Load(const char* Name) {
+
+  FILE* F = fopen(Name, "r");
+  if(F==0) return; // no baseline yet
+  while((nBaseline<BENCH_NAMES) && (fscanf(F, "%63s %lf %lf", Baseline[nBaseline].Name, &Baseline[nBaseline].ns_per_op, &Baseline[nBaseline].Cost)==3))
+    nBaseline++;
+  fclose(F);
+}
+
+void BenchBegin(int argc, char** argv) {
+
+  int i;
+  uint64_t Start_ns, ns;
+
+  for(i=1;i<argc;i++) {
+    if((strcmp(argv[i], "-r")==0) && (i + 1<argc)) { File = argv[++i]; Recording = 1; }
+    else if((strcmp(argv[i], "-c")==0) && (i + 1<argc)) File = argv[++i];
+    else if((strcmp(argv[i], "-t")==0) && (i + 1<argc)) Tolerance_percent = atoi(argv[++i]);
+    else { printf("usage: %s [-r baseline | -c baseline [-t percent]]\n", argv[0]); exit(2); };
+  };
+  if(File) Load(File);
+
+  Samples = malloc(BENCH_SAMPLES * sizeof(uint64_t));
+  if(Samples==0) { perror("malloc"); exit(1); };
+
+  Overhead_ns = ~0ULL;
+  for(i=0;i<1000;i++) {
+    Start_ns = BenchNow_ns();
+    ns = BenchNow_ns() - Start_ns;
+    if(ns<Overhead_ns) Overhead_ns = ns;
+  };
+}
+
+static void Compare(const char* Name, double ns_per_op, double Cost) {
+
+  BenchEntry_t* B;
+  double Change;
+
+  if(nRecord<BENCH_NAMES) {
+    snprintf(Record[nRecord].Name, sizeof(Record[0].Name), "%s", Name);
+    Record[nRecord].ns_per_op = ns_per_op;
+    Record[nRecord++].Cost = Cost;
+  };
+  if((File==0) || Recording) {
+    printf("\n");
+    return;
+  };
+
+  B = Find(Baseline, nBaseline, Name);
+  if(B==0) {
+    Unrecorded++;
+    printf("  no baseline\n");
+    return;
+  };
+  Change = (Cost / B->Cost - 1) * 100;
+  printf("  %+.0f%%", Change);
+  if(Change>Tolerance_percent) {
+    Regressions++;
+    printf(" REGRESSION");
+  };
+  printf("\n");
+}
+
+double BenchRun(const char* Name, void (*New)(void*), void (*Round)(void*), void* p, u32 Rounds, u32 Ops) {
+
+  uint64_t Start_ns, ns, Best_ns = ~0ULL;
+  u32 Repeat, r;
+  double Cal, ns_per_op, Costs[BENCH_REPEATS];
+
+  // average, not disturbed by the per call timing. Each run is costed against the calibration just before it, the median cost is kept
+  BenchTimed = 0;
+  for(Repeat=0;Repeat<BENCH_REPEATS;Repeat++) {
+    Cal = Calibrate_ns_per_op();
+    New(p);
+    Start_ns = BenchNow_ns();
+    for(r=0;r<Rounds;r++) Round(p);
+    ns = BenchNow_ns() - Start_ns;
+    if(ns<Best_ns) Best_ns = ns;
+    Costs[Repeat] = ((double)ns / ((double)Rounds * Ops)) / Cal;
+  };
+  qsort(Costs, BENCH_REPEATS, sizeof(double), AscendingDouble);
+  ns_per_op = (double)Best_ns / ((double)Rounds * Ops);
+
+  // distribution, call by call
+  nSamples = 0;
+  New(p);
+  BenchTimed = 1;
+  for(r=0;r<Rounds;r++) Round(p);
+  BenchTimed = 0;
+  qsort(Samples, nSamples, sizeof(uint64_t), Ascending);
+
+  printf("%-32s %8.1f Mops/s %7.2f ns/op", Name, 1000 / ns_per_op, ns_per_op);
+  if(nSamples)
+    printf("  p50 %3llu p99 %4llu max %6llu ns", (unsigned long long)Samples[nSamples / 2],
+      (unsigned long long)Samples[(u32)(((uint64_t)nSamples * 99) / 100)], (unsigned long long)Samples[nSamples - 1]);
+  Compare(Name, ns_per_op, Costs[BENCH_REPEATS / 2]);
+  return ns_per_op;
+}
+
+double BenchMeasure(const char* Name, double (*Measure)(void*), void* p) {
+
+  u32 Repeat;
+  double Cal, ns, Best_ns = 1e30, Costs[BENCH_REPEATS];
+
+  for(Repeat=0;Repeat<BENCH_REPEATS;Repeat++) { // as BenchRun(): each run costed against the calibration just before it
+    Cal = Calibrate_ns_per_op();
+    ns = Measure(p);
+    if(ns<Best_ns) Best_ns = ns;
+    Costs[Repeat] = ns / Cal;
+  };
+  qsort(Costs, BENCH_REPEATS, sizeof(double), AscendingDouble);
+  printf("%-32s %8.1f Mops/s %7.2f ns/op", Name, 1000 / Best_ns, Best_ns);
+  Compare(Name, Best_ns, Costs[BENCH_REPEATS / 2]);
+  return Best_ns;
+}
+
+int BenchEnd(void) {
+
+  FILE* F;
+  BenchEntry_t* B;
+  u32 i;
+
+  if(Recording) { // the other benches share the file: their names are kept
+    for(i=0;i<nRecord;i++) {
+      B = Find(Baseline, nBaseline, Record[i].Name);
+      if(B==0) {
+        if(nBaseline==BENCH_NAMES) break;
+        B = &Baseline[nBaseline++];
+      };
+      *B = Record[i];
+    };
+    F = fopen(File, "w");
+    if(F==0) { perror(File); return 1; };
+    for(i=0;i<nBaseline;i++)
+      fprintf(F, "%s %.2f %.3f\n", Baseline[i].Name, Baseline[i].ns_per_op, Baseline[i].Cost);
+    fclose(F);
+    printf("%u figures recorded in %s\n", (unsigned)nRecord, File);
+    return 0;
+  };
+
+  if(File==0) return 0;
+  if(Unrecorded) printf("%u figures without baseline: record them with \"make baseline\"\n", (unsigned)Unrecorded);
+  if(Regressions) printf("%u figures slower than their baseline by more than %u%%\n", (unsigned)Regressions, (unsigned)Tolerance_percent);
+  return (Regressions || Unrecorded) ? 1 : 0;
+}
@@ -0,0 +1,28 @@
+#ifndef _HOST_BENCH_H_
+#define _HOST_BENCH_H_
+
+#include "HostTests.h"
+
+// Host benchmarks: the engine built -O2 without the sanitizers (see Makefile), timed with clock_gettime(CLOCK_MONOTONIC)
+// Each result has a name and gets ops/s, ns/op (average) and p50/p99/max ns (per timed call, the clock reading taken out)
+// "bench -r file" records the ns/op in the baseline file (the other names kept), "bench -c file -t percent" fails when one is slower by more than percent
+
+#define BENCH_REPEATS 31 // ns/op is the best of these runs, the figure compared with the baseline their median cost (see HostBench.c)
+#define BENCH_SAMPLES (1<<20) // timed calls kept per result
+
+extern u8 BenchTimed;
+
+uint64_t BenchNow_ns(void);
+void BenchSample(uint64_t Start_ns);
+
+// a call timed on its own when BenchTimed is set (the distribution pass), as is otherwise (the average pass)
+#define BENCH_CALL(call) do { if(BenchTimed) { uint64_t Start_ns = BenchNow_ns(); call; BenchSample(Start_ns); } else { call; }; } while(0)
+
+void BenchBegin(int argc, char** argv);
+// New(p) then Rounds x Round(p), each round doing Ops calls through BENCH_CALL(). Returns the average ns/op
+double BenchRun(const char* Name, void (*New)(void*), void (*Round)(void*), void* p, u32 Rounds, u32 Ops);
+// timed by the bench itself: Measure(p) returns the ns/op of one run, BENCH_REPEATS runs compared with the baseline as BenchRun() does
+double BenchMeasure(const char* Name, double (*Measure)(void*), void* p);
+int BenchEnd(void); // writes the record, returns 1 if anything regressed or has no baseline
+
+#endif
@@ -0,0 +1,65 @@
+#define _GNU_SOURCE // MAP_32BIT
+#include "HostTests.h"
+#include <sys/mman.h>
+
+// The MCU seen by the engine on a host build: registers as RAM, the exception state set by the tests
+NVIC_Host_t HostNVIC;
+SCB_Host_t HostSCB;
+DWT_Host_t HostDWT;
+CoreDebug_Host_t HostCoreDebug;
+EXTI_TypeDef HostEXTI;
+TIM_TypeDef HostTIM[15];
+USART_TypeDef HostUSART[7];
+u32 HostIPSR;
+u32 HostPRIMASK;
+
+void NVIC_SetPriority(IRQn_Type IRQn, u32 Priority) {
+
+  if((s32)IRQn<0)
+    HostSCB.SHP[((u32)IRQn & 0xF) - 4] = Priority << (8 - __NVIC_PRIO_BITS);
+  else
+    HostNVIC.IP[IRQn] = Priority << (8 - __NVIC_PRIO_BITS);
+}
+
+// The bus move named by MoveJobLayouts[], SPI_MasterHW is not built
+__attribute__((weak)) u32 sq_SPI_MHW_MoveJob(u32 u) { (void)u; while(1); }
+
+// SebPrintf.c is not built (it calls the LCD directly), the NVIC_StatsDump() output is not checked
+__attribute__((weak)) u32 SebPrintf(PrintfHk_t* T, const char *str,...) { (void)T; (void)str; return 0; }
+
+// u32 is 32 bit as on the target, and the engine keeps addresses in it: the code and the statics are linked low (-no-pie),
+// main() and the test threads run on stacks mapped below 2GB, so every address of the test fits
+#define HOST_STACK (8<<20)
+
+pthread_t HostThread(void* (*fn)(void*), void* arg) {
+
+  pthread_attr_t A;
+  pthread_t T;
+  void* Stack = mmap(0, HOST_STACK, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS | MAP_32BIT, -1, 0);
+  if(Stack==MAP_FAILED) { perror("mmap"); exit(1); }
+  pthread_attr_init(&A);
+  pthread_attr_setstack(&A, Stack, HOST_STACK);
+  if(pthread_create(&T, &A, fn, arg)) { perror("pthread_create"); exit(1); }
+  pthread_attr_destroy(&A);
+  return T;
+}
+
+int __real_main(int argc, char** argv); // the tests take none, the benches their options
+static int MainResult, MainArgc;
+static char** MainArgv;
+
+static void* HostMain(void* p) {
+
+  u32 Local;
+  if((((uintptr_t)&Local)>>32) || (((uintptr_t)&MainResult)>>32)) { printf("an address does not fit in u32\n"); exit(1); }
+  MainResult = __real_main(MainArgc, MainArgv);
+  return p;
+}
+
+int __wrap_main(int argc, char** argv) { // linked with --wrap=main
+
+  MainArgc = argc;
+  MainArgv = argv;
+  pthread_join(HostThread(HostMain, 0), 0);
+  return MainResult;
+}
@@ -0,0 +1,14 @@
+#ifndef _HOST_TESTS_H_
+#define _HOST_TESTS_H_
+
+#include "sebEngine.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <pthread.h>
+
+// A test main() returns 0 when all its checks pass, the first failed check returns 1
+#define CHECK(c) do { if(!(c)) { printf("%s:%d: CHECK(%s) failed\n", __FILE__, __LINE__, #c); return 1; } } while(0)
+
+pthread_t HostThread(void* (*fn)(void*), void* arg); // pthread_create() on a stack below 4GB, for the threads passing addresses as u32
+
+#endif
@@ -0,0 +1,111 @@
+#include "HostTests.h"
+
+// The protothread conversion of I2C_MasterIO: the same sequence run blocking, then in background mode from a simulated timer countdown
+// Both runs must give the same pin activity and the same bytes read. The slave acknowledges everything and sends 0xA5 0x5A...
+static I2C_MasterIO_t M;
+static MCU_Clocks_t Clocks;
+static Timer_t Timer;
+static IO_Pin_t SDA = { 0, 1 }, SCL = { 1, 1 };
+
+static char Trace[2][4096]; // D/d: SDA high/low, C/c: SCL high/low, 0/1: SDA read
+static u32 TraceSize[2], Run;
+static u32 CountdownArmed, Countdowns;
+
+static void Log(char c) { if(TraceSize[Run]<sizeof(Trace[0])) Trace[Run][TraceSize[Run]++] = c; }
+
+void IO_PinSetHigh(IO_Pin_t* Pin) { Pin->Level = 1; Log(Pin->Id ? 'C' : 'D'); }
+void IO_PinSetLow(IO_Pin_t* Pin) { Pin->Level = 0; Log(Pin->Id ? 'c' : 'd'); }
+u32 ConfigurePinAsOpenDrainPU(IO_Pin_t* P) { (void)P; return 0; }
+
+static u8 SlaveData = 0xA5;
+s32 IO_PinGet(IO_Pin_t* Pin) { // open drain: the slave pulls SDA low while SCL is high, for its acknowledge and its 0 data bits
+
+  u32 Level = Pin->Level;
+  if(Pin->Id==0 && SCL.Level) {
+    if((M.SlaveAdr & 1) && (M.JobKind==2) && (M.Bit<8)) // receiving a byte (2: the move job)
+      Level = (SlaveData >> (7 - M.Bit)) & 1;
+    else
+      Level = 0; // acknowledge
+    if((M.SlaveAdr & 1) && (M.Bit==7)) SlaveData ^= 0xFF;
+  };
+  Log('0' + Level);
+  return Level;
+}
+
+void HookTimerCountdown(Timer_t* T, u32 n, u32 fn, u32 ct) { T->fnCountDown[n] = fn; T->ctCountDown[n] = ct; }
+void ArmTimerCountdown(Timer_t* T, u32 n, u32 ticks) { // hooked: the next Tick() calls the hook, else it elapses at once (polled)
+
+  (void)ticks;
+
+  Countdowns++;
+  if(T->fnCountDown[n]) CountdownArmed = 1;
+  else T->CountDownDone[n] = 1;
+}
+
+static void Tick(void) { // the timer interrupt
+
+  CountdownArmed = 0;
+  ((u32(*)(u32))Timer.fnCountDown[0])(Timer.ctCountDown[0]);
+}
+
+static StuffsArtery_t SA;
+static u32 SAR[8];
+static u8 TX[4] = { 0x12, 0x34, 0x56, 0x78 };
+static u8 RX[2][4]; // a read move of n bytes takes n + 1 of them, the last one not acknowledged (unchanged by the conversion)
+static OneJob_t StartWrite, Write, StartRead, Read;
+
+static void Queue(void) {
+
+  StartWrite = (OneJob_t) { sq_I2C_MIO_StartJob, { (u32)&M, 0xBA } };
+  Write = (OneJob_t) { sq_I2C_MIO_MoveJob, { (u32)&M, (u32)TX, sizeof(TX), 1 } }; // more coming: no stop
+  StartRead = (OneJob_t) { sq_I2C_MIO_StartJob, { (u32)&M, 0xBB } };
+  Read = (OneJob_t) { sq_I2C_MIO_MoveJob, { (u32)&M, (u32)RX[Run], sizeof(RX[0]) - 1, 0 } };
+  AddToSA(&SA, (u32)&StartWrite);
+  AddToSA(&SA, (u32)&Write);
+  AddToSA(&SA, (u32)&StartRead);
+  AddToSA(&SA, (u32)&Read);
+}
+
+int main(void) {
+
+  u32 Ticks = 0, Waits;
+
+  Clocks.OutCoreClk_Hz.Value = 96000000;
+  Timer.OverflowPeriod_us = 1;
+  M.Clocks = &Clocks;
+  M.Timer = &Timer;
+  M.Cn = 0;
+  NewI2C_MasterIO_SDA_SCL(&M, &SDA, &SCL);
+  SetI2C_MasterIO_Timings(&M, 100000, 400000);
+  ConfigureI2C_MasterIO(&M);
+  M.SA = NewSA(&SA, (u32)SAR, countof(SAR));
+
+  Run = 0; // blocking
+  Queue();
+  StartJobToDoInForeground((u32)&SA);
+  CHECK(SA.FlagEmptied && M.JobDone && (M.AckFail==0));
+  CHECK(CountdownArmed==0);
+  Waits = Countdowns; // polled
+  Countdowns = 0;
+
+  Run = 1; // background
+  SlaveData = 0xA5;
+  SetI2C_MasterIO_Background(&M, ENABLE);
+  Queue();
+  StartJobToDoInForeground((u32)&SA); // returns at the first wait
+  CHECK(CountdownArmed && (SA.bCount==3));
+  while(CountdownArmed) {
+    Tick();
+    Ticks++;
+  };
+  CHECK(SA.FlagEmptied && M.JobDone && (M.AckFail==0));
+  CHECK((Ticks==Waits)&&(Countdowns==Waits)); // the same waits, each one through the countdown hook
+
+  CHECK((RX[0][0]==0xA5) && (RX[0][1]==0x5A) && (RX[0][2]==0xA5) && (RX[0][3]==0x5A));
+  CHECK(memcmp(RX[0], RX[1], sizeof(RX[0]))==0);
+  CHECK((TraceSize[0]==TraceSize[1]) && (TraceSize[0]<sizeof(Trace[0])));
+  CHECK(memcmp(Trace[0], Trace[1], TraceSize[0])==0);
+
+  printf("I2C_MasterIO_Tests ok\n");
+  return 0;
+}
@@ -0,0 +1,100 @@
+#include "HostTests.h"
+
+// Job programs: the calls with their parameters and strides, the skips, the jumps, the nested loops and the suspend/resume on an armed callback
+// Each call logs its parameters (p[0] to p[1]), Test returns its p[0] as the condition, Armed returns as if its callback was armed
+static StuffsArtery_t SA;
+static u32 SAR[16];
+static JobProgram_t P;
+static JobLanes_t JL;
+static u32 Log[64][2], nLog;
+
+static u32 Rec(u32 u) { u32* p = (u32*)u; Log[nLog][0] = p[0]; Log[nLog++][1] = p[1]; return 0; }
+static u32 Test(u32 u) { return ((u32*)u)[0]; }
+static u32 Armed(u32 u) { Rec(u); return 1; }
+static OneJob_t After = { Rec, { 99, 0 } };
+
+static u32 Logged(u32 n, u32 a, u32 b) { return (Log[n][0]==a) && (Log[n][1]==b); }
+
+int main(void) {
+
+  // the programs are built at run time here: a function address is not a constant u32 on a 64 bit host (it is on the target)
+  // strides: p[1] walks by 8 per index of the innermost loop, the nested loops restart it on each outer turn
+  const u32 Strides[] = {
+    JP_LOOP(2),
+      JP_CALL(Rec, 2), 1, 0,
+      JP_LOOP(3),
+        JP_CALL_STRIDE(Rec, 2, 1, 8), 2, 100,
+      JP_ENDLOOP,
+    JP_ENDLOOP,
+    JP_END
+  };
+
+  // skips over calls of any size, both conditions, and a jump over the rest
+  const u32 Skips[] = {
+    JP_TEST(Test, 1), 1, // 0: true
+    JP_SKIP_IF(2), // 3: skips the next 2 ops
+      JP_CALL(Rec, 2), 10, 0,
+      JP_CALL(Rec, 0),
+    JP_SKIP_IFNOT(1), // 10: not skipped
+      JP_CALL(Rec, 2), 11, 0,
+    JP_TEST(Test, 1), 0, // 15: false
+    JP_SKIP_IFNOT(1), // 18: skips the next op
+      JP_CALL(Rec, 2), 12, 0,
+    JP_SKIP_IF(1), // 23: not skipped
+      JP_CALL(Rec, 2), 13, 0,
+    JP_JUMP(33),
+      JP_CALL(Rec, 2), 14, 0,
+    JP_CALL(Rec, 2), 15, 0, // 33
+    JP_END
+  };
+
+  // an armed call inside a loop suspends the program, which resumes on the callback before the job queued behind it
+  const u32 Suspend[] = {
+    JP_LOOP(2),
+      JP_CALL_STRIDE(Armed, 2, 1, 1), 20, 0,
+      JP_CALL(Rec, 2), 21, 0,
+    JP_ENDLOOP,
+    JP_END
+  };
+
+  NewSA(&SA, (u32)SAR, countof(SAR));
+
+  AddProgramToSA(&SA, &P, Strides);
+  CHECK(JobToDo((u32)&SA)==0);
+  CHECK((nLog==8) && Logged(0, 1, 0) && Logged(1, 2, 100) && Logged(2, 2, 108) && Logged(3, 2, 116));
+  CHECK(Logged(4, 1, 0) && Logged(5, 2, 100) && Logged(6, 2, 108) && Logged(7, 2, 116));
+  CHECK((P.PC==0) && (P.Depth==0) && (SA.bCount==0));
+
+  // the same program queued again runs the same
+  nLog = 0;
+  AddProgramToSA(&SA, &P, Strides);
+  CHECK((JobToDo((u32)&SA)==0) && (nLog==8) && Logged(7, 2, 116));
+
+  nLog = 0;
+  AddProgramToSA(&SA, &P, Skips);
+  CHECK(JobToDo((u32)&SA)==0);
+  CHECK((nLog==3) && Logged(0, 11, 0) && Logged(1, 13, 0) && Logged(2, 15, 0));
+
+  nLog = 0;
+  AddProgramToSA(&SA, &P, Suspend);
+  AddJobToSA(&SA, &After);
+  CHECK(JobToDo((u32)&SA)==1);
+  CHECK((nLog==1) && Logged(0, 20, 0) && (SA.bCount==2) && SA.JobArmed && (SA.FlagEmptied==0));
+  CHECK(ResumeJobToDo((u32)&SA)==1); // the callback: Rec, then the second turn arms again
+  CHECK((nLog==3) && Logged(1, 21, 0) && Logged(2, 20, 1) && (SA.bCount==2));
+  CHECK(ResumeJobToDo((u32)&SA)==0);
+  CHECK((nLog==5) && Logged(3, 21, 0) && Logged(4, 99, 0) && (SA.bCount==0) && (SA.JobArmed==0));
+  CHECK(P.PC==0);
+
+  // on a lane: suspended, the program keeps its lane non empty
+  nLog = 0;
+  NewJobLanes(&JL);
+  AddProgramToSA(&SA, &P, Suspend);
+  SetJobLane(&JL, 4, &SA); // the lane set after: its bit follows the program queued
+  CHECK((LanesJobToDo((u32)&JL)==1) && (JL.NonEmpty==(0x80000000 >> 4)));
+  CHECK((LanesJobToDo((u32)&JL)==1) && (LanesJobToDo((u32)&JL)==0));
+  CHECK((nLog==4) && Logged(3, 21, 0) && (JL.NonEmpty==0) && JL.FlagEmptied);
+
+  printf("JobProgram_Tests ok\n");
+  return 0;
+}
@@ -0,0 +1,73 @@
+#include "HostTests.h"
+
+// Priority lanes: the most urgent non empty lane goes first, chosen again before each job, the NonEmpty bitmap in sync with the lanes
+// Each job logs its number, Post jobs add another one to a lane while they run, Armed ones return as if their callback was armed
+static JobLanes_t JL;
+static StuffsArtery_t LaneSA[32];
+static u32 LaneR[32][16];
+static u32 Log[64], nLog;
+
+static u32 Rec(u32 u) { Log[nLog++] = ((u32*)u)[0]; return 0; } // p[0] number
+static u32 Post(u32 u) { // p[0] number, p[1] lane, p[2] the job to add
+  u32* p = (u32*)u;
+  Log[nLog++] = p[0];
+  AddJobToLane(&JL, p[1], p[2]);
+  return 0;
+}
+static u32 Armed(u32 u) { Log[nLog++] = ((u32*)u)[0]; return 1; }
+
+static OneJob_t Jobs[16];
+
+static void Add(u32 Lane, u32 n) { AddJobToLane(&JL, Lane, (u32)&Jobs[n]); }
+
+int main(void) {
+
+  u32 n;
+
+  NewJobLanes(&JL);
+  for(n=0;n<32;n++) NewSA(&LaneSA[n], (u32)LaneR[n], countof(LaneR[n]));
+  for(n=0;n<16;n++) Jobs[n] = (OneJob_t) { Rec, { n } };
+  CHECK((JL.NonEmpty==0) && JL.FlagEmptied);
+
+  // a lane set while it already holds jobs is seen at once
+  AddToSA(&LaneSA[3], (u32)&Jobs[9]);
+  SetJobLane(&JL, 3, &LaneSA[3]);
+  CHECK(JL.NonEmpty==(0x80000000 >> 3));
+  SetJobLane(&JL, 0, &LaneSA[0]);
+  SetJobLane(&JL, 1, &LaneSA[1]);
+  SetJobLane(&JL, 31, &LaneSA[31]);
+
+  // queued in any order, run lane by lane, FIFO within a lane. Lane 31 is bit 0 of the bitmap
+  Add(31, 0); Add(1, 1); Add(0, 2); Add(31, 3); Add(1, 4); Add(0, 5);
+  CHECK((JL.NonEmpty==0xD0000001) && (JL.FlagEmptied==0));
+  CHECK(LanesJobToDo((u32)&JL)==0);
+  CHECK((nLog==7) && (Log[0]==2) && (Log[1]==5) && (Log[2]==1) && (Log[3]==4) && (Log[4]==9) && (Log[5]==0) && (Log[6]==3));
+  CHECK((JL.NonEmpty==0) && JL.FlagEmptied);
+
+  // a job of lane 31 posting to lane 0: the urgent job overtakes the rest of lane 31 between two jobs
+  nLog = 0;
+  Jobs[10] = (OneJob_t) { Post, { 10, 0, (u32)&Jobs[11] } };
+  Jobs[11] = (OneJob_t) { Rec, { 11 } };
+  Add(31, 10); Add(31, 12);
+  CHECK(LanesJobToDo((u32)&JL)==0);
+  CHECK((nLog==3) && (Log[0]==10) && (Log[1]==11) && (Log[2]==12));
+
+  // an armed callback stops the dispatch, the interrupt resumes it with LanesJobToDo(): the lanes are chosen again
+  nLog = 0;
+  Jobs[13] = (OneJob_t) { Armed, { 13 } };
+  Add(1, 13); Add(1, 14);
+  CHECK(LanesJobToDo((u32)&JL)==1);
+  CHECK((nLog==1) && (Log[0]==13) && (JL.NonEmpty==(0x80000000 >> 1)) && (JL.FlagEmptied==0));
+  Add(0, 15); // posted during the wait
+  CHECK(LanesJobToDo((u32)&JL)==0); // the callback
+  CHECK((nLog==3) && (Log[1]==15) && (Log[2]==14) && (JL.NonEmpty==0) && JL.FlagEmptied);
+
+  // the last job armed: the bitmap is already empty when it returns
+  nLog = 0;
+  Add(31, 13);
+  CHECK((LanesJobToDo((u32)&JL)==1) && (JL.NonEmpty==0) && (JL.FlagEmptied==0));
+  CHECK((LanesJobToDo((u32)&JL)==0) && JL.FlagEmptied);
+
+  printf("Lanes_Tests ok\n");
+  return 0;
+}
@@ -0,0 +1,67 @@
+#include "HostTests.h"
+#include <sched.h>
+
+// NewSA_MPSC(): producer threads standing for the interrupts post concurrently, one consumer drains (the portable atomics path)
+// Each item is [31:24] producer, [23:0] sequence: nothing lost, nothing duplicated, and the order of each producer kept
+#define PRODUCERS 3
+#define ITEMS 500000
+
+static StuffsArtery_t SA;
+static u32 SAR[64];
+
+static void* Producer(void* p) {
+
+  u32 Id = (u32)(uintptr_t)p, n;
+  for(n=1;n<=ITEMS;n++)
+    while(GlueSA_MPSC(&SA, (Id<<24) | n)==0) // full: retry, as an interrupt would count it and post later
+      sched_yield();
+  return 0;
+}
+
+int main(void) {
+
+  pthread_t Threads[PRODUCERS];
+  u32 Last[PRODUCERS+1] = { 0 };
+  u32 n, Item, Id, Got = 0;
+
+  // single context: full, empty and the wrap of the free running indexes
+  NewSA_MPSC(&SA, (u32)SAR, countof(SAR));
+  for(n=1;n<=countof(SAR);n++)
+    CHECK(GlueSA_MPSC(&SA, n));
+  CHECK(GlueSA_MPSC(&SA, 999)==0);
+  CHECK(GetSA_MPSC_Count(&SA)==countof(SAR));
+  for(n=1;n<=0x10000 + 10;n++) {
+    CHECK(ClipSA_MPSC(&SA)==((n - 1) % countof(SAR)) + 1);
+    CHECK(GlueSA_MPSC(&SA, ((n - 1) % countof(SAR)) + 1)); // the 64 + n th item
+  };
+
+  // concurrent producers
+  NewSA_MPSC(&SA, (u32)SAR, countof(SAR));
+  for(n=0;n<PRODUCERS;n++)
+    Threads[n] = HostThread(Producer, (void*)(uintptr_t)(n + 1));
+  while(Got<PRODUCERS * ITEMS) {
+    Item = ClipSA_MPSC(&SA);
+    if(Item==0) { // empty, or the next slot reserved and not written yet
+      sched_yield();
+      continue;
+    };
+    Id = Item>>24;
+    CHECK((Id>=1)&&(Id<=PRODUCERS));
+    CHECK((Item & 0xFFFFFF)==Last[Id] + 1);
+    Last[Id]++;
+    Got++;
+  };
+  for(n=0;n<PRODUCERS;n++)
+    pthread_join(Threads[n], 0);
+  CHECK(GetSA_MPSC_Count(&SA)==0);
+  CHECK(ClipSA_MPSC(&SA)==0);
+
+  // the table reused as a classic artery (QB_SA, by Deferred_Bench then Queue_Bench): NewSA() leaves the MPSC mode and its indexes
+  GlueSA_MPSC(&SA, 1);
+  NewSA(&SA, (u32)SAR, countof(SAR));
+  CHECK((SA.MPSC==0) && (SA.iUp==0) && (SA.iDown==0) && (SA.Mask==0));
+  for(n=1;n<=100;n++) { SA.In = n; GlueSA_Up(&SA); CHECK(ClipSA_Down(&SA)==0 && (SA.Out==n)); };
+
+  printf("MPSC_Tests ok\n");
+  return 0;
+}
@@ -0,0 +1,114 @@
+#include "HostBench.h"
+
+// The interrupt side on the host: the vectors are called as the core would, after setting IPSR (no exception entry, no tail chaining)
+// Deferred_Bench (QueueBenchDemos.c): the 64 byte hex dump done in the TIM7 hook, or moved to PendSV by DeferJob()
+// ISR is the time in the vector, what a same or lower priority interrupt waits. Done is the time to the work done, PendSV_Handler() called at once
+// NVIC_Bench (QueueBenchDemos.c): an empty hook through TIM2 full dispatch, the same with the pre/post hooks, TIM3 NVIC_BARE and TIM4 NVIC_DIRECT
+#define NB_ROUNDS 4096
+#define NB_BATCH 64 // vectors per round, all deferred jobs fit in the artery
+
+void TIM2_IRQHandler(void); // SebTIM2, SebTIM3 NVIC_BARE, SebTIM4 NVIC_DIRECT in the host sebEngine.h
+void TIM3_IRQHandler(void);
+void TIM4_IRQHandler(void);
+void TIM7_IRQHandler(void);
+void PendSV_Handler(void);
+
+static u8 Text[128];
+static StuffsArtery_t DeferSA;
+static u32 DeferSAR[2 * NB_BATCH]; // a power of 2 (NewSA_MPSC())
+
+static u32 DeferredWork(u32 u) { // job compatible, the bottom half
+
+  u32 n;
+  for(n=0;n<64;n++) {
+    Text[2*n] = "0123456789ABCDEF"[((n * 37) >> 4) & 0xF];
+    Text[2*n+1] = "0123456789ABCDEF"[(n * 37) & 0xF];
+  };
+  __asm__ volatile("" : : "r"(Text) : "memory"); // the dump is kept
+  return u & 0;
+}
+
+static OneJob_t DeferredJob = { DeferredWork, { 0 } };
+
+static u32 DeferredTop(u32 Deferred) { // the TIM7 hook
+
+  if(Deferred) DeferJob((u32)&DeferredJob);
+  else DeferredWork((u32)DeferredJob.ctJobs);
+  return 0;
+}
+
+#define NB_INLINE 0
+#define NB_DEFERRED_ISR 1
+#define NB_DEFERRED_DONE 2
+
+static uint64_t Deferred_ns(u32 Mode) { // one round
+
+  uint64_t Start_ns, ns;
+  u32 n;
+
+  HostIPSR = 16 + TIM7_IRQn;
+  Start_ns = BenchNow_ns();
+  for(n=0;n<NB_BATCH;n++) {
+    TIM7_IRQHandler();
+    if(Mode==NB_DEFERRED_DONE) PendSV_Handler();
+  };
+  ns = BenchNow_ns() - Start_ns;
+  if(Mode==NB_DEFERRED_ISR) PendSV_Handler(); // not timed, the artery is drained for the next round
+  return ns;
+}
+
+static double MeasureDeferred(void* p) { // ns per interrupt
+
+  uint64_t ns = 0;
+  u32 Mode = *(u32*)p, r;
+  HookIRQn(TIM7_IRQn, (u32)DeferredTop, Mode!=NB_INLINE);
+  for(r=0;r<NB_ROUNDS;r++) ns += Deferred_ns(Mode);
+  return (double)ns / (NB_ROUNDS * NB_BATCH);
+}
+
+static u32 EmptyHook(u32 u) { return u; }
+
+static uint64_t Vector_ns(void (*Vector)(void)) { // one round
+
+  uint64_t Start_ns;
+  u32 n;
+
+  Start_ns = BenchNow_ns();
+  for(n=0;n<NB_BATCH;n++) Vector();
+  return BenchNow_ns() - Start_ns;
+}
+
+static double MeasureVector(void* p) { // ns per interrupt
+
+  uint64_t ns = 0;
+  u32 IRQn = *(u32*)p, r;
+  void (*Vector)(void) = (IRQn==TIM3_IRQn) ? TIM3_IRQHandler : (IRQn==TIM4_IRQn) ? TIM4_IRQHandler : TIM2_IRQHandler;
+  HostIPSR = 16 + IRQn; // only NVIC_Dispatch() reads it
+  for(r=0;r<NB_ROUNDS;r++) ns += Vector_ns(Vector);
+  return (double)ns / (NB_ROUNDS * NB_BATCH);
+}
+
+static void Figure(const char* Name, double (*Measure)(void*), u32 Mode) { BenchMeasure(Name, Measure, &Mode); }
+
+int main(int argc, char** argv) {
+
+  BenchBegin(argc, argv);
+  NewNVIC_Deferred((u32)NewSA_MPSC(&DeferSA, (u32)DeferSAR, countof(DeferSAR)));
+
+  Figure("Deferred/Inline", MeasureDeferred, NB_INLINE);
+  Figure("Deferred/ISR", MeasureDeferred, NB_DEFERRED_ISR);
+  Figure("Deferred/Done", MeasureDeferred, NB_DEFERRED_DONE);
+
+  HookIRQn(TIM2_IRQn, (u32)EmptyHook, 0);
+  HookIRQn(TIM3_IRQn, (u32)EmptyHook, 0);
+  HookIRQn(TIM4_IRQn, (u32)EmptyHook, 0);
+  Figure("Vector/Dispatch", MeasureVector, TIM2_IRQn);
+  fnPreNVICs[TIM2_IRQn] = fnPostNVICs[TIM2_IRQn] = (u32)u32_fn_u32;
+  Figure("Vector/PrePost", MeasureVector, TIM2_IRQn);
+  fnPreNVICs[TIM2_IRQn] = fnPostNVICs[TIM2_IRQn] = 0;
+  Figure("Vector/Bare", MeasureVector, TIM3_IRQn);
+  Figure("Vector/Direct", MeasureVector, TIM4_IRQn);
+
+  if(NVIC_DeferredLost) { printf("NVICBench: %u deferred jobs lost\n", (unsigned)NVIC_DeferredLost); return 1; };
+  return BenchEnd();
+}
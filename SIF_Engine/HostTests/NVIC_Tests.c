@@ -0,0 +1,253 @@
+#include "HostTests.h"
+
+// The hook table dispatch: an interrupt is taken by setting IPSR as the core does, then calling its vector
+static u32 Log[16], nLog;
+static u32 Rec(u32 ct) { if(nLog<countof(Log)) Log[nLog++] = ct; return ct; }
+
+static u32 RecClear(u32 ct) { EXTI->PR = ct; return Rec(ct); } // serves all the lines in ct (EXTI->PR is write 1 to clear on the target, simply written here)
+
+static StuffsArtery_t DeferSA;
+static u32 DeferSAR[4];
+static u32 Jobs;
+static u32 CountJob(u32 u) { (void)u; Jobs++; return 0; }
+static OneJob_t Job = { CountJob, { 0 } };
+
+static StuffsArtery_t StormSA;
+static u32 StormSAR[4];
+
+static void StormMainLoop(void) { // one turn of the main loop: the queued release job runs once (MPSCJobToDo() would run it again at once)
+  OneJob_t* J = (OneJob_t*)ClipSA_MPSC(&StormSA);
+  if(J) J->fnJob((u32)J->ctJobs);
+}
+
+static void Enter(u32 IRQn) { HostIPSR = 16 + IRQn; }
+
+static u32 Spend(u32 cy) { DWT->CYCCNT += cy; return cy; } // a hook running cy cycles
+
+static void Timed(u32 IRQn, u32 Period_cy, u32 Duration_cy) { // the next entry Period_cy after the previous one, run Duration_cy
+  DWT->CYCCNT = NVIC_Stats[IRQn].Entry_cy + Period_cy;
+  HookIRQn(IRQn, (u32)Spend, Duration_cy);
+  Enter(IRQn); NVIC_Dispatch();
+}
+static const u32 Period[] = { 0, 100, 90, 110, 100, 100, 40000, 40000 };
+static const u32 Duration[] = { 0, 1, 2, 3, 4, (1<<15) - 1, 1<<15, 1<<20 };
+static const u16 Bins[NVIC_STATS_BINS] = { 2, 2, 1, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 1, 2 }; // what they give
+
+void PendSV_Handler(void); // built by sebNVIC.c with SebPendSV and the SebXXX of sebEngine.h
+void EXTI0_IRQHandler(void);
+void EXTI9_5_IRQHandler(void);
+void EXTI15_10_IRQHandler(void);
+void ADC_IRQHandler(void);
+void TIM1_BRK_TIM9_IRQHandler(void);
+void TIM2_IRQHandler(void);
+void TIM3_IRQHandler(void);
+void TIM4_IRQHandler(void);
+void TIM6_DAC_IRQHandler(void);
+void TIM7_IRQHandler(void);
+
+int main(void) {
+
+  u32 Queued, n;
+  NVIC_StatsTypeDef* S = &NVIC_Stats[TIM6_DAC_IRQn];
+
+  // a plain IRQ, and the former globals aliased into the table
+  CHECK(HookIRQn(TIM2_IRQn, (u32)Rec, 0x22)==0);
+  CHECK((fnTIM2==(u32)Rec) && (ctTIM2==0x22));
+  Enter(TIM2_IRQn); NVIC_Dispatch();
+  CHECK((nLog==1) && (Log[0]==0x22));
+
+  // the pre and post hooks get the IRQn, around the hook
+  nLog = 0;
+  fnPreNVICs[TIM2_IRQn] = (u32)Rec;
+  fnPostNVICs[TIM2_IRQn] = (u32)Rec;
+  Enter(TIM2_IRQn); NVIC_Dispatch();
+  CHECK((nLog==3) && (Log[0]==TIM2_IRQn) && (Log[1]==0x22) && (Log[2]==TIM2_IRQn));
+  fnPreNVICs[TIM2_IRQn] = fnPostNVICs[TIM2_IRQn] = 0;
+
+  // an EXTI line is a plain index, EXTI0 included
+  nLog = 0;
+  HookIRQn(NVIC_HOOK_EXTI(0), (u32)Rec, 100);
+  EXTI->IMR = EXTI->PR = 1<<0;
+  Enter(EXTI0_IRQn); EXTI0_IRQHandler();
+  CHECK((nLog==1) && (Log[0]==100));
+  CHECK(NVIC->ICPR[0]==(1<<EXTI0_IRQn));
+
+  // the TIM1_BRK_TIM9 vector: TIM9 on its enabled flag, TIM1 break otherwise
+  nLog = 0;
+  fnTIM9 = (u32)Rec; ctTIM9 = 9;
+  fnTIM1_BRK = (u32)Rec; ctTIM1_BRK = 1;
+  TIM9->SR = TIM9->DIER = TIM_FLAG_CC2;
+  Enter(TIM1_BRK_TIM9_IRQn); TIM1_BRK_TIM9_IRQHandler();
+  TIM9->DIER = 0;
+  TIM1->SR = TIM1->DIER = TIM_FLAG_Break;
+  TIM1_BRK_TIM9_IRQHandler();
+  CHECK((nLog==2) && (Log[0]==9) && (Log[1]==1));
+
+  // ADC: each hooked ADC is called
+  nLog = 0;
+  fnADC2 = (u32)Rec; ctADC2 = 2;
+  Enter(ADC_IRQn); ADC_IRQHandler();
+  CHECK((nLog==1) && (Log[0]==2));
+
+  // the DMA streams are not contiguous
+  CHECK((NVIC_HOOK_DMA1(7)==DMA1_Stream7_IRQn) && (NVIC_HOOK_DMA2(4)==DMA2_Stream4_IRQn) && (NVIC_HOOK_DMA2(5)==DMA2_Stream5_IRQn));
+
+  // unhooked: the source is cleared when known
+  TIM6->SR = 1;
+  Enter(TIM6_DAC_IRQn); TIM6_DAC_IRQHandler();
+  CHECK(TIM6->SR==0);
+
+  // the shared EXTI channels: only the pending and enabled lines, lowest first, an unhooked one is cleared
+  nLog = 0;
+  HookIRQn(NVIC_HOOK_EXTI(5), (u32)Rec, 5);
+  HookIRQn(NVIC_HOOK_EXTI(7), (u32)Rec, 7);
+  HookIRQn(NVIC_HOOK_EXTI(8), (u32)Rec, 8);
+  EXTI->IMR = (1<<5) | (1<<7) | (1<<9);
+  EXTI->PR = (1<<5) | (1<<7) | (1<<8) | (1<<9); // 8 pending but masked
+  NVIC->ICPR[0] = 0;
+  Enter(EXTI9_5_IRQn); EXTI9_5_IRQHandler();
+  CHECK((nLog==2) && (Log[0]==5) && (Log[1]==7));
+  CHECK(EXTI->PR==(1<<9)); // the last write: unhooked line 9 cleared
+  CHECK(NVIC->ICPR[0]==(1<<EXTI9_5_IRQn));
+
+  // a hook serving several lines clears them: the others are skipped
+  nLog = 0;
+  HookIRQn(NVIC_HOOK_EXTI(10), (u32)RecClear, 0);
+  HookIRQn(NVIC_HOOK_EXTI(12), (u32)Rec, 12);
+  EXTI->IMR = EXTI->PR = (1<<10) | (1<<12);
+  Enter(EXTI15_10_IRQn); EXTI15_10_IRQHandler();
+  CHECK((nLog==1) && (Log[0]==0));
+  CHECK(NVIC->ICPR[1]==(1<<(EXTI15_10_IRQn-32)));
+
+  // the timer pairs: both sources in one entry, a flag outside the table goes to the big timer
+  nLog = 0;
+  TIM9->SR = TIM9->DIER = TIM_FLAG_Update;
+  TIM1->SR = TIM1->DIER = TIM_FLAG_Break;
+  Enter(TIM1_BRK_TIM9_IRQn); TIM1_BRK_TIM9_IRQHandler();
+  CHECK((nLog==2) && (Log[0]==9) && (Log[1]==1));
+  nLog = 0;
+  TIM9->SR = TIM9->DIER = 0;
+  TIM1->SR = TIM1->DIER = TIM_FLAG_CC1;
+  TIM1_BRK_TIM9_IRQHandler();
+  CHECK((nLog==1) && (Log[0]==1));
+
+  // hooking a shared channel replaces its demux
+  nLog = 0;
+  HookIRQn(EXTI9_5_IRQn, (u32)Rec, 0x95);
+  EXTI->IMR = EXTI->PR = 1<<7;
+  Enter(EXTI9_5_IRQn); EXTI9_5_IRQHandler();
+  CHECK((nLog==1) && (Log[0]==0x95));
+
+  // the lean vectors: no pre/post hooks, NVIC_DIRECT calls the hook without test
+  nLog = 0;
+  HookIRQn(TIM3_IRQn, (u32)Rec, 3);
+  HookIRQn(TIM4_IRQn, (u32)Rec, 4);
+  fnPreNVICs[TIM2_IRQn] = fnPreNVICs[TIM3_IRQn] = fnPreNVICs[TIM4_IRQn] = (u32)Rec;
+  Enter(TIM2_IRQn); TIM2_IRQHandler();
+  Enter(TIM3_IRQn); TIM3_IRQHandler();
+  Enter(TIM4_IRQn); TIM4_IRQHandler();
+  CHECK((nLog==4) && (Log[0]==TIM2_IRQn) && (Log[1]==0x22) && (Log[2]==3) && (Log[3]==4));
+  fnPreNVICs[TIM2_IRQn] = fnPreNVICs[TIM3_IRQn] = fnPreNVICs[TIM4_IRQn] = 0;
+  TIM7->SR = 1;
+  Enter(TIM7_IRQn); TIM7_IRQHandler();
+  CHECK(TIM7->SR==0);
+
+  // deferred work: the hook only posts, PendSV at the lowest priority runs the job
+  NewNVIC_Deferred((u32)NewSA_MPSC(&DeferSA, (u32)DeferSAR, countof(DeferSAR)));
+  CHECK(SCB->SHP[((u32)PendSV_IRQn & 0xF) - 4]==(((1<<__NVIC_PRIO_BITS) - 1) << (8 - __NVIC_PRIO_BITS)));
+  HookIRQn(TIM2_IRQn, (u32)DeferJob, (u32)&Job);
+  SCB->ICSR = 0;
+  Enter(TIM2_IRQn); NVIC_Dispatch();
+  CHECK((Jobs==0) && (SCB->ICSR==SCB_ICSR_PENDSVSET_Msk));
+  Enter(PendSV_IRQn); PendSV_Handler();
+  CHECK((Jobs==1) && (GetSA_MPSC_Count(&DeferSA)==0));
+
+  // a full artery loses the job and counts it, the queued ones still run
+  Queued = 0;
+  while(DeferJob((u32)&Job)) Queued++;
+  CHECK((Queued==countof(DeferSAR)) && (NVIC_DeferredLost==1));
+  Jobs = 0;
+  PendSV_Handler();
+  CHECK((Jobs==Queued) && (GetSA_MPSC_Count(&DeferSA)==0));
+
+  // the storm guard: the entry over the limit is still served, the line is then masked and the release job posted once
+  NewNVIC_StormGuard((u32)NewSA_MPSC(&StormSA, (u32)StormSAR, countof(StormSAR)));
+  HookIRQn(TIM2_IRQn, (u32)Rec, 0x22);
+  HookIRQn(TIM7_IRQn, (u32)Rec, 7);
+  DWT->CYCCNT = 0xFFFFFF00; // the windows cross the 32 bit wrap
+  NVIC_StormLimit(TIM2_IRQn, 3, 1000);
+  nLog = 0;
+  for(n=0;n<4;n++) {
+    DWT->CYCCNT += 10;
+    Enter(TIM2_IRQn); NVIC_Dispatch();
+  };
+  CHECK((nLog==4) && NVIC_Storms[TIM2_IRQn].Masked && (NVIC->ICER[TIM2_IRQn >> 5]==(1<<(TIM2_IRQn & 0x1F))));
+  CHECK((NVIC_Storms[TIM2_IRQn].Storms==1) && (NVIC_StormCount==1) && (GetSA_MPSC_Count(&StormSA)==1));
+  NVIC_StormLimit(TIM7_IRQn, 1, 5000); // at 0xFFFFFF28
+  Enter(TIM7_IRQn); TIM7_IRQHandler();
+  Enter(TIM7_IRQn); TIM7_IRQHandler();
+  CHECK(NVIC_Storms[TIM7_IRQn].Masked && (NVIC_Storms[TIM7_IRQn].Storms==1) && (NVIC_StormCount==2));
+  CHECK(GetSA_MPSC_Count(&StormSA)==1); // the job is already queued
+
+  // inside their window, both stay masked and the job is posted again
+  NVIC->ISER[0] = NVIC->ISER[1] = 0;
+  DWT->CYCCNT = 0xFFFFFF00 + 999;
+  StormMainLoop();
+  CHECK(NVIC_Storms[TIM2_IRQn].Masked && NVIC_Storms[TIM7_IRQn].Masked && (NVIC->ISER[0]==0) && (NVIC->ISER[1]==0));
+  CHECK(GetSA_MPSC_Count(&StormSA)==1);
+
+  // the TIM2 window is over: unmasked with a fresh window, TIM7 still waits
+  DWT->CYCCNT = 0xFFFFFF00 + 1000;
+  StormMainLoop();
+  CHECK((NVIC_Storms[TIM2_IRQn].Masked==0) && (NVIC->ISER[TIM2_IRQn >> 5]==(1<<(TIM2_IRQn & 0x1F))));
+  CHECK((NVIC_Storms[TIM2_IRQn].Entries==0) && (NVIC_Storms[TIM2_IRQn].WindowStart_cy==0xFFFFFF00 + 1000));
+  CHECK(NVIC_Storms[TIM7_IRQn].Masked && (NVIC->ISER[1]==0) && (GetSA_MPSC_Count(&StormSA)==1));
+
+  DWT->CYCCNT = 0xFFFFFF28 + 5000;
+  StormMainLoop();
+  CHECK((NVIC_Storms[TIM7_IRQn].Masked==0) && (NVIC->ISER[TIM7_IRQn >> 5]==(1<<(TIM7_IRQn & 0x1F))));
+  CHECK(GetSA_MPSC_Count(&StormSA)==0); // nothing left to release
+
+  // a new storm posts the job again, the telemetry goes on
+  for(n=0;n<4;n++) {
+    Enter(TIM2_IRQn); NVIC_Dispatch();
+  };
+  CHECK((NVIC_Storms[TIM2_IRQn].Storms==2) && (NVIC_StormCount==3) && (GetSA_MPSC_Count(&StormSA)==1));
+  NVIC_StormLimit(TIM2_IRQn, 0, 0);
+  NVIC_StormLimit(TIM7_IRQn, 0, 0);
+
+  // the statistics: durations, periods across the 32 bit wrap, the log2 histogram with duration 0 in bin 0 and everything from 2^15 in the last bin
+  NVIC_StatsEnable(TIM6_DAC_IRQn, ENABLE);
+  CHECK((fnPreNVICs[TIM6_DAC_IRQn]==(u32)PreNVICs) && (fnPostNVICs[TIM6_DAC_IRQn]==(u32)PostNVICs));
+  CHECK(NVIC_StatsMask[TIM6_DAC_IRQn >> 5] & (1<<(TIM6_DAC_IRQn & 0x1F)));
+  S->Entry_cy = 0xFFFFFF00; // the first entry is there
+  for(n=0;n<countof(Duration);n++) Timed(TIM6_DAC_IRQn, Period[n], Duration[n]);
+  CHECK((S->Count==8) && (S->Min_cy==0) && (S->Max_cy==1<<20) && (S->Sum_cy==0 + 1 + 2 + 3 + 4 + 32767 + 32768 + (1<<20)));
+  CHECK((S->MinPeriod_cy==90) && (S->MaxPeriod_cy==40000) && (S->MaxPeriod_cy - S->MinPeriod_cy==39910)); // the first entry has no period
+  CHECK(memcmp(S->Bins, Bins, sizeof(Bins))==0);
+
+  // over budget: the hook gets its context, then a bin saturates
+  S->TooLong_cy = 1000;
+  S->fnTooLong = (u32)Rec;
+  S->ctTooLong = 0x600;
+  nLog = 0;
+  Timed(TIM6_DAC_IRQn, 50000, 1000); // not over
+  Timed(TIM6_DAC_IRQn, 50000, 1001);
+  CHECK((nLog==1) && (Log[0]==0x600) && (S->Bins[9]==2));
+  S->TooLong_cy = 0;
+  for(n=0;n<0x10000;n++) Timed(TIM6_DAC_IRQn, 10, 0);
+  CHECK((S->Bins[0]==0xFFFF) && (S->Count==8 + 2 + 0x10000) && (S->MinPeriod_cy==10));
+
+  // disabled, the figures stay readable and the hooks are gone. Enabled again, they start over
+  NVIC_StatsEnable(TIM6_DAC_IRQn, DISABLE);
+  CHECK((fnPreNVICs[TIM6_DAC_IRQn]==0) && (fnPostNVICs[TIM6_DAC_IRQn]==0) && (S->Max_cy==1<<20));
+  CHECK((NVIC_StatsMask[TIM6_DAC_IRQn >> 5] & (1<<(TIM6_DAC_IRQn & 0x1F)))==0);
+  Timed(TIM6_DAC_IRQn, 10, 5);
+  CHECK(S->Count==8 + 2 + 0x10000);
+  NVIC_StatsEnable(TIM6_DAC_IRQn, ENABLE);
+  CHECK((S->Count==0) && (S->Sum_cy==0) && (S->Min_cy==0xFFFFFFFF) && (S->MinPeriod_cy==0xFFFFFFFF) && (S->Bins[0]==0));
+  NVIC_StatsEnable(TIM6_DAC_IRQn, DISABLE);
+
+  printf("NVIC_Tests ok\n");
+  return 0;
+}
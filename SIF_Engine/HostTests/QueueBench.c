@@ -0,0 +1,171 @@
+#include "HostBench.h"
+
+// Queue_Bench on the host: the vein, artery and bit strand primitives for FIFO, LIFO and deque workloads at 16, 64 and 256 items
+// Same pattern as on the target (QueueBenchDemos.c, which BV_Pow2_Bench and SA_Pow2_Bench run too): one item kept inside so the rounds walk
+// around the buffer, then n in and n out, n = size/2. The rollover versus power of two mask ratios are printed after them
+#define QB_OPS (1<<18) // per run, whatever the size
+
+static ByteVein_t BV;
+static u8 BVR[256];
+static StuffsArtery_t SA;
+static u32 SAR[256];
+static BitVein_t BiV;
+static u32 BiVR[256/4]; // byte items: 8 bits per glue/clip
+
+static void NewBV_Any(u32 Size) { NewBV(&BV, (u32)BVR, Size); BV.In = 0x5A; }
+static void NewBV_Pow2Any(u32 Size) { NewBV_Pow2(&BV, (u32)BVR, Size); BV.In = 0x5A; }
+static void NewSA_Any(u32 Size) { NewSA(&SA, (u32)SAR, Size); SA.In = 0x5A; }
+static void NewSA_Pow2Any(u32 Size) { NewSA_Pow2(&SA, (u32)SAR, Size); SA.In = 0x5A; }
+static void NewBitV_Any(u32 Size) { NewBitV(&BiV, (u32)BiVR, Size); }
+
+static void BV_GlueUp(void) { GlueBV_Up(&BV); }
+static void BV_GlueDown(void) { GlueBV_Down(&BV); }
+static void BV_ClipUp(void) { ClipBV_Up(&BV); }
+static void BV_ClipDown(void) { ClipBV_Down(&BV); }
+static void BV_GlueUpPow2(void) { GlueBV_UpPow2(&BV); }
+static void BV_GlueDownPow2(void) { GlueBV_DownPow2(&BV); }
+static void BV_ClipUpPow2(void) { ClipBV_UpPow2(&BV); }
+static void BV_ClipDownPow2(void) { ClipBV_DownPow2(&BV); }
+static void SA_GlueUp(void) { GlueSA_Up(&SA); }
+static void SA_GlueDown(void) { GlueSA_Down(&SA); }
+static void SA_ClipUp(void) { ClipSA_Up(&SA); }
+static void SA_ClipDown(void) { ClipSA_Down(&SA); }
+static void SA_GlueUpPow2(void) { GlueSA_UpPow2(&SA); }
+static void SA_GlueDownPow2(void) { GlueSA_DownPow2(&SA); }
+static void SA_ClipUpPow2(void) { ClipSA_UpPow2(&SA); }
+static void SA_ClipDownPow2(void) { ClipSA_DownPow2(&SA); }
+static void BitV_GlueUp(void) { GlueBitV_Up(&BiV, 0x5A, 8); }
+static void BitV_GlueDown(void) { GlueBitV_Down(&BiV, 0x5A, 8); }
+static void BitV_ClipUp(void) { ClipBitV_Up(&BiV, 8); }
+static void BitV_ClipDown(void) { ClipBitV_Down(&BiV, 8); }
+
+typedef struct {
+  const char* Name;
+  void (*fnNew)(u32 Size);
+  void (*fnGlueUp)(void);
+  void (*fnGlueDown)(void);
+  void (*fnClipUp)(void);
+  void (*fnClipDown)(void);
+} QB_Ops_t;
+
+static const QB_Ops_t QB_Ops[] = {
+  { "ByteVein", NewBV_Any, BV_GlueUp, BV_GlueDown, BV_ClipUp, BV_ClipDown },
+  { "ByteVeinPow2", NewBV_Pow2Any, BV_GlueUpPow2, BV_GlueDownPow2, BV_ClipUpPow2, BV_ClipDownPow2 },
+  { "StuffsArtery", NewSA_Any, SA_GlueUp, SA_GlueDown, SA_ClipUp, SA_ClipDown },
+  { "StuffsArteryPow2", NewSA_Pow2Any, SA_GlueUpPow2, SA_GlueDownPow2, SA_ClipUpPow2, SA_ClipDownPow2 },
+  { "BitVein8", NewBitV_Any, BitV_GlueUp, BitV_GlueDown, BitV_ClipUp, BitV_ClipDown },
+};
+
+static const char* const QB_Workloads[] = { "FIFO", "LIFO", "Deque" };
+static const u32 QB_Sizes[] = { 16, 64, 256 };
+
+typedef struct {
+  const QB_Ops_t* O;
+  u32 Workload;
+  u32 Size;
+} QB_Case_t;
+
+static void QB_New(void* p) {
+
+  QB_Case_t* C = p;
+  C->O->fnNew(C->Size);
+  C->O->fnGlueUp(); // keep one item inside so the pattern walks around the buffer
+}
+
+// n items in, n items out (n even)
+static void QB_Pattern(void* p) {
+
+  QB_Case_t* C = p;
+  const QB_Ops_t* O = C->O;
+  u32 i, n = C->Size / 2;
+
+  switch(C->Workload) {
+  case 0: // FIFO
+    for(i=0;i<n;i++) BENCH_CALL(O->fnGlueUp());
+    for(i=0;i<n;i++) BENCH_CALL(O->fnClipDown());
+    break;
+  case 1: // LIFO
+    for(i=0;i<n;i++) BENCH_CALL(O->fnGlueUp());
+    for(i=0;i<n;i++) BENCH_CALL(O->fnClipUp());
+    break;
+  default: // Deque
+    for(i=0;i<n;i+=2) { BENCH_CALL(O->fnGlueUp()); BENCH_CALL(O->fnGlueDown()); };
+    for(i=0;i<n;i+=2) { BENCH_CALL(O->fnClipUp()); BENCH_CALL(O->fnClipDown()); };
+  };
+}
+
+// BV_Bench on the host: 200 bytes in and out per round, byte by byte or as spans (the memcpy split at the rollover), 50 bytes kept inside
+// Ops are bytes, so Mops/s reads as MB/s. The span p50/p99 are per 200 byte call
+#define SPAN_BYTES 200
+static u8 Span[SPAN_BYTES];
+
+static void Span_New(void* p) {
+
+  NewBV(&BV, (u32)BVR, sizeof(BVR));
+  GlueBV_UpN(&BV, (u32)Span, 50);
+  (void)p;
+}
+
+static void Span_PerByte(void* p) {
+
+  u32 i;
+  for(i=0;i<SPAN_BYTES;i++) BENCH_CALL(AddToBV(&BV, Span[i]));
+  for(i=0;i<SPAN_BYTES;i++) BENCH_CALL(ClipBV_Down(&BV));
+  (void)p;
+}
+
+static void Span_Bulk(void* p) {
+
+  BENCH_CALL(GlueBV_UpN(&BV, (u32)Span, SPAN_BYTES));
+  BENCH_CALL(ClipBV_DownN(&BV, (u32)Span, SPAN_BYTES));
+  (void)p;
+}
+
+// BitVein at other field widths: a FIFO through the whole 256 byte table, the fields straddle the words and the rollover unless 1 or 32 bits
+static const u32 BitV_Widths[] = { 1, 7, 13, 32 };
+
+static void BitV_New(void* p) {
+
+  NewBitV(&BiV, (u32)BiVR, sizeof(BiVR));
+  GlueBitV_Up(&BiV, 0x5A, *(u32*)p);
+}
+
+static void BitV_Pattern(void* p) {
+
+  u32 w = *(u32*)p, i, n = (sizeof(BiVR) * 8 / w - 1) & ~1U;
+
+  for(i=0;i<n;i++) BENCH_CALL(GlueBitV_Up(&BiV, 0x5A, w));
+  for(i=0;i<n;i++) BENCH_CALL(ClipBitV_Down(&BiV, w));
+}
+
+int main(int argc, char** argv) {
+
+  static double ns[countof(QB_Ops)][countof(QB_Workloads)][countof(QB_Sizes)];
+  QB_Case_t C;
+  char Name[64];
+  u32 p, w, s;
+
+  BenchBegin(argc, argv);
+  for(p=0;p<countof(QB_Ops);p++)
+    for(w=0;w<countof(QB_Workloads);w++)
+      for(s=0;s<countof(QB_Sizes);s++) {
+        C.O = &QB_Ops[p];
+        C.Workload = w;
+        C.Size = QB_Sizes[s];
+        snprintf(Name, sizeof(Name), "%s/%s/%u", QB_Ops[p].Name, QB_Workloads[w], (unsigned)QB_Sizes[s]);
+        ns[p][w][s] = BenchRun(Name, QB_New, QB_Pattern, &C, QB_OPS / QB_Sizes[s], QB_Sizes[s]);
+      };
+  for(p=0;p<4;p+=2) // ByteVein and StuffsArtery, their Pow2 next
+    for(w=0;w<countof(QB_Workloads);w++)
+      for(s=0;s<countof(QB_Sizes);s++)
+        printf("%s/%s/%u: power of two mask %.2f ns/op, rollover %.2f ns/op, x%.2f\n", QB_Ops[p].Name, QB_Workloads[w], (unsigned)QB_Sizes[s],
+          ns[p + 1][w][s], ns[p][w][s], ns[p][w][s] / ns[p + 1][w][s]);
+  BenchRun("ByteVein/PerByte/200", Span_New, Span_PerByte, 0, QB_OPS / SPAN_BYTES, 2 * SPAN_BYTES);
+  BenchRun("ByteVein/Span/200", Span_New, Span_Bulk, 0, QB_OPS / SPAN_BYTES, 2 * SPAN_BYTES);
+  for(w=0;w<countof(BitV_Widths);w++) {
+    s = (sizeof(BiVR) * 8 / BitV_Widths[w] - 1) & ~1U; // fields in a round
+    snprintf(Name, sizeof(Name), "BitVein%u/FIFO/%u", (unsigned)BitV_Widths[w], (unsigned)s);
+    BenchRun(Name, BitV_New, BitV_Pattern, (void*)&BitV_Widths[w], QB_OPS / s, 2 * s);
+  };
+  return BenchEnd();
+}
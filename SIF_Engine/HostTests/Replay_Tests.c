@@ -0,0 +1,78 @@
+#include "HostTests.h"
+
+// Replay mode: a sequence recorded once, re-armed and run again, refused while the previous run is not over (its last job armed included)
+// Send() follows LCD_NHD16x2SendByte(): the first byte records the sequence, the next ones re-arm it before updating the jobs in place
+static StuffsArtery_t SA;
+static u32 SAR[4];
+static u32 Log[64], nLog, Armed;
+static u8 Byte;
+
+static u32 Rec(u32 u) { Log[nLog++] = ((u32*)u)[0]; return 0; } // p[0] number
+static u32 RecByte(u32 u) { (void)u; Log[nLog++] = Byte; return 0; }
+static u32 MaybeArmed(u32 u) { Log[nLog++] = ((u32*)u)[0]; return Armed; } // as if its callback was armed
+
+static OneJob_t Jobs[3];
+
+static u32 Send(u8 b) { // 0: refused, nothing touched
+
+  if(SA.ReplayCount && (RearmSA_Replay(&SA)==0))
+    return 0;
+  Byte = b;
+  if(SA.ReplayCount==0) {
+    AddJobToSA(&SA, &Jobs[0]);
+    AddJobToSA(&SA, &Jobs[1]);
+    AddJobToSA(&SA, &Jobs[2]);
+    RecordSA_Replay(&SA);
+  };
+  StartJobToDoInForeground((u32)&SA);
+  return 1;
+}
+
+int main(void) {
+
+  u32 n, Down;
+
+  // the first run starts 3 slots in: the recorded sequence rolls over the end of the table
+  NewSA(&SA, (u32)SAR, countof(SAR));
+  for(n=0;n<3;n++) Jobs[n] = (OneJob_t) { Rec, { 90 + n } };
+  for(n=0;n<3;n++) AddJobToSA(&SA, &Jobs[n]);
+  CHECK((JobToDo((u32)&SA)==0) && (nLog==3) && (SA.bCount==0));
+
+  nLog = 0;
+  Jobs[0] = (OneJob_t) { Rec, { 1 } };
+  Jobs[1] = (OneJob_t) { RecByte, { 0 } };
+  Jobs[2] = (OneJob_t) { MaybeArmed, { 3 } };
+  CHECK(Send('a') && (SA.ReplayCount==3) && (SA.bCount==0) && SA.FlagEmptied);
+  CHECK((nLog==3) && (Log[0]==1) && (Log[1]=='a') && (Log[2]==3));
+
+  // re-armed: the same jobs, updated in place, nothing glued again
+  Down = SA.ReplayDown;
+  for(n=0;n<3;n++)
+    CHECK(Send('b' + n));
+  CHECK((nLog==12) && (Log[4]=='b') && (Log[7]=='c') && (Log[10]=='d') && (Log[11]==3));
+  CHECK((SA.ReplayDown==Down) && (SA.ReplayCount==3) && (SA.bCount==0));
+
+  // still running: a job waits for its callback, Send() and ReplaySA() are refused and leave everything as is
+  nLog = 0;
+  Jobs[0] = (OneJob_t) { MaybeArmed, { 1 } };
+  Armed = 1;
+  CHECK(RearmSA_Replay(&SA) && (JobToDo((u32)&SA)==1) && (SA.bCount==2));
+  CHECK((Send('x')==0) && (Byte=='d') && (SA.bCount==2) && (SA.pbDown==(Down + 1) % countof(SAR)));
+  CHECK((ReplaySA((u32)&SA)==0) && (nLog==1));
+  Jobs[0] = (OneJob_t) { Rec, { 1 } };
+  CHECK(ResumeJobToDo((u32)&SA)==1); // its callback: the last job arms too
+  CHECK((nLog==3) && (Log[1]=='d') && (SA.bCount==0) && SA.JobArmed);
+
+  // the last job still waits: no count left, yet the run is not over
+  CHECK((RearmSA_Replay(&SA)==0) && (Send('y')==0) && (ReplaySA((u32)&SA)==0) && (Byte=='d') && (nLog==3));
+  Armed = 0;
+  CHECK((ResumeJobToDo((u32)&SA)==0) && (SA.JobArmed==0));
+
+  // over: accepted again
+  nLog = 0;
+  CHECK(Send('z') && (nLog==3) && (Log[1]=='z'));
+  CHECK((ReplaySA((u32)&SA)==0) && (nLog==6) && (Log[4]=='z') && (SA.bCount==0));
+
+  printf("Replay_Tests ok\n");
+  return 0;
+}
@@ -0,0 +1,79 @@
+#include "HostTests.h"
+#include <sched.h>
+
+// NewBV_SPSC(): a producer thread standing for the RX interrupt glues a byte stream, the consumer clips it without any lock
+// Both sides draw the same xorshift stream: a byte lost, duplicated or out of order is a mismatch (not hidden by a counter wrapping at 256)
+// The small buffer makes the indexes roll over every 61 bytes
+#define BYTES 200000000
+
+static ByteVein_t BV;
+static u8 BVR[61];
+static u32 Retries;
+
+static u32 NextByte(u32* State) {
+
+  u32 x = *State;
+  x ^= x<<13;
+  x ^= x>>17;
+  x ^= x<<5;
+  *State = x;
+  return x & 0xFF;
+}
+
+static void* Producer(void* p) {
+
+  u32 State = 1, n;
+  for(n=0;n<BYTES;n++) {
+    BV.In = NextByte(&State);
+    while(GlueBV_SPSC(&BV)==0) { // full: dropped, the interrupt would lose it, here it is glued again
+      Retries++;
+      sched_yield();
+    };
+  };
+  return p;
+}
+
+int main(void) {
+
+  pthread_t Thread;
+  u32 State = 1, n, Count, Got = 0;
+
+  // NewBV() on a strand which was SPSC: classic again
+  NewBV_SPSC(&BV, (u32)BVR, sizeof(BVR));
+  CHECK(BV.SPSC==1);
+  NewBV(&BV, (u32)BVR, sizeof(BVR));
+  CHECK(BV.SPSC==0);
+
+  // single context: one slot kept free, the newest dropped when full, the indexes rolling over
+  NewBV_SPSC(&BV, (u32)BVR, sizeof(BVR));
+  SetBV_OverflowPolicy(&BV, BV_DROP_NEWEST);
+  for(n=0;n<sizeof(BVR) - 1;n++)
+    CHECK(AddToBV_SPSC(&BV, n)==(u32)&BVR[n]);
+  CHECK((GetBV_SPSC_Count(&BV)==sizeof(BVR) - 1) && (AddToBV_SPSC(&BV, 99)==0) && (BV.bDropped==1));
+  for(n=0;n<1000;n++) {
+    CHECK(ClipBV_SPSC(&BV)==(n & 0xFF));
+    CHECK(AddToBV_SPSC(&BV, (n + sizeof(BVR) - 1) & 0xFF));
+    CHECK(GetBV_SPSC_Count(&BV)==sizeof(BVR) - 1);
+  };
+
+  // concurrent: the main thread is the consumer
+  NewBV_SPSC(&BV, (u32)BVR, sizeof(BVR));
+  SetBV_OverflowPolicy(&BV, BV_DROP_NEWEST);
+  BV.bDropped = 0;
+  Thread = HostThread(Producer, 0);
+  while(Got<BYTES) {
+    Count = GetBV_SPSC_Count(&BV);
+    if(Count==0) {
+      sched_yield();
+      continue;
+    };
+    for(;Count;Count--,Got++)
+      CHECK(ClipBV_SPSC(&BV)==NextByte(&State));
+  };
+  pthread_join(Thread, 0);
+  CHECK(GetBV_SPSC_Count(&BV)==0);
+  CHECK(BV.bDropped==Retries);
+
+  printf("SPSC_Tests ok, %u bytes, the producer found it full %u times\n", (unsigned)Got, (unsigned)Retries);
+  return 0;
+}
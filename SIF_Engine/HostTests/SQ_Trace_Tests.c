@@ -0,0 +1,75 @@
+#include "HostTests.h"
+
+// SEQUENCER_TRACE (this test and SebSequencer.c are built with it, see Makefile): the events of a sequence whose jobs arm callbacks,
+// the last one included, then the dump through Tools/SQ_TraceToChrome.py with the job names from this program
+// The cycle counter starts just below 2^30 so the 30 bit stamps wrap during the sequence
+static StuffsArtery_t SA;
+static u32 SAR[8];
+
+static u32 TracedA(u32 u) { (void)u; HostDWT.CYCCNT += 100; return 0; }
+static u32 TracedB(u32 u) { (void)u; HostDWT.CYCCNT += 100; return 1; } // a callback armed
+static u32 TracedC(u32 u) { (void)u; HostDWT.CYCCNT += 100; return 1; } // the last one, armed too
+static OneJob_t Jobs[3] = { { TracedA, { 0 } }, { TracedB, { 0 } }, { TracedC, { 0 } } };
+
+static const struct { u32 Event; u32 (*fnJob)(u32); } Expected[] = {
+  { SQ_TRACE_ENQUEUE, TracedA }, { SQ_TRACE_ENQUEUE, TracedB }, { SQ_TRACE_ENQUEUE, TracedC },
+  { SQ_TRACE_START, TracedA }, { SQ_TRACE_END, TracedA }, { SQ_TRACE_START, TracedB }, { SQ_TRACE_END, TracedB },
+  { SQ_TRACE_RESUME, TracedB }, { SQ_TRACE_START, TracedC }, { SQ_TRACE_END, TracedC },
+  { SQ_TRACE_RESUME, TracedC },
+};
+
+static u32 Count(const char* s, const char* What) {
+
+  u32 n = 0;
+  while((s = strstr(s, What))!=0) { n++; s++; };
+  return n;
+}
+
+int main(int argc, char** argv) {
+
+  static char Json[1<<16];
+  char Command[512];
+  FILE* F;
+  u32 n, Stamp;
+  size_t Size;
+
+  NewSA(&SA, (u32)SAR, countof(SAR));
+  NewSQ_Trace();
+  CHECK(HostDWT.CTRL & DWT_CTRL_CYCCNTENA_Msk);
+  HostDWT.CYCCNT = 0x3FFFFF00;
+  for(n=0;n<countof(Jobs);n++) AddJobToSA(&SA, &Jobs[n]);
+
+  CHECK(JobToDo((u32)&SA)==1); // B armed
+  HostDWT.CYCCNT += 1000; // its interrupt
+  CHECK(ResumeJobToDo((u32)&SA)==1); // C armed
+  HostDWT.CYCCNT += 2000;
+  CHECK(ResumeJobToDo((u32)&SA)==0); // the sequence is over
+  CHECK(SA.JobArmed==0);
+
+  CHECK(SQ_Trace.Count==countof(Expected));
+  for(n=0;n<countof(Expected);n++) {
+    Stamp = SQ_Trace.Events[n].Stamp;
+    CHECK(((Stamp>>30)==Expected[n].Event) && (SQ_Trace.Events[n].fnJob==(u32)Expected[n].fnJob));
+  };
+  CHECK((SQ_Trace.Events[10].Stamp & 0x3FFFFFFF)==((0x3FFFFF00 + 3*100 + 1000 + 2000) & 0x3FFFFFFF));
+
+  // the dump as the debugger gives it, little endian as the target
+  F = fopen("build/SQ_Trace.bin", "wb");
+  CHECK(F && (fwrite(&SQ_Trace, sizeof(SQ_Trace), 1, F)==1));
+  fclose(F);
+  snprintf(Command, sizeof(Command), "python3 ../Tools/SQ_TraceToChrome.py build/SQ_Trace.bin -e %s --nm nm -m 1", argv[0]);
+  F = popen(Command, "r");
+  CHECK(F);
+  Size = fread(Json, 1, sizeof(Json) - 1, F);
+  CHECK((pclose(F)==0) && (Size>0));
+  Json[Size] = 0;
+
+  // both armed jobs give their wait slice, the last one too: it ends 3300 cycles (us at 1 MHz) after the first event
+  CHECK(Count(Json, "\"cat\": \"wait\"")==4);
+  CHECK((Count(Json, "\"name\": \"TracedA\"")==3) && (Count(Json, "\"name\": \"TracedB\"")==6) && (Count(Json, "\"name\": \"TracedC\"")==6));
+  CHECK(strstr(Json, "\"ts\": 3300.0"));
+  (void)argc;
+
+  printf("SQ_Trace_Tests ok\n");
+  return 0;
+}
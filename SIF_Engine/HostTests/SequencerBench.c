@@ -0,0 +1,84 @@
+#include "HostBench.h"
+
+// Sequencer_Bench on the host: the dispatch overhead per empty job, 64 jobs per round (QueueBenchDemos.c does it with the cycle counter)
+// The jobs are queued before the clock starts, only the dispatch is timed (except for QueueAndJobToDo and Program, queued once)
+#define SB_ROUNDS 2048
+
+static u32 NoJob(u32 u) { return u & 0; }
+static OneJob_t Job = { NoJob, { 0 } };
+static JobLanes_t Lanes;
+static StuffsArtery_t LaneSA[8];
+static u32 LaneR[8][64];
+static JobProgram_t Program;
+static u32 ProgramCode[6]; // the 64 calls as one job program, built in main(): a function address is not a constant u32 here
+
+static uint64_t Dispatch_ns(u32 nLanes) { // one round
+
+  uint64_t Start_ns;
+  u32 n;
+
+  if(nLanes==0xFF) { // job program, queued once
+    Start_ns = BenchNow_ns();
+    AddProgramToSA(&LaneSA[0], &Program, ProgramCode);
+    JobToDo((u32)&LaneSA[0]);
+    return BenchNow_ns() - Start_ns;
+  };
+
+  if(nLanes==0xFE) { // queuing included
+    Start_ns = BenchNow_ns();
+    for(n=0;n<64;n++)
+      AddToSA(&LaneSA[0], (u32)&Job);
+    JobToDo((u32)&LaneSA[0]);
+    return BenchNow_ns() - Start_ns;
+  };
+
+  if(nLanes==0) { // plain sequencer
+    for(n=0;n<64;n++)
+      AddToSA(&LaneSA[0], (u32)&Job);
+    Start_ns = BenchNow_ns();
+    JobToDo((u32)&LaneSA[0]);
+    return BenchNow_ns() - Start_ns;
+  };
+
+  for(n=0;n<64;n++)
+    AddJobToLane(&Lanes, n % nLanes, (u32)&Job);
+  Start_ns = BenchNow_ns();
+  LanesJobToDo((u32)&Lanes);
+  return BenchNow_ns() - Start_ns;
+}
+
+static double Measure(void* p) { // ns per job
+
+  uint64_t ns = 0;
+  u32 r;
+  for(r=0;r<SB_ROUNDS;r++) ns += Dispatch_ns(*(u32*)p);
+  return (double)ns / (SB_ROUNDS * 64);
+}
+
+static void Figure(const char* Name, u32 nLanes) { BenchMeasure(Name, Measure, &nLanes); }
+
+int main(int argc, char** argv) {
+
+  const u32 Code[] = {
+    JP_LOOP(64),
+      JP_CALL(NoJob, 0),
+    JP_ENDLOOP,
+    JP_END
+  };
+  u32 n;
+
+  BenchBegin(argc, argv);
+  memcpy(ProgramCode, Code, sizeof(Code));
+  NewJobLanes(&Lanes);
+  for(n=0;n<8;n++) {
+    NewSA(&LaneSA[n], (u32)LaneR[n], countof(LaneR[n]));
+    SetJobLane(&Lanes, n, &LaneSA[n]);
+  };
+
+  Figure("Sequencer/JobToDo", 0);
+  Figure("Sequencer/Lanes1", 1);
+  Figure("Sequencer/Lanes8", 8);
+  Figure("Sequencer/QueueAndJobToDo", 0xFE);
+  Figure("Sequencer/Program", 0xFF);
+  return BenchEnd();
+}
@@ -0,0 +1,305 @@
+#include "HostTests.h"
+
+// The vein and artery primitives of Queue_Bench against a deque model: random glues and clips on both sides, with every fill level and wrap
+static ByteVein_t BV;
+static u8 BVR[256];
+static StuffsArtery_t SA;
+static u32 SAR[256];
+
+typedef struct {
+  const char* Name;
+  u32 (*fnBV[4])(ByteVein_t*); // glue up, glue down, clip up, clip down
+  u32 (*fnSA[4])(StuffsArtery_t*); // or these
+} Ops_t;
+
+static const Ops_t Ops[] = {
+  { "ByteVein", { GlueBV_Up, GlueBV_Down, ClipBV_Up, ClipBV_Down }, { 0 } },
+  { "ByteVein Pow2", { GlueBV_UpPow2, GlueBV_DownPow2, ClipBV_UpPow2, ClipBV_DownPow2 }, { 0 } },
+  { "StuffsArtery", { 0 }, { GlueSA_Up, GlueSA_Down, ClipSA_Up, ClipSA_Down } },
+  { "StuffsArtery Pow2", { 0 }, { GlueSA_UpPow2, GlueSA_DownPow2, ClipSA_UpPow2, ClipSA_DownPow2 } },
+};
+
+static void Do(const Ops_t* O, u32 Op) {
+  if(O->fnBV[Op]) O->fnBV[Op](&BV);
+  else O->fnSA[Op](&SA);
+}
+
+static u32 Model[4096], Head, Tail; // Tail..Head-1, the Down side is the tail
+
+static u32 Run(u32 Primitive, u32 Size) {
+
+  const Ops_t* O = &Ops[Primitive];
+  u32 n, Item, Got, Count;
+  u32 IsSA = Primitive>=2;
+
+  switch(Primitive) {
+  case 0: NewBV(&BV, (u32)BVR, Size); break;
+  case 1: NewBV_Pow2(&BV, (u32)BVR, Size); break;
+  case 2: NewSA(&SA, (u32)SAR, Size); break;
+  default: NewSA_Pow2(&SA, (u32)SAR, Size);
+  };
+  Head = Tail = 2048;
+
+  for(n=0;n<200000;n++) {
+    Count = Head - Tail;
+    Item = IsSA ? (u32)rand() : (u32)(rand() & 0xFF);
+    switch(rand() & 3) {
+    case 0:
+      if(Count==Size) break;
+      if(IsSA) SA.In = Item; else BV.In = Item;
+      Do(O, 0);
+      Model[Head++] = Item;
+      break;
+    case 1:
+      if(Count==Size) break;
+      if(IsSA) SA.In = Item; else BV.In = Item;
+      Do(O, 1);
+      Model[--Tail] = Item;
+      break;
+    case 2:
+      if(Count==0) break;
+      Do(O, 2);
+      Got = IsSA ? SA.Out : BV.Out;
+      CHECK(Got==Model[--Head]);
+      break;
+    default:
+      if(Count==0) break;
+      Do(O, 3);
+      Got = IsSA ? SA.Out : BV.Out;
+      CHECK(Got==Model[Tail++]);
+    };
+    CHECK((IsSA ? SA.bCount : BV.bCount)==Head - Tail);
+    if((Tail<Size)||(Head>4096 - Size)) { // recenter the model
+      memmove(&Model[2048 - (Head - Tail)/2], &Model[Tail], (Head - Tail) * sizeof(u32));
+      Count = Head - Tail;
+      Tail = 2048 - Count/2;
+      Head = Tail + Count;
+    };
+  };
+  return 0;
+}
+
+// GlueBV_UpN/ClipBV_DownN: spans of 1 to 15 bytes after one byte kept at each place of a 16 byte strand, so the copies split at the
+// rollover or not. The buffer is checked where the split puts the bytes, the spans are read back by both the span and the byte functions
+static void SpanAt(u32 Start) { // one byte inside, at BVR[Start]
+
+  u32 i;
+  memset(&BV, 0, sizeof(BV));
+  NewBV(&BV, (u32)BVR, 16);
+  BV.In = 0xEE;
+  GlueBV_Up(&BV);
+  for(i=0;i<Start;i++) { GlueBV_Up(&BV); ClipBV_Down(&BV); };
+}
+
+static u32 Span(void) {
+
+  u8 In[16], Out[16];
+  u32 Start, n, i;
+
+  for(Start=0;Start<16;Start++)
+    for(n=1;n<16;n++) {
+      for(i=0;i<n;i++) In[i] = (u8)(16*Start + i);
+
+      // the span glued, read back by the span or byte by byte
+      SpanAt(Start);
+      CHECK(GlueBV_UpN(&BV, (u32)In, n)==n);
+      CHECK((BV.bCount==n + 1) && (BV.In==In[n-1]) && (BV.pbUp==(u32)&BVR[(Start + n) % 16]));
+      for(i=0;i<n;i++) CHECK(BVR[(Start + 1 + i) % 16]==In[i]);
+      CHECK(ClipBV_Down(&BV)==0xEE);
+      if(n & 1) {
+        CHECK(ClipBV_DownN(&BV, (u32)Out, n)==n);
+        CHECK((memcmp(In, Out, n)==0) && (BV.Out==In[n-1]));
+      }else{
+        for(i=0;i<n;i++) CHECK(ClipBV_Down(&BV)==In[i]);
+      };
+      CHECK(BV.bCount==0);
+
+      // glued byte by byte, read back by the span
+      SpanAt(Start);
+      for(i=0;i<n;i++) { BV.In = In[i]; GlueBV_Up(&BV); };
+      CHECK(ClipBV_Down(&BV)==0xEE);
+      CHECK(ClipBV_DownN(&BV, (u32)Out, n)==n);
+      CHECK((memcmp(In, Out, n)==0) && (BV.pbDown==(u32)&BVR[(Start + 1 + n) % 16]) && (BV.bCount==0));
+    };
+  return 0;
+}
+
+// BitVein: fields of 1 to 32 bits on both sides against a model of the bits, so a field read back may straddle the fields glued
+// (the bits of a field are its LSB first from the Down side). The tables of 1 to 3 words make the fields cross the words and the rollover
+static BitVein_t BiV;
+static u32 BiVR[3];
+static u8 Bits[8192]; // one bit per byte, Tail..Head-1
+
+static u32 BitRun(u32 Words) {
+
+  u32 n, i, w, Value, Got, Limit = Words * 32;
+
+  NewBitV(&BiV, (u32)BiVR, Words * 4);
+  Head = Tail = 4096;
+  for(n=0;n<200000;n++) {
+    w = 1 + (rand() & 31);
+    Value = ((u32)rand()<<16) ^ (u32)rand();
+    switch(rand() & 3) {
+    case 0:
+      if(Head - Tail + w>Limit) break;
+      GlueBitV_Up(&BiV, Value, w);
+      for(i=0;i<w;i++) Bits[Head++] = (Value>>i) & 1;
+      break;
+    case 1:
+      if(Head - Tail + w>Limit) break;
+      GlueBitV_Down(&BiV, Value, w);
+      for(i=w;i--;) Bits[--Tail] = (Value>>i) & 1;
+      break;
+    case 2:
+      if(Head - Tail<w) break;
+      Got = ClipBitV_Up(&BiV, w);
+      Head -= w;
+      for(i=0;i<w;i++) CHECK(((Got>>i) & 1)==Bits[Head + i]);
+      CHECK((w==32) || ((Got>>w)==0));
+      break;
+    default:
+      if(Head - Tail<w) break;
+      Got = ClipBitV_Down(&BiV, w);
+      for(i=0;i<w;i++) CHECK(((Got>>i) & 1)==Bits[Tail++]);
+      CHECK((w==32) || ((Got>>w)==0));
+    };
+    CHECK(BiV.bCount==Head - Tail);
+    if((Tail<Limit)||(Head>8192 - Limit)) { // recenter the model
+      memmove(&Bits[4096 - (Head - Tail)/2], &Bits[Tail], Head - Tail);
+      w = Head - Tail;
+      Tail = 4096 - w/2;
+      Head = Tail + w;
+    };
+  };
+  return 0;
+}
+
+// BV_OVERWRITE_OLDEST: the strand stays full, the newest bytes are kept and the empty and full hooks fire once
+static u32 NoLongerEmpties, Fulls;
+static u32 NoLongerEmpty(u32 u) { NoLongerEmpties++; return u; }
+static u32 Full(u32 u) { Fulls++; return u; }
+
+static u32 Overwrite(u32 Size, u32 Up) {
+
+  u32 n;
+  memset(&BV, 0, sizeof(BV)); // NewBV() keeps the hooks and the figures
+  NewBV(&BV, (u32)BVR, Size);
+  SetBV_OverflowPolicy(&BV, BV_OVERWRITE_OLDEST);
+  BV.fnNoLongerEmpty = NoLongerEmpty;
+  BV.fnFull = Full;
+  NoLongerEmpties = Fulls = 0;
+  for(n=0;n<10;n++) {
+    BV.In = n;
+    if(Up) GlueBV_Up(&BV); else GlueBV_Down(&BV);
+  };
+  CHECK((NoLongerEmpties==1) && (Fulls==1));
+  CHECK((BV.bCount==Size) && (BV.bDropped==10 - Size));
+  for(n=10-Size;n<10;n++) // the oldest first
+    CHECK((Up ? ClipBV_Down(&BV) : ClipBV_Up(&BV))==n);
+  return 0;
+}
+
+// ReserveBV_*/CommitBV_*: a DMA stands for the producer and the consumer, the bytes it moves are a sequence checked on the way out
+// Reserved regions stop at the rollover point, a partial commit releases the rest, the FromDMA commits take NDTR as left by the stream
+static DMA_Stream_TypeDef Stream;
+static u32 Emptieds;
+static u32 Emptied(u32 u) { Emptieds++; return u; }
+
+static u32 Written, Read; // the sequence so far, both ways
+
+static void DMA_Write(u32 n, u32 Reserved) { // the stream writes n of the reserved bytes then stops
+  u32 i;
+  for(i=0;i<n;i++) ((u8*)BV.pbUpReserved)[i] = (u8)Written++;
+  Stream.NDTR = Reserved - n;
+}
+
+static u32 DMA_Read(u32 n, u32 Reserved) {
+  u32 i;
+  for(i=0;i<n;i++) CHECK(((u8*)BV.pbDown)[i]==(u8)Read++);
+  Stream.NDTR = Reserved - n;
+  return 0;
+}
+
+static u32 ReserveCommit(void) {
+
+  memset(&BV, 0, sizeof(BV));
+  NewBV(&BV, (u32)BVR, 16);
+  BV.fnNoLongerEmpty = NoLongerEmpty;
+  BV.fnFull = Full;
+  BV.fnEmptied = Emptied;
+  NoLongerEmpties = Fulls = Emptieds = Written = Read = 0;
+
+  // empty: the whole strand from its left side, 10 bytes written out of 16
+  CHECK((ReserveBV_Up(&BV)==16) && (BV.pbUpReserved==(u32)BVR));
+  DMA_Write(10, 16);
+  CHECK((CommitBV_UpFromDMA(&BV, &Stream)==10) && (BV.bCount==10) && (BV.bUpReserved==0));
+  CHECK((BV.pbDown==(u32)BVR) && (BV.pbUp==(u32)&BVR[9]) && (BV.In==9) && (NoLongerEmpties==1));
+
+  // partial commits on the way out: 4 bytes by hand, then 4 of the 6 left by the stream
+  CHECK(ReserveBV_Down(&BV)==10);
+  CHECK(DMA_Read(4, 10)==0);
+  CHECK((CommitBV_Down(&BV, 4)==4) && (BV.bDownReserved==0) && (BV.Out==3) && (BV.bCount==6));
+  CHECK(ReserveBV_Down(&BV)==6);
+  CHECK(DMA_Read(4, 6)==0);
+  CHECK((CommitBV_DownFromDMA(&BV, &Stream)==4) && (BV.pbDown==(u32)&BVR[8]) && (BV.bCount==2));
+
+  // the up side wraps: free up to the top first, then from the left side up to the tail, then full
+  CHECK((ReserveBV_Up(&BV)==6) && (BV.pbUpReserved==(u32)&BVR[10]));
+  DMA_Write(6, 6);
+  CHECK((CommitBV_UpFromDMA(&BV, &Stream)==6) && (BV.pbUp==(u32)&BVR[15]));
+  CHECK((ReserveBV_Up(&BV)==8) && (BV.pbUpReserved==(u32)BVR));
+  DMA_Write(8, 8);
+  CHECK((CommitBV_UpFromDMA(&BV, &Stream)==8) && (BV.pbUp==(u32)&BVR[7]) && (BV.bCount==16) && (Fulls==1));
+  CHECK(ReserveBV_Up(&BV)==0);
+  CHECK(CommitBV_Up(&BV, 0)==0);
+
+  // the down side wraps: filled up to the top first, then from the left side, mixed with the byte by byte functions
+  CHECK(ReserveBV_Down(&BV)==8);
+  CHECK(DMA_Read(8, 8)==0);
+  CHECK((CommitBV_DownFromDMA(&BV, &Stream)==8) && (BV.pbDown==(u32)BVR) && (BV.bCount==8));
+  CHECK(ClipBV_Down(&BV)==(u8)Read++);
+  BV.In = (u8)Written++;
+  GlueBV_Up(&BV);
+  CHECK(ReserveBV_Down(&BV)==8);
+  CHECK(DMA_Read(8, 8)==0);
+  CHECK((CommitBV_DownFromDMA(&BV, &Stream)==8) && (BV.bCount==0) && (Emptieds==1) && (Read==Written));
+
+  // empty again: the reservation starts over on the left side
+  CHECK((ReserveBV_Up(&BV)==16) && (BV.pbUpReserved==(u32)BVR));
+  return 0;
+}
+
+int main(void) {
+
+  static const u32 Sizes[] = { 16, 64, 256 };
+  u32 p, s;
+
+  srand(7);
+  for(p=0;p<countof(Ops);p++)
+    for(s=0;s<countof(Sizes);s++)
+      if(Run(p, Sizes[s])) {
+        printf("%s, %u items\n", Ops[p].Name, (unsigned)Sizes[s]);
+        return 1;
+      };
+  for(s=1;s<=4;s+=3)
+    for(p=0;p<2;p++)
+      if(Overwrite(s, p)) {
+        printf("ByteVein overwrite, %u bytes\n", (unsigned)s);
+        return 1;
+      };
+  if(Span()) {
+    printf("ByteVein spans\n");
+    return 1;
+  };
+  for(s=1;s<=countof(BiVR);s++)
+    if(BitRun(s)) {
+      printf("BitVein, %u words\n", (unsigned)s);
+      return 1;
+    };
+  if(ReserveCommit()) {
+    printf("ByteVein reserve and commit\n");
+    return 1;
+  };
+  printf("VeinTests ok\n");
+  return 0;
+}
@@ -0,0 +1,162 @@
+#ifndef _SEB_ENGINE_H_
+#define _SEB_ENGINE_H_
+
+// Host stand-in for sebEngine.h: the engine sources are built for a PC (see Makefile), the MCU registers are plain RAM structs defined in HostStubs.c
+// u32 is 32 bit as on the target, so the counters wrap as they do there. It carries addresses all over the engine: the tests keep them below 4GB (see HostStubs.c)
+
+#include <stdint.h>
+#include <string.h>
+
+typedef uint32_t u32;
+typedef uint16_t u16;
+typedef uint8_t u8;
+typedef int32_t s32;
+typedef int16_t s16;
+typedef int8_t s8;
+typedef enum {DISABLE = 0, ENABLE = !DISABLE} FunctionalState;
+#define FALSE 0
+#define TRUE 1
+
+#define NVIC_STATS
+#define SebPendSV
+#define SebEXTI0 // the vectors built by sebNVIC.c, as on the target
+#define SebEXTI9_5
+#define SebEXTI15_10
+#define SebADC
+#define SebTIM1_BRK_TIM9
+#define SebTIM2 // TIM2, TIM7... are also peripheral macros, as in the ST headers
+#define SebTIM3 NVIC_BARE
+#define SebTIM4 NVIC_DIRECT
+#define SebTIM6_DAC
+#define SebTIM7
+
+#define __irq
+#define __NOP()
+#define __DMB() __sync_synchronize()
+#define __NVIC_PRIO_BITS 4
+#define countof(a) (sizeof(a)/sizeof(a[0]))
+#define MakeItNoLessThan(a,b) if((a)<(b)) (a) = (b)
+#define MakeItNoMoreThan(a,b) if((a)>(b)) (a) = (b)
+#define max2(x,y) (((x) > (y)) ? (x) : (y))
+#define min2(x,y) (((x) < (y)) ? (x) : (y))
+
+//---------- the STM32F437 IRQs
+typedef enum {
+  NonMaskableInt_IRQn = -14, MemoryManagement_IRQn = -12, BusFault_IRQn = -11, UsageFault_IRQn = -10,
+  SVCall_IRQn = -5, DebugMonitor_IRQn = -4, PendSV_IRQn = -2, SysTick_IRQn = -1,
+  WWDG_IRQn = 0, PVD_IRQn, TAMP_STAMP_IRQn, RTC_WKUP_IRQn, FLASH_IRQn, RCC_IRQn,
+  EXTI0_IRQn, EXTI1_IRQn, EXTI2_IRQn, EXTI3_IRQn, EXTI4_IRQn,
+  DMA1_Stream0_IRQn, DMA1_Stream1_IRQn, DMA1_Stream2_IRQn, DMA1_Stream3_IRQn, DMA1_Stream4_IRQn, DMA1_Stream5_IRQn, DMA1_Stream6_IRQn,
+  ADC_IRQn, CAN1_TX_IRQn, CAN1_RX0_IRQn, CAN1_RX1_IRQn, CAN1_SCE_IRQn, EXTI9_5_IRQn,
+  TIM1_BRK_TIM9_IRQn, TIM1_UP_TIM10_IRQn, TIM1_TRG_COM_TIM11_IRQn, TIM1_CC_IRQn, TIM2_IRQn, TIM3_IRQn, TIM4_IRQn,
+  I2C1_EV_IRQn, I2C1_ER_IRQn, I2C2_EV_IRQn, I2C2_ER_IRQn, SPI1_IRQn, SPI2_IRQn, USART1_IRQn, USART2_IRQn, USART3_IRQn,
+  EXTI15_10_IRQn, RTC_Alarm_IRQn, OTG_FS_WKUP_IRQn, TIM8_BRK_TIM12_IRQn, TIM8_UP_TIM13_IRQn, TIM8_TRG_COM_TIM14_IRQn, TIM8_CC_IRQn,
+  DMA1_Stream7_IRQn, FMC_IRQn, SDIO_IRQn, TIM5_IRQn, SPI3_IRQn, UART4_IRQn, UART5_IRQn, TIM6_DAC_IRQn, TIM7_IRQn,
+  DMA2_Stream0_IRQn, DMA2_Stream1_IRQn, DMA2_Stream2_IRQn, DMA2_Stream3_IRQn, DMA2_Stream4_IRQn,
+  ETH_IRQn, ETH_WKUP_IRQn, CAN2_TX_IRQn, CAN2_RX0_IRQn, CAN2_RX1_IRQn, CAN2_SCE_IRQn, OTG_FS_IRQn,
+  DMA2_Stream5_IRQn, DMA2_Stream6_IRQn, DMA2_Stream7_IRQn, USART6_IRQn, I2C3_EV_IRQn, I2C3_ER_IRQn,
+  OTG_HS_EP1_OUT_IRQn, OTG_HS_EP1_IN_IRQn, OTG_HS_WKUP_IRQn, OTG_HS_IRQn, DCMI_IRQn, CRYP_IRQn, HASH_RNG_IRQn, FPU_IRQn,
+  UART7_IRQn, UART8_IRQn, SPI4_IRQn, SPI5_IRQn, SPI6_IRQn, SAI1_IRQn, LTDC_IRQn, LTDC_ER_IRQn
+} IRQn_Type;
+
+//---------- the core and the peripherals touched by the engine, as RAM
+typedef struct { u32 ISER[8], ICER[8], ISPR[8], ICPR[8], STIR; u8 IP[240]; } NVIC_Host_t;
+typedef struct { u32 ICSR; u8 SHP[12]; } SCB_Host_t;
+typedef struct { u32 CTRL, CYCCNT; } DWT_Host_t;
+typedef struct { u32 DEMCR; } CoreDebug_Host_t;
+typedef struct { u32 IMR, EMR, RTSR, FTSR, SWIER, PR; } EXTI_TypeDef;
+typedef struct { u32 CR1, DIER, SR; } TIM_TypeDef;
+typedef struct { u32 SR, DR, CR1; } USART_TypeDef;
+typedef struct { u32 NDTR; } DMA_Stream_TypeDef;
+
+extern NVIC_Host_t HostNVIC;
+extern SCB_Host_t HostSCB;
+extern DWT_Host_t HostDWT;
+extern CoreDebug_Host_t HostCoreDebug;
+extern EXTI_TypeDef HostEXTI;
+extern TIM_TypeDef HostTIM[15]; // [n]: TIMn
+extern USART_TypeDef HostUSART[7]; // [n]: USARTn
+extern u32 HostIPSR; // the active exception, 16 + IRQn
+extern u32 HostPRIMASK;
+
+#define NVIC (&HostNVIC)
+#define SCB (&HostSCB)
+#define DWT (&HostDWT)
+#define CoreDebug (&HostCoreDebug)
+#define EXTI (&HostEXTI)
+#define TIM1 (&HostTIM[1])
+#define TIM2 (&HostTIM[2])
+#define TIM3 (&HostTIM[3])
+#define TIM4 (&HostTIM[4])
+#define TIM5 (&HostTIM[5])
+#define TIM6 (&HostTIM[6])
+#define TIM7 (&HostTIM[7])
+#define TIM8 (&HostTIM[8])
+#define TIM9 (&HostTIM[9])
+#define TIM10 (&HostTIM[10])
+#define TIM11 (&HostTIM[11])
+#define TIM12 (&HostTIM[12])
+#define TIM13 (&HostTIM[13])
+#define TIM14 (&HostTIM[14])
+#define USART1 (&HostUSART[1])
+#define USART2 (&HostUSART[2])
+#define USART3 (&HostUSART[3])
+#define USART6 (&HostUSART[6])
+
+#define SCB_ICSR_PENDSVSET_Msk (1UL << 28)
+#define CoreDebug_DEMCR_TRCENA_Msk (1UL << 24)
+#define DWT_CTRL_CYCCNTENA_Msk 1UL
+#define TIM_FLAG_Update 0x0001
+#define TIM_FLAG_CC1 0x0002
+#define TIM_FLAG_CC2 0x0004
+#define TIM_FLAG_CC3 0x0008
+#define TIM_FLAG_CC4 0x0010
+#define TIM_FLAG_COM 0x0020
+#define TIM_FLAG_Trigger 0x0040
+#define TIM_FLAG_Break 0x0080
+#define USART_FLAG_TXE 0x0080
+
+static inline u32 __get_IPSR(void) { return HostIPSR; }
+static inline u32 __get_PRIMASK(void) { return HostPRIMASK; }
+static inline void __set_PRIMASK(u32 x) { HostPRIMASK = x; }
+static inline void __disable_irq(void) { HostPRIMASK = 1; }
+static inline void __enable_irq(void) { HostPRIMASK = 0; }
+static inline u32 __CLZ(u32 x) { return x ? __builtin_clz(x) : 32; }
+static inline u32 __RBIT(u32 x) { u32 r = 0, n; for(n=0;n<32;n++) if(x & (1UL<<n)) r |= 1UL<<(31-n); return r; }
+void NVIC_SetPriority(IRQn_Type IRQn, u32 Priority);
+
+//---------- the cells the code under test relies on, reduced to the fields it uses (the pins and the timer are simulated by the tests)
+typedef struct { u32 Min, Max, Value; } RangedValue_t;
+typedef struct { RangedValue_t OutCoreClk_Hz; } MCU_Clocks_t;
+typedef struct { u32 Id; u32 Level; } IO_Pin_t;
+
+#define TIMER_MAX_COUNTDOWN 4
+typedef struct {
+  u32 fnCountDown[TIMER_MAX_COUNTDOWN];
+  u32 ctCountDown[TIMER_MAX_COUNTDOWN];
+  u32 OverflowPeriod_us;
+  u32 CountDown[TIMER_MAX_COUNTDOWN];
+  u32 Ticks;
+  u8 CountDownDone[TIMER_MAX_COUNTDOWN];
+} Timer_t;
+
+void IO_PinSetHigh(IO_Pin_t* Pin);
+void IO_PinSetLow(IO_Pin_t* Pin);
+s32 IO_PinGet(IO_Pin_t* Pin);
+u32 ConfigurePinAsOpenDrainPU(IO_Pin_t* P);
+void ArmTimerCountdown(Timer_t* Timer, u32 n, u32 ticks);
+void HookTimerCountdown(Timer_t* Timer, u32 n, u32 fn, u32 ct);
+u32 sq_SPI_MHW_MoveJob(u32 u); // SPI_MasterHW is not built here
+
+//---------- the engine headers under test
+#include "sebNVIC.h"
+#include "sebByteVein.h"
+#include "SebBitVein.h"
+#include "SebWideVein.h"
+#include "sebStuffsArtery.h"
+#include "SebProtothread.h"
+#include "SebPrintf.h"
+#include "I2C_MasterIO.h"
+#include "sebSequencer.h"
+
+#endif
@@ -13,16 +13,15 @@
 #include "sebEngine.h"
 //~~~~~~~~~~~~~~~~~~~~~ global variables to use differently~~~~~~~~~~~
 
-u32 Receive (u32 u, u32 DoAck);
-u32 Transmit (u32 u, u8 bValue);
-u32 GenerateStart (u32 u, u8 SlaveAdr);
-u32 ErrorRecovery (u32 u);
-u32 GenerateStop (u32 u);
+static u32 Receive (u32 u);
+static u32 Transmit (u32 u);
+static u32 GenerateStop (u32 u);
+static u32 I2C_MIO_Resume(u32 u);
 
 //u32 I2C_MasterIO_EXTI_IRQHandler(u32 u); // the event handler function for this I2Cslave, passing the context to it
 //~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
-u32 TimerCountdownWait(u32 u);
-u32 NopsWait(u32 u);
+static u32 TimerCountdownWait(u32 u);
+static u32 NopsWait(u32 u);
 //--------- this will become later global resources --------
 
 void NewI2C_MasterIO_SDA_SCL(I2C_MasterIO_t* M, IO_Pin_t* SDA, IO_Pin_t* SCL) {
@@ -45,6 +44,7 @@ void SetI2C_MasterIO_Timings(I2C_MasterIO_t* M, u32 MinBps, u32 MaxBps) {
   if(MinBps>400000) while(1); // max 400kbps
   if(MinBps==0) MinBps = 50000;  // if not defined, 50kHz minimum
   M->Bps.Min = MinBps; // 400khz
+  M->Bps.Max = MaxBps; // recorded only, the timings follow MinBps
   
   HalfClockPeriod_Hz = MinBps*2; // Timers runs at 1MHz max overflow speed. 500kHz = 2us
   
@@ -78,6 +78,7 @@ void SetI2C_MasterIO_Timings(I2C_MasterIO_t* M, u32 MinBps, u32 MaxBps) {
 
 void SetI2C_MasterIO_Format(I2C_MasterIO_t* M) {
   
+  (void)M; // nothing to set on IO pins
 }
 
 //=============================================
@@ -91,6 +92,20 @@ void ConfigureI2C_MasterIO(I2C_MasterIO_t* M) { // configure the HW registers
 
 void EnableI2C_MasterIO(I2C_MasterIO_t* M) {
   
+  (void)M; // the pins are enabled by ConfigureI2C_MasterIO()
+}
+
+void SetI2C_MasterIO_Background(I2C_MasterIO_t* M, FunctionalState Enable) {
+
+  if(Enable==DISABLE) {
+    M->Background = 0;
+    if(M->Timer) HookTimerCountdown(M->Timer, M->Cn, 0, 0); // back to polling CountDownDone
+    return;
+  };
+
+  if(M->fnWaitMethod!=TimerCountdownWait) while(1); // the background mode needs a timer fast enough (see SetI2C_MasterIO_Timings)
+  HookTimerCountdown(M->Timer, M->Cn, (u32)I2C_MIO_Resume, (u32)M);
+  M->Background = 1;
 }
 //==============================================
 //=============== These are the optional I2C spy mode to see what is happening on a bus.
@@ -120,67 +135,31 @@ static u32 WaitHere(u32 u, u32 delay) {
  
 
 
-// This function can be called upon any I2C bus error condition.
-static u32 ErrorRecovery (u32 u) 
-{
-  // blindly generate 9 stop bits to flush any stuck situation
-  // non-invasive, no side effects.
-  GenerateStop(u);
-  GenerateStop(u);
-  GenerateStop(u);
-  GenerateStop(u);
-  GenerateStop(u);
-  GenerateStop(u);
-  GenerateStop(u);
-  GenerateStop(u);	// flush the bus if it is stuck
-  return u;
-}
+// The bus timings are threads: in background mode, each wait arms the timer countdown and yields, the countdown hook resumes the thread
+// Otherwise the wait is blocking (WaitHere) and the threads run straight to their end
+#define I2C_MIO_WAIT(M, pt, delay) do { if((M)->Background) { ArmTimerCountdown((M)->Timer, (M)->Cn, (M)->WaitParam * (delay)); PT_YIELD(pt); }else{ WaitHere((u32)(M), delay); }; } while(0)
 
-static u32 GenerateStart (u32 u, u8 SlaveAdr) 
+static u32 Transmit(u32 u) // M->bValue goes out, M->AckFail gets the acknowledge
 {
   I2C_MasterIO_t* M = (I2C_MasterIO_t*) u;
-  M->SlaveAdr = SlaveAdr;
-  IO_PinSetHigh(M->SDA);//dir_I2C_SDA_IN;	// to check if I2C is idle... or stuck
-  WaitHere(u,1);
-  if(IO_PinGet(M->SDA)==0)	// Samsung decoder has I2C compatibility problems, it does not detect NACK in Read Mode...
-          ErrorRecovery(u);
-
-  // Seb this is bugged, it's not a start bit if SCL is low...  it's too short.
-  IO_PinSetHigh(M->SCL);//bit_I2C_SCL_HIGH;
-  WaitHere(u,1);					
-
-  // Fixed violation on Start hold time
-  IO_PinSetLow(M->SDA);//bit_I2C_SDA_LOW;
-  WaitHere(u,1);
-
-  IO_PinSetLow(M->SCL);//bit_I2C_SCL_LOW;
-  WaitHere(u,1);
 
-  return Transmit (u,SlaveAdr);				// Send the slave address
-}
-
-
-static u32 Transmit(u32 u, u8 bValue) 
-{
-  I2C_MasterIO_t* M = (I2C_MasterIO_t*) u;
-  u8 loop;
-
-  for (loop = 0; loop < 8; loop++) 
+  PT_BEGIN(&M->ptByte);
+  for (M->Bit = 0; M->Bit < 8; M->Bit++) 
   {
-      if (bValue & 0x80) {
+      if (M->bValue & 0x80) {
         IO_PinSetHigh(M->SDA);//bit_I2C_SDA_HIGH;
       }else{ 
         IO_PinSetLow(M->SDA);//bit_I2C_SDA_LOW;
       }
 
-      WaitHere(u,1);// Sept 17
+      I2C_MIO_WAIT(M, &M->ptByte, 1);// Sept 17
 //		dir_I2C_SDA_OUT;				// make sure SDA is configured as output (once DR initialised)
 
       IO_PinSetHigh(M->SCL);//bit_I2C_SCL_HIGH;
-      WaitHere(u,1);//1028
-      bValue <<= 1;
+      I2C_MIO_WAIT(M, &M->ptByte, 1);//1028
+      M->bValue <<= 1;
       IO_PinSetLow(M->SCL);//bit_I2C_SCL_LOW;
-      WaitHere(u,1);
+      I2C_MIO_WAIT(M, &M->ptByte, 1);
   }
 
   // Acknowledge Write
@@ -188,86 +167,83 @@ static u32 Transmit(u32 u, u8 bValue)
   // ack is READ to check if Slave is responding
 
   IO_PinSetHigh(M->SDA);//dir_I2C_SDA_IN;
-  WaitHere(u,1);
+  I2C_MIO_WAIT(M, &M->ptByte, 1);
   IO_PinSetHigh(M->SCL);//bit_I2C_SCL_HIGH;	// SCL = 1
-  WaitHere(u,1);					
+  I2C_MIO_WAIT(M, &M->ptByte, 1);
 
   // Here we could sense NACK and manage error info to calling function
   // for debug to find ACK bit as long scl pulse...
   // Error = bit_I2C_SDA; // 1 = Error, 0 = Ok
   IO_PinSetHigh(M->SCL);//bit_I2C_SCL_HIGH;	// SCL = 1
-  WaitHere(u,2);//	NOP;					
+  I2C_MIO_WAIT(M, &M->ptByte, 2);//	NOP;					
   M->AckFail |= IO_PinGet(M->SDA);	// Acknowledge bit
 
   IO_PinSetLow(M->SCL);//bit_I2C_SCL_LOW;	// SCL = 0
 
-  WaitHere(u,1);// Sept 17
-
-//-	SetSDAOutput();//dir_I2C_SDA_OUT;
+  I2C_MIO_WAIT(M, &M->ptByte, 1);// Sept 17
 
-//-	WaitHere(u,1);//	NOP;	add sept 17
-
-  return M->AckFail;
+  PT_END(&M->ptByte);
 }
 
 
-static u32 Receive (u32 u, u32 DoAck) 
+static u32 Receive (u32 u) // M->bValue comes in, acknowledged if M->DoAck
 { 
   I2C_MasterIO_t* M = (I2C_MasterIO_t*) u;
-  u8 bValue, loop;
 
-  bValue = 0;
+  PT_BEGIN(&M->ptByte);
+  M->bValue = 0;
   IO_PinSetHigh(M->SDA);//dir_I2C_SDA_IN; // make SDA as input before reading pin level
 
-  for (loop = 0; loop < 8; loop ++) 
+  for (M->Bit = 0; M->Bit < 8; M->Bit++) 
   {
-      WaitHere(u,1);// NOP; NOP;	// 1 us delay
+      I2C_MIO_WAIT(M, &M->ptByte, 1);// NOP; NOP;	// 1 us delay
 
       IO_PinSetHigh(M->SCL);//bit_I2C_SCL_HIGH;	// SCL = 1
-      WaitHere(u,2);					
-      bValue <<= 1;
+      I2C_MIO_WAIT(M, &M->ptByte, 2);
+      M->bValue <<= 1;
 
-      if(IO_PinGet(M->SDA)) bValue++;
+      if(IO_PinGet(M->SDA)) M->bValue++;
       IO_PinSetLow(M->SCL);//bit_I2C_SCL_LOW;	// SCL = 0
-      WaitHere(u,1);//1028
+      I2C_MIO_WAIT(M, &M->ptByte, 1);//1028
   }
 
 // Manage the ackknowledge bit
-  if(DoAck) {
+  if(M->DoAck) {
     IO_PinSetLow(M->SDA);//bit_I2C_SDA_LOW;
   }else{
     IO_PinSetHigh(M->SDA);//bit_I2C_SDA_HIGH;
   }
 
-//  SetSDAOutput();//dir_I2C_SDA_OUT; // make sure SDA is configured as output (once DR initialised)
-  WaitHere(u,1);	// enlarge the pulse to see it on the scope
+  I2C_MIO_WAIT(M, &M->ptByte, 1);	// enlarge the pulse to see it on the scope
   IO_PinSetHigh(M->SCL);//bit_I2C_SCL_HIGH;	// SCL = 1
-  WaitHere(u,1);
+  I2C_MIO_WAIT(M, &M->ptByte, 1);
   IO_PinSetLow(M->SCL);//bit_I2C_SCL_LOW;	// SCL = 0
 
-  WaitHere(u,1);//	NOP;	add sept 17
+  I2C_MIO_WAIT(M, &M->ptByte, 1);//	NOP;	add sept 17
 
-  if(!DoAck)	// If NACK, STOP will automatically follows (I2C spec)
-    GenerateStop(u);
+  if(!M->DoAck)	// If NACK, STOP will automatically follows (I2C spec)
+    PT_SPAWN(&M->ptByte, &M->ptStop, GenerateStop(u));
 
-  return bValue;
+  PT_END(&M->ptByte);
 }
 
 
 static u32 GenerateStop (u32 u) {
   
   I2C_MasterIO_t* M = (I2C_MasterIO_t*) u;
+
+  PT_BEGIN(&M->ptStop);
   IO_PinSetLow(M->SCL);//bit_I2C_SCL_LOW;
-  WaitHere(u,1);
+  I2C_MIO_WAIT(M, &M->ptStop, 1);
   IO_PinSetLow(M->SDA);//bit_I2C_SDA_LOW;
-  WaitHere(u,1);							// Extra to make sure delay is ok
+  I2C_MIO_WAIT(M, &M->ptStop, 1);							// Extra to make sure delay is ok
   
   IO_PinSetHigh(M->SCL);//bit_I2C_SCL_HIGH;
-  WaitHere(u,1);
+  I2C_MIO_WAIT(M, &M->ptStop, 1);
 
   IO_PinSetHigh(M->SDA);//bit_I2C_SDA_HIGH;
 //	WaitHere(u,1);
-  return 0;
+  PT_END(&M->ptStop);
 }
 
 
@@ -275,58 +251,118 @@ static u32 GenerateStop (u32 u) {
 // Here we try to have a job scheduler which more or less will look like a sequence of I2C communication happening...
 // This way we can prepare some job that could be done in background (when background I2C Master becomes possible with a BYTE HW cell
 
-static u32 I2C_MIO_Start(u32 u, u32 SlaveAdr) {
+#define I2C_MIO_JOB_START 0
+#define I2C_MIO_JOB_STOP 1
+#define I2C_MIO_JOB_MOVE 2
+
+static u32 I2C_MIO_JobThread(u32 u) {
 
   I2C_MasterIO_t* M = (I2C_MasterIO_t*) u;
 
-  M->AckFail = GenerateStart (u,SlaveAdr);				// Send the slave address
-  return 0; // no interrupt setup
-}
+  PT_BEGIN(&M->ptJob);
 
-// This is NEVER NEEDED unless error recovery is asked
-static u32 I2C_MIO_Stop(u32 u, u32 BitMask) { // This is used only in transmit mode (Adr.b0=0)
+  if(M->JobKind==I2C_MIO_JOB_START) {
 
-//  I2C_MasterIO_t* S = (I2C_MasterIO_t*) u;
-  GenerateStop(u);
-  WaitHere(u,1);
-  return 0; // no call back, next job right away
-}
+    IO_PinSetHigh(M->SDA);//dir_I2C_SDA_IN;	// to check if I2C is idle... or stuck
+    I2C_MIO_WAIT(M, &M->ptJob, 1);
+    if(IO_PinGet(M->SDA)==0)	// Samsung decoder has I2C compatibility problems, it does not detect NACK in Read Mode...
+      for(M->Flush=0;M->Flush<8;M->Flush++) // error recovery: blindly generate 8 stop bits to flush any stuck situation, non-invasive
+        PT_SPAWN(&M->ptJob, &M->ptStop, GenerateStop(u));
 
+    // Seb this is bugged, it's not a start bit if SCL is low...  it's too short.
+    IO_PinSetHigh(M->SCL);//bit_I2C_SCL_HIGH;
+    I2C_MIO_WAIT(M, &M->ptJob, 1);
 
-static u32 I2C_MIO_Move(u32 u, u32 Param1, u32 Param2, u32 Param3) { // Param1: Block adr, Param2: Block size byte, Param3: Ack when read or not
-  
-  I2C_MasterIO_t* S = (I2C_MasterIO_t*) u;
-  u8* pu8 = (u8*) Param1;
-  u16 bCount = (u16) Param2;
-  u8 MoreComing = Param3;
-  
-  // if the TX adr is null, no bytes to transmit, disable MOSI, and transmit dummy things instead
-  if(pu8==0) while(1); // not supported with no buffer pointer
-//  if(bCount==0) while(1); // not supported
+    // Fixed violation on Start hold time
+    IO_PinSetLow(M->SDA);//bit_I2C_SDA_LOW;
+    I2C_MIO_WAIT(M, &M->ptJob, 1);
 
-  if(S->SlaveAdr & 1) { // receiver mode
+    IO_PinSetLow(M->SCL);//bit_I2C_SCL_LOW;
+    I2C_MIO_WAIT(M, &M->ptJob, 1);
 
-    if((bCount==0)||(S->AckFail)) {
-      Receive(u,0);
+    M->bValue = M->SlaveAdr;
+    PT_SPAWN(&M->ptJob, &M->ptByte, Transmit(u)); // Send the slave address
+  }
+  else if(M->JobKind==I2C_MIO_JOB_STOP) {
+
+    PT_SPAWN(&M->ptJob, &M->ptStop, GenerateStop(u));
+    I2C_MIO_WAIT(M, &M->ptJob, 1);
+  }
+  else if(M->SlaveAdr & 1) { // receiver mode
+
+    if((M->bCount==0)||(M->AckFail)) {
+      M->DoAck = 0;
+      PT_SPAWN(&M->ptJob, &M->ptByte, Receive(u));
     }else
     {
       do{ // at least read one byte if ACK failed on slave address, to generate the STOP bit at right opportunity. If 0 bytes requested, will still read one of them
-          *pu8++ = Receive (u, MoreComing | bCount); // a STOP bit will be generated if no more packets and last byteCount :-)
-        } while(bCount--);
+          M->DoAck = (M->MoreComing | M->bCount)!=0; // a STOP bit will be generated if no more packets and last byteCount :-)
+          PT_SPAWN(&M->ptJob, &M->ptByte, Receive(u));
+          *M->pu8++ = M->bValue;
+        } while(M->bCount--);
     }
 
   }else{ // transmitter mode
 
-    while((S->AckFail==0)&& (bCount--)) { // for all bytes... if ack fail, skip the transmit part
-       S->AckFail |= Transmit (u, *pu8++);
+    while((M->AckFail==0)&& (M->bCount--)) { // for all bytes... if ack fail, skip the transmit part
+       M->bValue = *M->pu8++;
+       PT_SPAWN(&M->ptJob, &M->ptByte, Transmit(u));
     };
 
     // let's take care of the stop bit if last packet here for compactness
-    if(MoreComing==FALSE)
-      GenerateStop(u);
+    if(M->MoreComing==FALSE)
+      PT_SPAWN(&M->ptJob, &M->ptStop, GenerateStop(u));
   };
+
+  M->JobDone = 1;
+  PT_END(&M->ptJob);
+}
+
+static u32 I2C_MIO_RunJob(u32 u, u32 JobKind) {
+
+  I2C_MasterIO_t* M = (I2C_MasterIO_t*) u;
+
+  M->JobKind = JobKind;
+  M->JobDone = 0;
+  M->ptJob = 0;
+  return I2C_MIO_JobThread(u); // PT_YIELDED only in background mode: callback armed, the timer countdown hook will resume it
+}
+
+static u32 I2C_MIO_Resume(u32 u) { // the timer countdown hook, background mode
+
+  I2C_MasterIO_t* M = (I2C_MasterIO_t*) u;
+
+  if(I2C_MIO_JobThread(u)==PT_YIELDED) return 0; // the next wait is armed
+  return ResumeJobToDo((u32)M->SA); // the job is over, continue the sequence (as a DMA interrupt would)
+}
+
+static u32 I2C_MIO_Start(u32 u, u32 SlaveAdr) {
+
+  I2C_MasterIO_t* M = (I2C_MasterIO_t*) u;
+
+  M->SlaveAdr = SlaveAdr;
+  return I2C_MIO_RunJob(u, I2C_MIO_JOB_START);
+}
+
+// This is NEVER NEEDED unless error recovery is asked
+static u32 I2C_MIO_Stop(u32 u, u32 BitMask) { // This is used only in transmit mode (Adr.b0=0)
+
+  (void)BitMask; // a stop carries no data
+  return I2C_MIO_RunJob(u, I2C_MIO_JOB_STOP);
+}
+
+
+static u32 I2C_MIO_Move(u32 u, u32 Param1, u32 Param2, u32 Param3) { // Param1: Block adr, Param2: Block size byte, Param3: Ack when read or not
   
-  return 0; // no interrupt call back setup here
+  I2C_MasterIO_t* M = (I2C_MasterIO_t*) u;
+  
+  // if the TX adr is null, no bytes to transmit, disable MOSI, and transmit dummy things instead
+  if(Param1==0) while(1); // not supported with no buffer pointer
+
+  M->pu8 = (u8*) Param1;
+  M->bCount = (u16) Param2;
+  M->MoreComing = Param3;
+  return I2C_MIO_RunJob(u, I2C_MIO_JOB_MOVE);
 }
 
 
@@ -353,6 +389,7 @@ u32 sq_I2C_MIO_MoveJob(u32 u) {
 }
 
 u32 sq_I2C_MIO_DMA_Interrupt(u32 u) {
+  (void)u; // no DMA on the IO version
 //  u32* p = (u32*) u;
 //  DMA_Interrupt(p[0], (FunctionalState)p[1]);
   return 0;
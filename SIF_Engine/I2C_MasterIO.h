@@ -35,6 +35,19 @@ typedef struct {
   u8 SlaveAdr; // the 8 bit slave address which we are using from the start command. (tells if read or write operation on going)
   u8 AckFail : 1;
   u8 JobDone : 1;
+  u8 Background : 1; // the bus waits yield, the timer countdown resumes the job
+//---- the job thread: resume points and what must survive a yield
+  PT_t ptJob;
+  PT_t ptByte; // Transmit(), Receive()
+  PT_t ptStop; // GenerateStop()
+  u8 JobKind;
+  u8* pu8;
+  u16 bCount;
+  u8 MoreComing;
+  u8 DoAck;
+  u8 bValue; // the byte going out or coming in
+  u8 Bit;
+  u8 Flush; // error recovery stop bits
   
 } I2C_MasterIO_t;
 //----
@@ -43,6 +56,9 @@ void SetI2C_MasterIO_Timings( I2C_MasterIO_t* M, u32 MinBps, u32 MaxBps);
 void SetI2C_MasterIO_Format( I2C_MasterIO_t* M );
 void ConfigureI2C_MasterIO(I2C_MasterIO_t* M);
 void EnableI2C_MasterIO(I2C_MasterIO_t* M);
+// Background mode (needs the timer countdown wait method): each job returns with its callback armed, the timer interrupt runs the bits and then the next job
+// The last job is over when SA->FlagEmptied and JobDone are both set
+void SetI2C_MasterIO_Background(I2C_MasterIO_t* M, FunctionalState Enable);
 //----
 u32 sq_I2C_MIO_StartJob(u32 u);
 u32 sq_I2C_MIO_StopJob(u32 u);
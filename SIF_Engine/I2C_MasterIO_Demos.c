@@ -60,3 +60,43 @@ void I2C_MasterIO_Test(void) {
   };
 
 };
+
+//===================================================================
+// Same sequence in background mode: the CPU is free while the bits go out, the timer interrupt runs the bus and then the next job
+void I2C_MasterIO_BackgroundTest(void) {
+
+  MCUInitClocks();
+
+  Timer6.Clocks = &MCU_Clocks;
+  NewTimer(&Timer6, TIM6);
+  SetTimerTimings_us(&Timer6, 4);
+  ConfigureTimer(&Timer6);
+  gMIO.Timer = &Timer6;
+  gMIO.Cn = 0; // use Countdown[0]
+
+  gMIO.Clocks = &MCU_Clocks;
+  NewI2C_MasterIO_SDA_SCL(&gMIO, NewIO_Pin(&MIO_SDA,PH7), NewIO_Pin(&MIO_SCL,PH8) );
+  SetI2C_MasterIO_Timings(&gMIO, 100000, 400000 );
+  SetI2C_MasterIO_Format( &gMIO );
+
+  ConfigureI2C_MasterIO(&gMIO);
+  EnableI2C_MasterIO(&gMIO);
+  SetI2C_MasterIO_Background(&gMIO, ENABLE); // the countdown hook resumes the jobs
+  NVIC_TimersEnable(ENABLE);
+
+  //===============
+  StuffsArtery_t* P = &mySequence; // program
+  gMIO.SA = NewSA(P, (u32)&List[0], countof(List));  
+  
+  while(1) {  
+    
+    AddToSA(P, (u32) &I2C_StartWrite_LPS25H);
+    AddToSA(P, (u32) &I2C_Write_LPS25H);
+    AddToSA(P, (u32) &I2C_StartRead_LPS25H);
+    AddToSA(P, (u32) &I2C_Read_LPS25H);
+    StartJobToDoInBackground((u32)P); // returns after the first bit
+    
+    while((P->FlagEmptied==0)||(gMIO.JobDone==0)) // the last job is clipped before it runs
+      NOPs(1); // free for something else
+  };
+}
@@ -3,5 +3,6 @@
 #define _I2C_MASTER_IO_DEMOS_H_
 
 void I2C_MasterIO_Test(void);
+void I2C_MasterIO_BackgroundTest(void);
 
 #endif
@@ -104,7 +104,7 @@ void ConfigureI2C_SlaveIO(I2C_SlaveIO_t* S) {
   // for now we hook the corresponding IRQ to the IRQ handler for EXTI channels
   // putting a non zero hook is needed to activate the EXTI interrupt enable going to NVIC channel
   HookEXTIn(PinSDA & 0xF, (u32) I2C_SlaveIO_EXTI_IRQHandler , (u32)S); // this will move to EXTI cell later, it will activate the EXTI Interrupt enable, not the NVIC (later)
-  HookEXTIn(PinSCL & 0xF, (u32) (EXTI_PinShareSameNVIC(PinSDA,PinSCL)?(u32_fn_u32):(I2C_SlaveIO_EXTI_IRQHandler)), (u32)S); // shares the same IRQ handler, so don't call the same handler twice!
+  HookEXTIn(PinSCL & 0xF, (u32) I2C_SlaveIO_EXTI_IRQHandler, (u32)S); // on a shared channel, the demux skips SCL when the SDA call already cleared it
 // not needed if they share the same IRQ  fnEXTI_n_Hook_To(pinSCL & 0xF, (u32) I2C_SlaveIO_EXTI_IRQHandler, (u32)&gI2C_Slave); // this will move to EXTI cell later
 }
 
@@ -152,7 +152,7 @@ static u32 I2C_SlaveIO_EXTI_IRQHandler(u32 u) {
 
   S->I2C_Symbol = I2C_EventToSymbol[EventMask];
   if(S->fnSlaveScheme) I2C_SlaveIO_STMA_Run((u32)(&S->STMA));// DIRECT Here we only use state machine which we can disable by zeroing the fnSlaveScheme, we pass the state machine as parameter
-  if(S->fnSpyScheme)I2C_SlaveIO_SpyProcess(u); // DIRECT we pass the I2C_Slave pointer here for the spy
+  if(S->fnSpyScheme) S->fnSpyScheme(u); // DIRECT or deferred, we pass the I2C_Slave pointer here for the spy
 
   return 0;
 }
@@ -180,6 +180,30 @@ u32 SpyI2C_SlaveIO(I2C_SlaveIO_t* u) {
   return 0;
 }
 
+// The edge interrupt only queues the symbol, the decoding and formatting run from PendSV
+// The edge interrupt posts the job unless it is already posted: the job drains the vein all, so one post per batch of symbols
+// A post refused by a full deferred artery is counted in SpyJobLost and tried again at the next symbol (a vein hook would not fire again)
+static u32 I2C_SlaveIO_SpyDefer(u32 u);
+static u32 I2C_SlaveIO_SpyJob(u32 u);
+
+u32 DeferSpyI2C_SlaveIO(I2C_SlaveIO_t* S, ByteVein_t* Symbols, u32 Job) {
+
+  OneJob_t* J = (OneJob_t*) Job;
+  if((Symbols==0)||(Symbols->SPSC==0)) while(1); // the edge interrupt and PendSV need a NewBV_SPSC() vein
+  if(J==0) while(1); // create the job in RAM first!
+
+  J->fnJob = I2C_SlaveIO_SpyJob;
+  J->ctJobs[0] = (u32)S;
+  SetBV_OverflowPolicy(Symbols, BV_DROP_NEWEST); // never hang the bus interrupt, the lost symbols are counted in bDropped
+  S->SpyJob = Job;
+  S->SpyJobPosted = 0;
+  S->SpyJobLost = 0;
+  S->Symbols = Symbols;
+  S->I2C_BitCounter = 0;
+  S->fnSpyScheme = I2C_SlaveIO_SpyDefer;
+  return 0;
+}
+
 u32 UnSpyI2C_SlaveIO(I2C_SlaveIO_t* u) {
 
   u->fnSpyScheme = 0;
@@ -187,12 +211,10 @@ u32 UnSpyI2C_SlaveIO(I2C_SlaveIO_t* u) {
 }
 
 const u8 HexToAscii[] = {  '0','1','2','3','4','5','6','7','8','9','A','B','C','D','E','F' };
+static const u8 SpyStopLF[] = { 'P', 0x0A }; // stop bit, and a LF to format line by line
 
-static u32 I2C_SlaveIO_SpyProcess(u32 u) {
+static u32 I2C_SlaveIO_SpySymbol(I2C_SlaveIO_t* S, I2C_Symbols I2C_Symbol) {
 
-  I2C_SlaveIO_t* S = (I2C_SlaveIO_t*) u;
-  I2C_Symbols I2C_Symbol = S->I2C_Symbol;
-  
   if(S->BV==0) while(1);// you forgot to point to a BV global structure... pointer is null.
 
   switch(I2C_Symbol) {
@@ -202,8 +224,7 @@ static u32 I2C_SlaveIO_SpyProcess(u32 u) {
     S->I2C_Nibble = 0;
     return 0;
   case I2C_Stop:     // SDA goes high while SCL remains high
-    AddToBV(S->BV, 'P'); 
-    AddToBV(S->BV, 0x0A);    // add a LF to format line by line//    I2C_Slave->I2C_String[I2C_Slave->I2C_String_Index++] = 'P';
+    GlueBV_UpN(S->BV, (u32)SpyStopLF, sizeof(SpyStopLF));    // add a LF to format line by line//    I2C_Slave->I2C_String[I2C_Slave->I2C_String_Index++] = 'P';
     return 0;
   case I2C_SDA1SCLRise:  // SCL went high and SDA is high
     S->I2C_Nibble|=1;
@@ -600,3 +621,33 @@ static u32 I2C_SlaveIO_sm_Transmit8BitData(u32 u) {
   return thisSx;
 }
 
+static u32 I2C_SlaveIO_SpyProcess(u32 u) {
+
+  I2C_SlaveIO_t* S = (I2C_SlaveIO_t*) u;
+  return I2C_SlaveIO_SpySymbol(S, S->I2C_Symbol);
+}
+
+static u32 I2C_SlaveIO_SpyDefer(u32 u) { // top half: a few cycles in the edge interrupt
+
+  I2C_SlaveIO_t* S = (I2C_SlaveIO_t*) u;
+  S->Symbols->In = S->I2C_Symbol;
+  GlueBV_SPSC(S->Symbols);
+  if(S->SpyJobPosted==0) {
+    if(DeferJob(S->SpyJob))
+      S->SpyJobPosted = 1;
+    else
+      S->SpyJobLost++; // the deferred artery is full, the next symbol posts it
+  };
+  return 0;
+}
+
+static u32 I2C_SlaveIO_SpyJob(u32 u) { // bottom half, from PendSV: ctJobs[0] is the I2C_SlaveIO_t*
+
+  I2C_SlaveIO_t* S = (I2C_SlaveIO_t*) ((u32*)u)[0];
+  S->SpyJobPosted = 0; // before draining: a symbol glued from now on is seen by the loop, or posts the job again
+  while(GetBV_SPSC_Count(S->Symbols)) {
+    ClipBV_SPSC(S->Symbols);
+    I2C_SlaveIO_SpySymbol(S, (I2C_Symbols)S->Symbols->Out);
+  };
+  return 0; // run to completion
+}
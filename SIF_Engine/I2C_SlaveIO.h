@@ -87,6 +87,10 @@ typedef struct {
   
 //===--- spy members: (can be indirect later)
   ByteVein_t* BV; // this is where we will output the strings decoded by the spy.
+  ByteVein_t* Symbols; // deferred spy: the symbols seen by the edge interrupt, decoded later by a PendSV job (NewBV_SPSC)
+  u32 SpyJob; // deferred spy: the OneJob_t* posted by the edge interrupt
+  u32 SpyJobLost; // deferred spy: posts refused by a full deferred artery (retried at the next symbol)
+  volatile u8 SpyJobPosted; // deferred spy: set by the edge interrupt, cleared by the job. Not a bitfield, the two contexts write it
   u8 I2C_Nibble;
   u8 I2C_BitCounter; 
 
@@ -119,5 +123,6 @@ void EnableI2C_SlaveIO(I2C_SlaveIO_t* S);
 
 u32 SpyI2C_SlaveIO(I2C_SlaveIO_t* u);
 u32 UnSpyI2C_SlaveIO(I2C_SlaveIO_t* u);
+u32 DeferSpyI2C_SlaveIO(I2C_SlaveIO_t* S, ByteVein_t* Symbols, u32 Job); // the spy decoding runs from PendSV (see DeferJob), Job: a OneJob_t for this slave
 
 #endif
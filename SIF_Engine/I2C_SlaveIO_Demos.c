@@ -10,6 +10,13 @@ static u8 RxBuf[10];
 static I2C_SlaveIO_t gI2C_Slave; // can be multiple of them, as array (we pass by pointer)
 static IO_Pin_t I2C_SlaveIO_SDA; // for fast pin access using bitbanding area (we will use a fake HW registers which will check if all pins are not colliding)
 static IO_Pin_t I2C_SlaveIO_SCL; // for fast pin access using bitbanding area
+#ifdef SebPendSV // the spy decoding runs from PendSV, the edge interrupt only queues the symbols
+static u8 I2C_SpySymbols[64];
+static ByteVein_t I2C_SpySymbolsBV;
+static u32 I2C_SpyDeferredTable[4];
+static StuffsArtery_t I2C_SpyDeferred;
+static OneJob_t I2C_SpyJob;
+#endif
 // we have to cleanup the Architect function for the fPin
 
 
@@ -22,7 +29,13 @@ void TestI2C_SlaveIO(void) {
   SetI2C_SlaveIO_Format(&gI2C_Slave);
   EmulateMemoryI2C_SlaveIO(&gI2C_Slave, (u8*)I2C_SlaveAdresses, countof(I2C_SlaveAdresses), I2C_SlaveMemory, countof(I2C_SlaveMemory));
   ConfigureI2C_SlaveIO(&gI2C_Slave);
+#ifdef SebPendSV
+  NewNVIC_Deferred((u32)NewSA_MPSC(&I2C_SpyDeferred, (u32)I2C_SpyDeferredTable, countof(I2C_SpyDeferredTable)));
+  NewBV_SPSC(&I2C_SpySymbolsBV, (u32)I2C_SpySymbols, sizeof(I2C_SpySymbols));
+  DeferSpyI2C_SlaveIO(&gI2C_Slave, &I2C_SpySymbolsBV, (u32)&I2C_SpyJob); // gI2C_Slave.SpyJobLost counts the posts refused
+#else
   SpyI2C_SlaveIO(&gI2C_Slave); // this is to go to spy code as well
+#endif
   EnableI2C_SlaveIO(&gI2C_Slave);
   
 //  u32 (*fnBusFree)(u32); // the I2C bus is free (stop bit occured), this can be hooked to run some action (like turn off this slave, do something, turn it back on)
@@ -85,27 +85,35 @@ u32 LCD_NHD16x2SendByte(u32 u, u8 byte, u8 IsCommand)
   // then, if we use a HW SPI, the jobs will accumulate and be processed in background without blocking later on.
   NHD_LCD16x2_t* L = (NHD_LCD16x2_t*) u;
   
+  // replayed: re-armed before the jobs are updated in place, as ReplaySA() does. Still running, the byte is refused and nothing is touched
+  if(L->SA->ReplayCount && (RearmSA_Replay(L->SA)==0))
+    return 0;
+  
   L->Byte = byte;// to have a physical address
   
-  L->Jobs[0] = (OneJob_t) { sq_SPI_MIO_StartJob, {(u32)L->MIO, 1} };
   if(IsCommand) { // Command
     L->Jobs[1] = (OneJob_t) { sq_PinSetLowJob, {(u32) L->RS } };
   }else{          // Data
     L->Jobs[1] = (OneJob_t) { sq_PinSetHighJob, {(u32) L->RS } };
   };
-  L->Jobs[2] = (OneJob_t) { sq_SPI_MIO_MoveJob,  {(u32)L->MIO, (u32)&L->Byte, 0, 1} };
-  L->Jobs[3] = (OneJob_t) { sq_SPI_MIO_StopJob, {(u32)L->MIO, 1 }};
-
-  AddToSA(L->SA, (u32) &L->Jobs[0]);
-  AddToSA(L->SA, (u32) &L->Jobs[1]);
-  AddToSA(L->SA, (u32) &L->Jobs[2]);
-  AddToSA(L->SA, (u32) &L->Jobs[3]);
+  
+  if(L->SA->ReplayCount==0) { // the first time: the sequence is recorded, then only replayed (the jobs are updated in place)
+    L->Jobs[0] = (OneJob_t) { sq_SPI_MIO_StartJob, {(u32)L->MIO, 1} };
+    L->Jobs[2] = (OneJob_t) { sq_SPI_MIO_MoveJob,  {(u32)L->MIO, (u32)&L->Byte, 0, 1} };
+    L->Jobs[3] = (OneJob_t) { sq_SPI_MIO_StopJob, {(u32)L->MIO, 1 }};
+
+    AddToSA(L->SA, (u32) &L->Jobs[0]);
+    AddToSA(L->SA, (u32) &L->Jobs[1]);
+    AddToSA(L->SA, (u32) &L->Jobs[2]);
+    AddToSA(L->SA, (u32) &L->Jobs[3]);
+    RecordSA_Replay(L->SA);
+  };
     
   StartJobToDoInForeground((u32)L->SA); // for now... will become background possibly later
   while(L->SA->FlagEmptied==0);
   NOPs(1);
   
-  return 0;
+  return 1; // sent
 }
 
 u32 NHD_LCD16x2_UpdateDisplay(NHD_LCD16x2_t* L) {
@@ -0,0 +1,34 @@
+#ifndef _QUEUE_BENCH_DEMOS_H_
+#define _QUEUE_BENCH_DEMOS_H_
+
+// On target throughput and latency of the vein/artery primitives, using the DWT cycle counter
+// For each primitive, workload and size: ops/s, ns/op (average) and p50/p99/max cycles (per call)
+// The check mode compares the average against a recorded baseline and counts the regressions
+
+#define QB_PRIMITIVES 4 // ByteVein, ByteVein power of two, StuffsArtery, StuffsArtery power of two
+#define QB_WORKLOADS 3 // FIFO, LIFO, Deque
+#define QB_SIZES 3 // 16, 64, 256 items
+#define QB_TOLERANCE_PERCENT 10 // slower than the baseline by more than this is a regression
+
+typedef struct {
+  u32 Ops_per_s;
+  u32 ns_per_op;
+  u16 cy10_per_op; // average in 1/10 cycle, the value to record in the baseline
+  u16 p50_cy;
+  u16 p99_cy;
+  u16 Max_cy;
+} QB_Result_t;
+
+extern QB_Result_t QB_Results[QB_PRIMITIVES][QB_WORKLOADS][QB_SIZES];
+
+extern u32 QB_Dispatch_cy10[5];
+
+u32 Queue_BenchRun(u32 Check); // returns the number of regressions (if Check)
+void Queue_Bench(void);
+void Sequencer_Bench(void); // job dispatch overhead, plain versus priority lanes versus job program
+void Coalesce_Bench(void); // back to back moves, as queued versus merged by CoalesceSA_Moves()
+// simulated on a PC: the bus utilization of the round robin dispatcher (HostTests/BusDispatcher_Tests.c), the EDF miss rate (EDF_Tests.c)
+void Deferred_Bench(void); // interrupt time and completion time, work done in the hook versus deferred to PendSV
+void NVIC_Bench(void); // vector body cycles, full dispatch versus NVIC_BARE and NVIC_DIRECT
+
+#endif
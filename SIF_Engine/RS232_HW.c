@@ -13,7 +13,10 @@ static u32 RS232_UARTs_IRQHandler(u32 u) {
     // WHAT IF BV IS NOT ASSIGNED?
     if(RS->BV_RX==0)      while(1);
     // byte received, prep to place in BV_RX
-    AddToBV(RS->BV_RX, RS->USART->DR); // add this byte to the head of this data (fresh is head), and possibly trigger a use of it, we can't delay it!
+    if(RS->BV_RX->SPSC) // the main loop reads it without masking interrupts
+      AddToBV_SPSC(RS->BV_RX, RS->USART->DR);
+    else
+      AddToBV(RS->BV_RX, RS->USART->DR); // add this byte to the head of this data (fresh is head), and possibly trigger a use of it, we can't delay it!
   };
   
   // we should also add the error management here
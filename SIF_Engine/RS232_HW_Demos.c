@@ -1,5 +1,6 @@
 
 #include "SebEngine.h"
+#include <string.h>
 
 
 // Here is an example of using RS232 cell
@@ -24,7 +25,7 @@ void TestSebUART(void) {
   // we have also to initialize the BV_TX and BV_RX at higher level...
   // initialize the BV first!
   NewBV(&BV_TX, (u32)Rs232TXBuf, sizeof(Rs232TXBuf));
-  NewBV(&BV_RX, (u32)Rs232RXBuf, sizeof(Rs232RXBuf));
+  NewBV_SPSC(&BV_RX, (u32)Rs232RXBuf, sizeof(Rs232RXBuf)); // RX interrupt fills, main loop reads, no interrupt masking
 
   SetRs232BVs( &Rs232, &BV_TX, &BV_RX);
   
@@ -42,11 +43,7 @@ void TestSebUART(void) {
   };
 
   __disable_irq();//__set_PRIMASK(tmp | 1);  
-  pu8 = (char*)Hello2;
-  while(*pu8) {// empty string check first
-    AddToBV(Rs232.BV_TX, *pu8); // add to head (new)
-    pu8++;
-  };
+  GlueBV_UpN(Rs232.BV_TX, (u32)Hello2, strlen(Hello2)); // the whole string in one go, TX interrupt armed once
   __enable_irq();//__set_PRIMASK(tmp);
   
   while(1);
@@ -185,7 +185,7 @@ void ConfigureSPI_MasterHW(SPI_MasterHW_t* S) {
   // Wire NVIC Interrupts for DMA TX only (it is the only way to get interrupt when all the bits have been shifted in or out. RX is too early. BUSY might even be better!
 
   // We need to initialize the hooks for DMA_RX...
-  HookIRQ_PPP((u32)S->DMA_RX->Stream, (u32)JobToDo, (u32)S->SA); // From DMA Stream, place the hooks
+  HookIRQ_PPP((u32)S->DMA_RX->Stream, (u32)ResumeJobToDo, (u32)S->SA); // From DMA Stream, place the hooks (JobToDo, or the bus dispatcher)
   
   // interrupt configuration, only for TX side.... RX is driven by TX DMA which controls the clock pulses generation
   NVIC_InitStructure.NVIC_IRQChannel = S->DMA_TX->Stream_IRQn;
@@ -446,6 +446,34 @@ static u32 SPI_Move(u32 u, u32 Param1, u32 Param2, u32 Param3) {
   return 1; // callback armed!
 }
 
+// Zero copy: the DMAs move directly from the TX vein tail and into the RX vein head (contiguous regions only)
+static u32 SPI_MoveBV(u32 u, u32 TX, u32 RX, u32 Max) {
+  
+  ByteVein_t* BV_TX = (ByteVein_t*) TX;
+  ByteVein_t* BV_RX = (ByteVein_t*) RX;
+  u32 n = Max;
+  
+  if(BV_TX) n = Min(n, ReserveBV_Down(BV_TX));
+  if(BV_RX) n = Min(n, ReserveBV_Up(BV_RX));
+  if((BV_TX==0)||(BV_RX==0)) n = Min(n, sizeof(Dummy)); // the other side uses the dummy buffer
+  
+  if(n==0) return 0; // nothing to move, next job right away
+  
+  // the DMA will count down from n
+  if(BV_TX) BV_TX->bDownReserved = n;
+  if(BV_RX) BV_RX->bUpReserved = n;
+  return SPI_Move(u, (BV_TX) ? BV_TX->pbDown : 0, (BV_RX) ? BV_RX->pbUpReserved : 0, n);
+}
+
+static u32 SPI_CommitBV(u32 u, u32 TX, u32 RX) {
+  
+  SPI_MasterHW_t* S = (SPI_MasterHW_t*) u;
+  
+  if(TX) CommitBV_DownFromDMA((ByteVein_t*) TX, S->DMA_TX->Stream);
+  if(RX) CommitBV_UpFromDMA((ByteVein_t*) RX, S->DMA_RX->Stream);
+  return 0; // no call back, next job right away
+}
+
 //==============================================================
 // SEQUENCER COMPATIBLE FUNCTION START
 // This is the single instruction process
@@ -467,6 +495,16 @@ u32 sq_SPI_MHW_MoveJob(u32 u){
   return SPI_Move(p[0], p[1], p[2], p[3]);
 }
 
+u32 sq_SPI_MHW_MoveBVJob(u32 u){
+  u32* p = (u32*) u;
+  return SPI_MoveBV(p[0], p[1], p[2], p[3]);
+}
+
+u32 sq_SPI_MHW_CommitBVJob(u32 u){
+  u32* p = (u32*) u;
+  return SPI_CommitBV(p[0], p[1], p[2]);
+}
+
 u32 sq_SPI_MHW_DMA_Interrupt(u32 u){
   u32* p = (u32*) u;
   DMA_Interrupt(p[0], (FunctionalState)p[1]);
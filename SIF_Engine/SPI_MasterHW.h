@@ -43,6 +43,8 @@ void ConfigureSPI_MasterHW(SPI_MasterHW_t* S);
 u32 sq_SPI_MHW_StartJob(u32 u); // SPI_MasterHW_t* and bitmask for NSS to go low
 u32 sq_SPI_MHW_StopJob(u32 u); // same as start, bitmask which NSS will go high.
 u32 sq_SPI_MHW_MoveJob(u32 u); // SPI_MasterHW_t* and RX_Adr, TX_Adr, sizeof (4 parameters needed)
+u32 sq_SPI_MHW_MoveBVJob(u32 u); // SPI_MasterHW_t*, ByteVein_t* to send from (or 0), ByteVein_t* to receive in (or 0), max bytes
+u32 sq_SPI_MHW_CommitBVJob(u32 u); // same first 3 parameters, accounts what the DMAs moved. Queue it right after the move job
 u32 sq_SPI_MHW_DMA_Interrupt(u32 u);
 
 #endif
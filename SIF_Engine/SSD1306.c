@@ -221,6 +221,27 @@ const u8 FrameWrite = 0x40;
 const OneJob_t WriteSSD1306FrameCmd =   { sq_I2C_MIO_MoveJob,  (u32)&gMIO, (u32)&FrameWrite, 1, 1 }; // no more coming
 OneJob_t WriteSSD1306Frame =      { sq_I2C_MIO_MoveJob,  (u32)&gMIO, (u32)&SSD.Frame[0], 128, 0 }; // no more coming
 
+// The whole frame as one job program: for each of the 8 pages, set the page and column addresses, then send the 128 bytes
+static const u8 SSD1306PageCmds[8][2] = { {0,0xB0}, {0,0xB1}, {0,0xB2}, {0,0xB3}, {0,0xB4}, {0,0xB5}, {0,0xB6}, {0,0xB7} }; // same as SSD1306_SendCommand()
+static const u8 SSD1306ColumnHiCmd[2] = { 0, 0x80|0x10 };
+static const u8 SSD1306ColumnLoCmd[2] = { 0, 0x80|0x00 };
+
+static const u32 SSD1306FrameProgram[] = {
+  JP_LOOP(8),
+    JP_CALL(sq_I2C_MIO_StartJob, 2), (u32)&gMIO, 0x78,
+    JP_CALL_STRIDE(sq_I2C_MIO_MoveJob, 4, 1, sizeof(SSD1306PageCmds[0])), (u32)&gMIO, (u32)&SSD1306PageCmds[0][0], 2, 0,
+    JP_CALL(sq_I2C_MIO_StartJob, 2), (u32)&gMIO, 0x78,
+    JP_CALL(sq_I2C_MIO_MoveJob, 4), (u32)&gMIO, (u32)SSD1306ColumnHiCmd, 2, 0,
+    JP_CALL(sq_I2C_MIO_StartJob, 2), (u32)&gMIO, 0x78,
+    JP_CALL(sq_I2C_MIO_MoveJob, 4), (u32)&gMIO, (u32)SSD1306ColumnLoCmd, 2, 0,
+    JP_CALL(sq_I2C_MIO_StartJob, 2), (u32)&gMIO, 0x78,
+    JP_CALL(sq_I2C_MIO_MoveJob, 4), (u32)&gMIO, (u32)&FrameWrite, 1, 1,
+    JP_CALL_STRIDE(sq_I2C_MIO_MoveJob, 4, 1, 128), (u32)&gMIO, (u32)&SSD.Frame[0], 128, 0,
+  JP_ENDLOOP,
+  JP_END
+};
+static JobProgram_t SSD1306Frame;
+
 void SSD1306sendFramebuffer(SSD1306_128x64x1_t* S) {
 
 //    SSD1306_SendCommand(S, 0x20);
@@ -235,18 +256,10 @@ void SSD1306sendFramebuffer(SSD1306_128x64x1_t* S) {
 //    SSD1306_SendCommand(S, 0x07);
 
   
-  for(u8 i=0;i<8;i++) {
-  
-    Set_Page_Address(i);
-    Set_Column_Address(0);
-    WriteSSD1306Frame.ctJobs[1] = (u32) &SSD.Frame[i*128];
-    AddToSA(S->I2C->SA, (u32) &StartWriteSSD1306);  
-    AddToSA(S->I2C->SA, (u32) &WriteSSD1306FrameCmd);
-    AddToSA(S->I2C->SA, (u32) &WriteSSD1306Frame);
-    StartJobToDoInForeground((u32)S->I2C->SA);
-    while(S->I2C->SA->FlagEmptied==0);
-    NOPs(1);     
-  };
+  AddProgramToSA(S->I2C->SA, &SSD1306Frame, SSD1306FrameProgram); // one job instead of 8 x 9
+  StartJobToDoInForeground((u32)S->I2C->SA);
+  while(S->I2C->SA->FlagEmptied==0);
+  NOPs(1);     
 // finished!
 
 }
@@ -0,0 +1,161 @@
+
+#include "sebEngine.h"
+
+u32 HookBitV_NoLongerEmpty(BitVein_t* BiV, u32 (*fn)(u32), u32 ct) {
+
+  BiV->ctNoLongerEmpty = ct;
+  BiV->fnNoLongerEmpty = fn;
+  return 0;
+}
+
+u32 HookBitV_Emptied(BitVein_t* BiV, u32 (*fn)(u32), u32 ct) {
+
+  BiV->ctEmptied = ct;
+  BiV->fnEmptied = fn;
+  return 0;
+}
+
+//==========================================================
+// A field of n bits at bit position p: it spans at most 2 words, the second one can be the first of the table (rollover)
+static void BitV_Write(BitVein_t* BiV, u32 p, u32 Bits, u32 n) {
+
+  u32 w = p >> 5;
+  u32 s = p & 31;
+  u32 Mask = (n==32) ? 0xFFFFFFFF : ((1UL << n) - 1);
+
+  Bits &= Mask;
+  BiV->Words[w] = (BiV->Words[w] & ~(Mask << s)) | (Bits << s);
+  if((s + n)>32) { // the rest goes in the next word
+    w++;
+    if((w<<5)>=BiV->bCountLimit) // rollover
+      w = 0;
+    BiV->Words[w] = (BiV->Words[w] & ~(Mask >> (32 - s))) | (Bits >> (32 - s));
+  };
+}
+
+static u32 BitV_Read(BitVein_t* BiV, u32 p, u32 n) {
+
+  u32 w = p >> 5;
+  u32 s = p & 31;
+  u32 Mask = (n==32) ? 0xFFFFFFFF : ((1UL << n) - 1);
+  u32 Bits = BiV->Words[w] >> s;
+
+  if((s + n)>32) { // the rest comes from the next word
+    w++;
+    if((w<<5)>=BiV->bCountLimit) // rollover
+      w = 0;
+    Bits |= BiV->Words[w] << (32 - s);
+  };
+  return Bits & Mask;
+}
+
+static void BitV_Glued(BitVein_t* BiV, u32 n) {
+
+  BiV->bCount += n;
+  if(BiV->bCount>BiV->bCountMax) BiV->bCountMax = BiV->bCount;// statistics
+
+  if(BiV->bCount==n) {
+    if(BiV->fnNoLongerEmpty) {// if the strand not empty, tell someone?
+      BiV->fnNoLongerEmpty(BiV->ctNoLongerEmpty);
+    }else{
+      BiV->FlagNoLongerEmpty = 1;
+    };
+  };
+}
+
+static void BitV_Clipped(BitVein_t* BiV, u32 n) {
+
+  BiV->bCount -= n;
+
+  if(BiV->bCount==0) {
+    if(BiV->fnEmptied) {// if the strand turns empty, tell someone?
+      BiV->fnEmptied(BiV->ctEmptied);
+    }else{
+      BiV->FlagEmptied = 1;
+    };
+  };
+}
+
+//==========================================================
+// StrandCreation
+u32 NewBitV(BitVein_t* BiV, u32 begin, s32 size) {
+
+  if((size<4)||(size & 3))
+    while(1); // no memory for it, or not a whole number of words?
+
+  BiV->Words = (u32*)begin;
+  BiV->bCountLimit = size * 8;
+  BiV->bCount = 0;
+  BiV->bDown = 0;
+  return begin;
+}
+
+//==========================================================
+// manage the right side
+u32 GlueBitV_Up(BitVein_t* BiV, u32 Bits, u32 n) {
+
+  u32 p;
+
+  if((n==0)||(n>32)) while(1); // error
+  if((BiV->bCount + n)>BiV->bCountLimit)
+    while(1); // too big! improve memory allocation
+
+  p = BiV->bDown + BiV->bCount; // one past the head
+  if(p>=BiV->bCountLimit) // rollover
+    p -= BiV->bCountLimit;
+
+  BitV_Write(BiV, p, Bits, n);
+  BiV->In = Bits;
+  BitV_Glued(BiV, n);
+  return p;
+}
+
+u32 ClipBitV_Up(BitVein_t* BiV, u32 n) {
+
+  u32 p;
+
+  if((n==0)||(n>32)) while(1); // error
+  if(n>BiV->bCount)
+    while(1); // error, not enough on this strand, check bCount first!
+
+  p = BiV->bDown + BiV->bCount - n;
+  if(p>=BiV->bCountLimit) // rollover
+    p -= BiV->bCountLimit;
+
+  BiV->Out = BitV_Read(BiV, p, n);
+  BitV_Clipped(BiV, n);
+  return BiV->Out;
+}
+
+//==========================================================
+// manage the left side
+u32 GlueBitV_Down(BitVein_t* BiV, u32 Bits, u32 n) {
+
+  if((n==0)||(n>32)) while(1); // error
+  if((BiV->bCount + n)>BiV->bCountLimit)
+    while(1); // too big! improve memory allocation
+
+  if(BiV->bDown<n) // rollover
+    BiV->bDown += BiV->bCountLimit;
+  BiV->bDown -= n;
+
+  BitV_Write(BiV, BiV->bDown, Bits, n);
+  BiV->In = Bits;
+  BitV_Glued(BiV, n);
+  return BiV->bDown;
+}
+
+u32 ClipBitV_Down(BitVein_t* BiV, u32 n) {
+
+  if((n==0)||(n>32)) while(1); // error
+  if(n>BiV->bCount)
+    while(1); // error, not enough on this strand, check bCount first!
+
+  BiV->Out = BitV_Read(BiV, BiV->bDown, n);
+  BiV->bDown += n;
+  if(BiV->bDown>=BiV->bCountLimit) // rollover
+    BiV->bDown -= BiV->bCountLimit;
+
+  BitV_Clipped(BiV, n);
+  return BiV->Out;
+}
@@ -0,0 +1,40 @@
+
+#ifndef _BIT_VEIN_H_
+#define _BIT_VEIN_H_
+
+// The bit version of the byte vein, as many as needed, bits packed in 32 bit words (any RAM, no bit-band alias)
+// Glue and clip 1 to 32 bits in one go: a bit stream (I2C, SPI, RFFE frames...) can be precomputed per field instead of per bit
+// Bit k of the value goes to position k from where it is glued, so a value glued then clipped from the same side comes back as is:
+// FIFO with GlueBitV_Up/ClipBitV_Down, the oldest bit is bit 0. For MSB first protocols, use __RBIT() or glue from the MSB side.
+// Plain C on a u32 table, no register access: it builds as is for host tests.
+// Once it becomes empty or no longer empty, a hook can be triggered, or a flag set (same as ByteVein_t)
+
+typedef struct {
+  u32* Words; // points to the assigned table
+  u32 bCountLimit; // size in bits (32 x words)
+  u32 bCount; // used bits
+  u32 bCountMax; // for stats
+  u32 bDown; // tail bit position (inclusive), the head is bDown + bCount (rollover)
+
+  u32 In; // the last bits glued
+  u32 Out; // the last bits clipped
+
+  u32 (*fnNoLongerEmpty)(u32);
+  u32 ctNoLongerEmpty;
+  u32 (*fnEmptied)(u32);
+  u32 ctEmptied;
+
+  u8 FlagNoLongerEmpty : 1;
+  u8 FlagEmptied : 1;
+
+} BitVein_t;
+
+u32 NewBitV(BitVein_t* BiV, u32 begin, s32 size); // size in bytes, multiple of 4
+u32 HookBitV_NoLongerEmpty(BitVein_t* BiV, u32 (*fn)(u32), u32 ct);
+u32 HookBitV_Emptied(BitVein_t* BiV, u32 (*fn)(u32), u32 ct);
+u32 GlueBitV_Up(BitVein_t* BiV, u32 Bits, u32 n); // n = 1..32
+u32 ClipBitV_Down(BitVein_t* BiV, u32 n); // returns the n oldest bits
+u32 GlueBitV_Down(BitVein_t* BiV, u32 Bits, u32 n);
+u32 ClipBitV_Up(BitVein_t* BiV, u32 n); // returns the n newest bits
+
+#endif
@@ -1,5 +1,6 @@
 
 #include "sebEngine.h"
+#include <string.h> // memcpy for the bulk span functions
 
 
 u32 HookBV_NoLongerEmpty(ByteVein_t* BV, u32 (*fn)(u32), u32 ct) {
@@ -16,6 +17,104 @@ u32 HookBV_Emptied(ByteVein_t* BV, u32 (*fn)(u32), u32 ct) {
   return 0;
 }
 
+u32 HookBV_Full(ByteVein_t* BV, u32 (*fn)(u32), u32 ct) { // a producer can throttle itself from here
+
+  BV->ctFull = ct;    
+  BV->fnFull = fn;
+  return 0;
+}
+
+u32 HookBV_NoLongerFull(ByteVein_t* BV, u32 (*fn)(u32), u32 ct) {
+
+  BV->ctNoLongerFull = ct;    
+  BV->fnNoLongerFull = fn;
+  return 0;
+}
+
+u32 HookBV_HighWater(ByteVein_t* BV, u32 Level, u32 (*fn)(u32), u32 ct) { // wake the consumer once a batch is ready
+
+  BV->ctHighWater = ct;
+  BV->fnHighWater = fn;
+  BV->bHighWater = Level;
+  return 0;
+}
+
+u32 HookBV_LowWater(ByteVein_t* BV, u32 Level, u32 (*fn)(u32), u32 ct) { // wake the producer once there is room for a batch
+
+  BV->ctLowWater = ct;
+  BV->fnLowWater = fn;
+  BV->bLowWater = Level;
+  return 0;
+}
+
+u32 SetBV_OverflowPolicy(ByteVein_t* BV, BV_OverflowPolicy_t Policy) {
+  
+  BV->Policy = Policy;
+  return 0;
+}
+
+// The strand is full and one more byte comes on side Up (or Down). Returns 0 if this new byte is to be dropped
+static u32 BV_Overflow(ByteVein_t* BV, u32 Up) {
+  
+  switch(BV->Policy) {
+  case BV_DROP_NEWEST:
+    BV->bDropped++;
+    return 0;
+  case BV_OVERWRITE_OLDEST: // the oldest byte is at the other end, make room by moving it (bCount stays at its limit)
+    BV->bDropped++;
+    if(Up) {
+      BV->pbDown++;
+      if(BV->pbDown>BV->pbHighest) // rollover if out of range
+        BV->pbDown = BV->pbLowest;
+    }else{
+      BV->pbUp--;
+      if(BV->pbUp<BV->pbLowest) // rollover if out of range
+        BV->pbUp = BV->pbHighest;
+    };
+    return 1;
+  default:
+    while(1); // too big! improve memory allocation, or choose an overflow policy
+  };
+}
+
+static void BV_Filled(ByteVein_t* BV) { // the strand just became full
+  
+  if(BV->fnFull) {// tell someone?
+    BV->fnFull(BV->ctFull);
+  }else{
+    BV->FlagFull = 1;
+  };
+}
+
+static void BV_Unfilled(ByteVein_t* BV) { // the strand is no longer full
+  
+  if(BV->fnNoLongerFull) {// tell someone?
+    BV->fnNoLongerFull(BV->ctNoLongerFull);
+  }else{
+    BV->FlagNoLongerFull = 1;
+  };
+}
+
+// The count moved from WasCount to bCount (by one or by a span): did it cross a watermark?
+static void BV_Watermarks(ByteVein_t* BV, u32 WasCount) {
+  
+  if(BV->bHighWater && (WasCount<BV->bHighWater) && (BV->bCount>=BV->bHighWater)) {
+    if(BV->fnHighWater) {// tell someone?
+      BV->fnHighWater(BV->ctHighWater);
+    }else{
+      BV->FlagHighWater = 1;
+    };
+  };
+  
+  if(BV->bLowWater && (WasCount>BV->bLowWater) && (BV->bCount<=BV->bLowWater)) {
+    if(BV->fnLowWater) {// tell someone?
+      BV->fnLowWater(BV->ctLowWater);
+    }else{
+      BV->FlagLowWater = 1;
+    };
+  };
+}
+
 //==========================================================
 // StrandCreation
 u32 NewBV(ByteVein_t* BV, u32 begin, s32 size) {
@@ -32,6 +131,7 @@ u32 NewBV(ByteVein_t* BV, u32 begin, s32 size) {
   { // valid SRAM space
     BV->bCountLimit = size; // we validate the strand size (action can occur)
     BV->bCount = 0;
+    BV->SPSC = 0; // a strand reused after NewBV_SPSC() is classic again, NewBV_SPSC() sets it after this
     return begin;
   }
   
@@ -43,6 +143,8 @@ u32 NewBV(ByteVein_t* BV, u32 begin, s32 size) {
 // manage the left side
 u32 GlueBV_Down(ByteVein_t* BV) {
 
+  u32 WasEmpty = (BV->bCount==0); // an overwrite at the limit never goes through empty, even with one byte of room
+
   if(BV->bCountLimit==0) while(1); // error
   
   if(BV->bCount==0) { // if strand empty: Create the first bit
@@ -50,7 +152,8 @@ u32 GlueBV_Down(ByteVein_t* BV) {
   }
   else {  // the strand exist, check fullness
     if(BV->bCount>=BV->bCountLimit)
-      while(1); // too big! improve memory allocation, flag, roll over etc... depends on scheme
+      if(BV_Overflow(BV, 0)==0)
+        return 0; // dropped
 
     // we create one more bit space on the left (lower memory)
     BV->pbDown--;
@@ -60,15 +163,20 @@ u32 GlueBV_Down(ByteVein_t* BV) {
   
   // write in memory and increase bit counter safely
   *(u8*)BV->pbDown = BV->In;
-  BV->bCount++;
-  if(BV->bCount>BV->bCountMax) BV->bCountMax = BV->bCount;// statistics
+  if(BV->bCount<BV->bCountLimit) { // not when overwriting
+    BV->bCount++;
+    if(BV->bCount>BV->bCountMax) BV->bCountMax = BV->bCount;// statistics
+    if(BV->bCount==BV->bCountLimit) BV_Filled(BV);
+    BV_Watermarks(BV, BV->bCount - 1);
+  };
   
-  if(BV->bCount==1)
+  if(WasEmpty) {
     if(BV->fnNoLongerEmpty) {// if the strand not empty, tell someone?
       BV->fnNoLongerEmpty(BV->ctNoLongerEmpty);
     }else{
       BV->FlagNoLongerEmpty = 1;
     };
+  };
 
 // one item was added, check if someone is ready to empty it
 //TBD  if(BV->fnOut) ((u32(*)(u32))BV->fnOut)(BV->ctOut);
@@ -85,18 +193,21 @@ u32 ClipBV_Down(ByteVein_t* BV) { // 0 or 1, returns the bit pointer
 
   BV->bCount--;  // strand not empty. Get the left bit first, reduce strand size
   BV->Out = *(u8*) BV->pbDown; // we create one more bit space on the left (lower memory)
+  if(BV->bCount==BV->bCountLimit-1) BV_Unfilled(BV);
   
   // point to the new left side
   BV->pbDown++;
   if(BV->pbDown>BV->pbHighest) // circular memory space bottom reached.
     BV->pbDown = BV->pbLowest; // jump to higher end
   
-  if(BV->bCount==0)
+  BV_Watermarks(BV, BV->bCount + 1);
+  if(BV->bCount==0) {
     if(BV->fnEmptied) {// if the strand turns empty, tell someone?
       BV->fnEmptied(BV->ctEmptied);
     }else{
       BV->FlagEmptied = 1;
     };
+  };
 
   // one item was added, check if someone is ready to empty it
 //TBD  if(BV->fnIn) ((u32(*)(u32))BV->fnIn)(BV->ctIn);
@@ -108,6 +219,8 @@ u32 ClipBV_Down(ByteVein_t* BV) { // 0 or 1, returns the bit pointer
 // manage the right side
 u32 GlueBV_Up(ByteVein_t* BV) {
 
+  u32 WasEmpty = (BV->bCount==0); // as in GlueBV_Down
+
   if(BV->bCountLimit==0) while(1); // error
   
   if(BV->bCount==0) { // if strand empty: Create the first bit
@@ -115,7 +228,8 @@ u32 GlueBV_Up(ByteVein_t* BV) {
   }
   else {  // the strand exist, check fullness
     if(BV->bCount>=BV->bCountLimit)
-      while(1); // too big! improve memory allocation, flag, roll over etc... depends on scheme
+      if(BV_Overflow(BV, 1)==0)
+        return 0; // dropped
 
     // we create one more bit space on the left (lower memory)
     BV->pbUp++;
@@ -125,15 +239,20 @@ u32 GlueBV_Up(ByteVein_t* BV) {
   
   // write in memory and increase bit counter safely
   *(u8*)BV->pbUp = BV->In;
-  BV->bCount++;
-  if(BV->bCount>BV->bCountMax) BV->bCountMax = BV->bCount;
+  if(BV->bCount<BV->bCountLimit) { // not when overwriting
+    BV->bCount++;
+    if(BV->bCount>BV->bCountMax) BV->bCountMax = BV->bCount;
+    if(BV->bCount==BV->bCountLimit) BV_Filled(BV);
+    BV_Watermarks(BV, BV->bCount - 1);
+  };
   
-  if(BV->bCount==1)
+  if(WasEmpty) {
     if(BV->fnNoLongerEmpty) { // if the strand not empty, tell someone?
       BV->fnNoLongerEmpty(BV->ctNoLongerEmpty); //!!! this can activate interrupt IRQ...
     }else{
       BV->FlagNoLongerEmpty = 1;
     };
+  };
 
   // one item was added, check if someone is ready to empty it
 //TBD  if(BV->fnOut) ((u32(*)(u32))BV->fnOut)(BV->ctOut);
@@ -150,18 +269,21 @@ u32 ClipBV_Up(ByteVein_t* BV) { // 0 or 1
 
   BV->bCount--;  // strand not empty. Get the left bit first, reduce strand size
   BV->Out = *(u8*) BV->pbUp; // we create one more bit space on the left (lower memory)
+  if(BV->bCount==BV->bCountLimit-1) BV_Unfilled(BV);
   
   // point to the new left side
   BV->pbUp--;
   if(BV->pbUp<BV->pbLowest) // circular memory space bottom reached.
     BV->pbUp = BV->pbHighest; // jump to higher end
 
-  if(BV->bCount==0)
+  BV_Watermarks(BV, BV->bCount + 1);
+  if(BV->bCount==0) {
     if(BV->fnEmptied) {// if the strand turns empty, tell someone?
       BV->fnEmptied(BV->ctEmptied);
     }else{
       BV->FlagEmptied = 1;
     };
+  };
 
   // one item was added, check if someone is ready to empty it
 //TBD  if(BV->fnIn) ((u32(*)(u32))BV->fnIn)(BV->ctIn);
@@ -197,6 +319,416 @@ u32 AddToBV(ByteVein_t* BV, u32 In) {
   return GlueBV_Up(BV);
 }
 
+//==========================================================
+// Bulk span: move a whole buffer in or out in at most 2 memcpy (before and after the rollover point)
+// The counter is updated once and the hooks are triggered at most once per call
+u32 GlueBV_UpN(ByteVein_t* BV, u32 Adr, u32 n) { // returns the number of bytes glued
+
+  u32 pbNext, Span, Excess;
+  u32 WasEmpty = (BV->bCount==0);
+  u32 WasFull = (BV->bCount==BV->bCountLimit);
+  u32 WasCount = BV->bCount;
+  
+  if(BV->bCountLimit==0) while(1); // error
+  if(n==0) return 0; // nothing to glue
+
+  if((BV->bCount + n)>BV->bCountLimit)
+    switch(BV->Policy) {
+    case BV_DROP_NEWEST: // glue what fits
+      BV->bDropped += BV->bCount + n - BV->bCountLimit;
+      n = BV->bCountLimit - BV->bCount;
+      if(n==0) return 0; // all dropped
+      break;
+    case BV_OVERWRITE_OLDEST: // only the newest bytes of the span can stay, then make room by moving the tail
+      if(n>BV->bCountLimit) {
+        BV->bDropped += n - BV->bCountLimit;
+        Adr += n - BV->bCountLimit;
+        n = BV->bCountLimit;
+      };
+      Excess = BV->bCount + n - BV->bCountLimit;
+      BV->bDropped += Excess;
+      BV->bCount -= Excess;
+      BV->pbDown += Excess;
+      if(BV->pbDown>BV->pbHighest) // rollover if out of range
+        BV->pbDown -= BV->bCountLimit;
+      break;
+    default:
+      while(1); // too big! improve memory allocation, or choose an overflow policy
+    };
+  
+  if(BV->bCount==0) { // if strand empty: the span starts on the arbitrary left side
+    pbNext = BV->pbDown = BV->pbLowest;
+  }else{
+    pbNext = BV->pbUp + 1;
+    if(pbNext>BV->pbHighest) // rollover if out of range
+      pbNext = BV->pbLowest;
+  };
+  
+  Span = BV->pbHighest - pbNext + 1; // room until the rollover
+  if(Span>n) Span = n;
+  memcpy((u8*)pbNext, (u8*)Adr, Span);
+  if(Span<n) { // the rest goes from the bottom
+    memcpy((u8*)BV->pbLowest, (u8*)(Adr + Span), n - Span);
+    BV->pbUp = BV->pbLowest + (n - Span) - 1;
+  }else{
+    BV->pbUp = pbNext + Span - 1;
+  };
+  
+  BV->In = ((u8*)Adr)[n-1]; // as if glued one by one
+  BV->bCount += n;
+  if(BV->bCount>BV->bCountMax) BV->bCountMax = BV->bCount;
+  
+  if(WasEmpty) {
+    if(BV->fnNoLongerEmpty) { // if the strand not empty, tell someone?
+      BV->fnNoLongerEmpty(BV->ctNoLongerEmpty); //!!! this can activate interrupt IRQ...
+    }else{
+      BV->FlagNoLongerEmpty = 1;
+    };
+  };
+  
+  if((BV->bCount==BV->bCountLimit)&&(WasFull==0)) BV_Filled(BV);
+  BV_Watermarks(BV, WasCount);
+  
+  return n;
+}
+
+u32 ClipBV_DownN(ByteVein_t* BV, u32 Adr, u32 n) { // returns the number of bytes clipped
+
+  u32 Span;
+  
+  if(n==0) return 0; // nothing to clip
+  
+  if(n>BV->bCount) // not enough in the strand, error
+    while(1); // error, check bCount first!
+
+  Span = BV->pbHighest - BV->pbDown + 1; // filled until the rollover
+  if(Span>n) Span = n;
+  memcpy((u8*)Adr, (u8*)BV->pbDown, Span);
+  if(Span<n) { // the rest comes from the bottom
+    memcpy((u8*)(Adr + Span), (u8*)BV->pbLowest, n - Span);
+    BV->pbDown = BV->pbLowest + (n - Span);
+  }else{
+    BV->pbDown += Span;
+    if(BV->pbDown>BV->pbHighest) // circular memory space top reached.
+      BV->pbDown = BV->pbLowest;
+  };
+  
+  BV->Out = ((u8*)Adr)[n-1]; // as if clipped one by one
+  if(BV->bCount==BV->bCountLimit) BV_Unfilled(BV);
+  BV->bCount -= n;
+  BV_Watermarks(BV, BV->bCount + n);
+  
+  if(BV->bCount==0) {
+    if(BV->fnEmptied) {// if the strand turns empty, tell someone?
+      BV->fnEmptied(BV->ctEmptied);
+    }else{
+      BV->FlagEmptied = 1;
+    };
+  };
+  
+  return n;
+}
+
 
 // reading the strand content: The strand does not kill the bits when cut!
 
+
+//==========================================================
+// Single producer / single consumer mode, for example UART RX interrupt feeding the main loop
+// The producer owns bHead, the consumer owns bTail, the fill level is derived from both: No shared read-modify-write, no __disable_irq()
+// The DMB makes sure the byte is in memory before the index which publishes it (and the other way around for the consumer)
+// Only the hooks are used here: the Flag bits share one byte written by both sides.
+u32 NewBV_SPSC(ByteVein_t* BV, u32 begin, s32 size) {
+
+  if(size<2)
+    while(1); // one slot is always kept free, not enough memory for it?
+  
+  NewBV(BV, begin, size);
+  BV->bHead = BV->bTail = 0;
+  BV->SPSC = 1;
+  return begin;
+}
+
+u32 GetBV_SPSC_Count(ByteVein_t* BV) { // can be called from both sides, the result is a snapshot
+
+  u32 Tail = BV->bTail;
+  u32 Head = BV->bHead;
+  
+  if(Head>=Tail) return Head - Tail;
+  return BV->bCountLimit - Tail + Head;
+}
+
+u32 GlueBV_SPSC(ByteVein_t* BV) { // producer side only
+
+  u32 Head = BV->bHead; // we own it
+  u32 Tail = BV->bTail; // snapshot, can only move forward while we are here
+  u32 Next = Head + 1;
+  u32 Count;
+  
+  if(Next>=BV->bCountLimit) // rollover if out of range
+    Next = 0;
+  
+  if(Next==Tail) { // full, only the producer side can act: overwriting is not possible here
+    if(BV->Policy==BV_HANG_WHEN_FULL)
+      while(1); // too big! improve memory allocation
+    BV->bDropped++; // producer only
+    return 0;
+  };
+  
+  ((u8*)BV->pbLowest)[Head] = BV->In;
+  __DMB(); // the byte must be written before the consumer can see it
+  BV->bHead = Next;
+  
+  Count = (Next>=Tail) ? (Next - Tail) : (BV->bCountLimit - Tail + Next);
+  if(Count>BV->bCountMax) BV->bCountMax = Count; // statistics, producer only
+  
+  if(Head==Tail) // it was empty
+    if(BV->fnNoLongerEmpty) // if the strand not empty, tell someone?
+      BV->fnNoLongerEmpty(BV->ctNoLongerEmpty); //!!! this can activate interrupt IRQ...
+  
+  return BV->pbLowest + Head; // where it was written, 0 if dropped
+}
+
+u32 ClipBV_SPSC(ByteVein_t* BV) { // consumer side only
+
+  u32 Tail = BV->bTail; // we own it
+  u32 Head = BV->bHead; // snapshot, can only move forward while we are here
+  
+  if(Head==Tail) // if strand empty, nothing to read from it, error
+    while(1); // error, check GetBV_SPSC_Count() first!
+  
+  __DMB(); // read the byte only after the head which published it
+  BV->Out = ((u8*)BV->pbLowest)[Tail];
+  __DMB(); // the byte must be read before the producer can reuse the slot
+  
+  Tail++;
+  if(Tail>=BV->bCountLimit) // rollover if out of range
+    Tail = 0;
+  BV->bTail = Tail;
+  
+  if(Tail==Head) // as far as we know, it turned empty
+    if(BV->fnEmptied) // if the strand turns empty, tell someone?
+      BV->fnEmptied(BV->ctEmptied);
+
+  return BV->Out;
+}
+
+u32 AddToBV_SPSC(ByteVein_t* BV, u32 In) {
+  
+  BV->In = In;
+  return GlueBV_SPSC(BV);
+}
+
+//==========================================================
+// Power of two mode: the buffer size is 2^n, bTail (Down) and bHead (Up, exclusive) run freely and are masked to address the buffer
+// The count is bHead - bTail, so there is no rollover branch and full (count==size) is not confused with empty (count==0)
+// bCount is still updated so the users polling it keep working.
+u32 NewBV_Pow2(ByteVein_t* BV, u32 begin, s32 size) {
+
+  if((size<=0)||(size & (size - 1)))
+    while(1); // the size must be a power of two
+  
+  NewBV(BV, begin, size);
+  BV->bMask = size - 1;
+  BV->bHead = BV->bTail = 0;
+  return begin;
+}
+
+u32 GlueBV_DownPow2(ByteVein_t* BV) {
+
+  u32 Tail = BV->bTail - 1;
+  
+  if((BV->bHead - BV->bTail)>BV->bMask)
+    while(1); // too big! improve memory allocation
+  
+  ((u8*)BV->pbLowest)[Tail & BV->bMask] = BV->In;
+  BV->bTail = Tail;
+  BV->bCount = BV->bHead - Tail;
+  if(BV->bCount>BV->bCountMax) BV->bCountMax = BV->bCount;// statistics
+  BV_Watermarks(BV, BV->bCount - 1);
+  
+  if(BV->bCount==1) {
+    if(BV->fnNoLongerEmpty) {// if the strand not empty, tell someone?
+      BV->fnNoLongerEmpty(BV->ctNoLongerEmpty);
+    }else{
+      BV->FlagNoLongerEmpty = 1;
+    };
+  };
+  
+  return Tail;
+}
+
+u32 ClipBV_DownPow2(ByteVein_t* BV) {
+
+  u32 Tail = BV->bTail;
+  
+  if(BV->bHead==Tail) // if strand empty, nothing to read from it, error
+    while(1); // error, nothing on this strand, check its size is non zero first!
+  
+  BV->Out = ((u8*)BV->pbLowest)[Tail & BV->bMask];
+  BV->bTail = ++Tail;
+  BV->bCount = BV->bHead - Tail;
+  BV_Watermarks(BV, BV->bCount + 1);
+  
+  if(BV->bCount==0) {
+    if(BV->fnEmptied) {// if the strand turns empty, tell someone?
+      BV->fnEmptied(BV->ctEmptied);
+    }else{
+      BV->FlagEmptied = 1;
+    };
+  };
+  
+  return BV->Out;
+}
+
+u32 GlueBV_UpPow2(ByteVein_t* BV) {
+
+  u32 Head = BV->bHead;
+  
+  if((Head - BV->bTail)>BV->bMask)
+    while(1); // too big! improve memory allocation
+  
+  ((u8*)BV->pbLowest)[Head & BV->bMask] = BV->In;
+  BV->bHead = ++Head;
+  BV->bCount = Head - BV->bTail;
+  if(BV->bCount>BV->bCountMax) BV->bCountMax = BV->bCount;// statistics
+  BV_Watermarks(BV, BV->bCount - 1);
+  
+  if(BV->bCount==1) {
+    if(BV->fnNoLongerEmpty) { // if the strand not empty, tell someone?
+      BV->fnNoLongerEmpty(BV->ctNoLongerEmpty); //!!! this can activate interrupt IRQ...
+    }else{
+      BV->FlagNoLongerEmpty = 1;
+    };
+  };
+  
+  return Head;
+}
+
+u32 ClipBV_UpPow2(ByteVein_t* BV) {
+
+  u32 Head = BV->bHead;
+  
+  if(Head==BV->bTail) // if strand empty, nothing to read from it, error
+    while(1); // error, nothing on this strand, check its size is non zero first!
+  
+  Head--;
+  BV->Out = ((u8*)BV->pbLowest)[Head & BV->bMask];
+  BV->bHead = Head;
+  BV->bCount = Head - BV->bTail;
+  BV_Watermarks(BV, BV->bCount + 1);
+  
+  if(BV->bCount==0) {
+    if(BV->fnEmptied) {// if the strand turns empty, tell someone?
+      BV->fnEmptied(BV->ctEmptied);
+    }else{
+      BV->FlagEmptied = 1;
+    };
+  };
+  
+  return BV->Out;
+}
+
+//==========================================================
+// Zero copy for DMA producers and consumers: the region handed over is contiguous (up to the rollover point)
+// Only one reservation per side at a time. The commit can be partial (the DMA stopped early), the rest of the reservation is simply released.
+u32 ReserveBV_Up(ByteVein_t* BV) {
+
+  u32 pbNext;
+  
+  if(BV->bCountLimit==0) while(1); // error
+  
+  if(BV->bCount==0) { // if strand empty: the region starts on the arbitrary left side
+    pbNext = BV->pbLowest;
+    BV->bUpReserved = BV->bCountLimit;
+  }else{
+    pbNext = BV->pbUp + 1;
+    if(pbNext>BV->pbHighest) // rollover if out of range
+      pbNext = BV->pbLowest;
+    if(pbNext>BV->pbDown) // free up to the top
+      BV->bUpReserved = BV->pbHighest - pbNext + 1;
+    else // free up to the tail (0 if full)
+      BV->bUpReserved = BV->pbDown - pbNext;
+  };
+  
+  BV->pbUpReserved = pbNext;
+  return BV->bUpReserved;
+}
+
+u32 CommitBV_Up(ByteVein_t* BV, u32 n) {
+
+  u32 WasEmpty = (BV->bCount==0);
+  
+  if(n>BV->bUpReserved)
+    while(1); // more than reserved? error
+  BV->bUpReserved = 0;
+  if(n==0) return 0;
+  
+  if(WasEmpty) // the region is now the whole strand
+    BV->pbDown = BV->pbUpReserved;
+  BV->pbUp = BV->pbUpReserved + n - 1;
+  BV->In = *(u8*)BV->pbUp; // as if glued one by one
+  
+  BV->bCount += n;
+  if(BV->bCount>BV->bCountMax) BV->bCountMax = BV->bCount;
+  
+  if(WasEmpty) {
+    if(BV->fnNoLongerEmpty) { // if the strand not empty, tell someone?
+      BV->fnNoLongerEmpty(BV->ctNoLongerEmpty); //!!! this can activate interrupt IRQ...
+    }else{
+      BV->FlagNoLongerEmpty = 1;
+    };
+  };
+  
+  if(BV->bCount==BV->bCountLimit) BV_Filled(BV);
+  BV_Watermarks(BV, BV->bCount - n);
+  
+  return n;
+}
+
+u32 ReserveBV_Down(ByteVein_t* BV) {
+
+  BV->bDownReserved = BV->pbHighest - BV->pbDown + 1; // filled until the rollover
+  if(BV->bDownReserved>BV->bCount)
+    BV->bDownReserved = BV->bCount;
+  
+  return BV->bDownReserved;
+}
+
+u32 CommitBV_Down(ByteVein_t* BV, u32 n) {
+
+  if(n>BV->bDownReserved)
+    while(1); // more than reserved? error
+  BV->bDownReserved = 0;
+  if(n==0) return 0;
+  
+  BV->Out = *(u8*)(BV->pbDown + n - 1); // as if clipped one by one
+  BV->pbDown += n;
+  if(BV->pbDown>BV->pbHighest) // circular memory space top reached.
+    BV->pbDown = BV->pbLowest;
+  
+  if(BV->bCount==BV->bCountLimit) BV_Unfilled(BV);
+  BV->bCount -= n;
+  BV_Watermarks(BV, BV->bCount + n);
+  
+  if(BV->bCount==0) {
+    if(BV->fnEmptied) {// if the strand turns empty, tell someone?
+      BV->fnEmptied(BV->ctEmptied);
+    }else{
+      BV->FlagEmptied = 1;
+    };
+  };
+  
+  return n;
+}
+
+// The stream counts down NDTR from the reserved size: complete or partial transfers are accounted the same way
+u32 CommitBV_UpFromDMA(ByteVein_t* BV, DMA_Stream_TypeDef* Stream) {
+  
+  return CommitBV_Up(BV, BV->bUpReserved - Stream->NDTR);
+}
+
+u32 CommitBV_DownFromDMA(ByteVein_t* BV, DMA_Stream_TypeDef* Stream) {
+  
+  return CommitBV_Down(BV, BV->bDownReserved - Stream->NDTR);
+}
@@ -117,6 +117,7 @@ void I2C_SlaveIO_Rs232_Test(void) {
   // I2C Slave description, using IO_Pin and EXTI (could later on use Basic Timer to implement a timeout like SMBus is doing)
   // This is the data byte vein flowing from I2C Spy to UART TX, and acts as a FIFO
   NewBV(&myBV_TX, (u32)myBV_I2CSpyToTX1, sizeof(myBV_I2CSpyToTX1));
+  SetBV_OverflowPolicy(&myBV_TX, BV_OVERWRITE_OLDEST); // at line rate, keep the newest bytes rather than stopping
   mySlave.BV = &myBV_TX;
   mySlave.Clocks = &MCU_Clocks;
   NewI2C_SlaveIO_SDA_SCL(&mySlave, NewIO_Pin(&mySDA,PH10), NewIO_Pin(&mySCL,PH12));
@@ -192,6 +193,7 @@ void SebExample2(void) {
   // I2C Slave description, using IO_Pin and EXTI (could later on use Basic Timer to implement a timeout like SMBus is doing)
   // This is the data byte vein flowing from I2C Spy to UART TX, and acts as a FIFO
   NewBV(&myBV_TX, (u32)myBV_I2CSpyToTX1, sizeof(myBV_I2CSpyToTX1));
+  SetBV_OverflowPolicy(&myBV_TX, BV_OVERWRITE_OLDEST); // at line rate, keep the newest bytes rather than stopping
   mySlave.BV = &myBV_TX;
   
   mySlave.Clocks = &MCU_Clocks;
@@ -346,6 +348,12 @@ const OneJob_t SPI4_Dummy = { sq_SPI_MHW_MoveJob,  {(u32)&mySPI4, 0, 0, 1} };
 const OneJob_t SPI4_ReadAllShadow = { sq_SPI_MHW_MoveJob,  {(u32)&mySPI4, 0, (u32)&C_ShadowRegs[0], sizeof(C_ShadowRegs)} };
 const OneJob_t SPI4_Stop = { sq_SPI_MHW_StopJob, {(u32)&mySPI4, 1 }};
 
+static const OneJob_t* const ReadAllShadowJobs[] = { // the 3 SPIs one after the other, queued in one go
+  &SPI6_Start, &SPI6_ShadowReadAt00, &SPI6_Dummy, &SPI6_ReadAllShadow, &SPI6_Stop,
+  &SPI5_Start, &SPI5_ShadowReadAt00, &SPI5_Dummy, &SPI5_ReadAllShadow, &SPI5_Stop,
+  &SPI4_Start, &SPI4_ShadowReadAt00, &SPI4_Dummy, &SPI4_ReadAllShadow, &SPI4_Stop,
+};
+
 const OneJob_t SPI4_Wait_50us = { sq_ArmTimerCountdown, {(u32)&Timer6_us, 1, 5 } };
 const OneJob_t SPI4_Wait_5ms =  { sq_ArmTimerCountdown, {(u32)&Timer7_ms, 1, 5 } };
 
@@ -401,23 +409,7 @@ void Test_SPI_MasterHW(void) {
  
   while(1) {
   
-    AddToSA(P, (u32) &SPI6_Start);
-    AddToSA(P, (u32) &SPI6_ShadowReadAt00);
-    AddToSA(P, (u32) &SPI6_Dummy);
-    AddToSA(P, (u32) &SPI6_ReadAllShadow);
-    AddToSA(P, (u32) &SPI6_Stop);
-
-    AddToSA(P, (u32) &SPI5_Start);
-    AddToSA(P, (u32) &SPI5_ShadowReadAt00);
-    AddToSA(P, (u32) &SPI5_Dummy);
-    AddToSA(P, (u32) &SPI5_ReadAllShadow);
-    AddToSA(P, (u32) &SPI5_Stop);
-
-    AddToSA(P, (u32) &SPI4_Start);
-    AddToSA(P, (u32) &SPI4_ShadowReadAt00);
-    AddToSA(P, (u32) &SPI4_Dummy);
-    AddToSA(P, (u32) &SPI4_ReadAllShadow);
-    AddToSA(P, (u32) &SPI4_Stop);
+    AddJobsToSA(P, ReadAllShadowJobs, countof(ReadAllShadowJobs));
     
     StartJobToDoInForeground((u32)&mySequence);
     while(mySequence.FlagEmptied==0);
@@ -0,0 +1,22 @@
+
+#ifndef _SEB_PROTOTHREAD_H_
+#define _SEB_PROTOTHREAD_H_
+
+// Stackless coroutines (protothreads): a function returns in the middle of its work and continues from there when called again
+// The resume point is a PT_t kept in the cell structure, with the locals that must survive a yield (the stack is gone by then)
+// A thread returns PT_YIELDED (non zero, like a job with its callback armed) until it returns PT_ENDED
+// The resume points are case labels: no switch() in a thread body, and one resume point per source line
+typedef u16 PT_t; // 0: start from the beginning
+
+#define PT_ENDED 0
+#define PT_YIELDED 1
+
+#define PT_BEGIN(pt) switch(*(pt)) { case 0:
+#define PT_END(pt) } *(pt) = 0; return PT_ENDED
+#define PT_YIELD(pt) do { *(pt) = __LINE__; return PT_YIELDED; case __LINE__: ; } while(0)
+#define PT_WAIT_WHILE(pt, cond) do { *(pt) = __LINE__; case __LINE__: if(cond) return PT_YIELDED; } while(0)
+#define PT_WAIT_UNTIL(pt, cond) PT_WAIT_WHILE(pt, !(cond))
+#define PT_SPAWN(pt, child, thread) do { *(child) = 0; PT_WAIT_WHILE(pt, (thread)!=PT_ENDED); } while(0) // run a child thread to its end
+#define PT_EXIT(pt) do { *(pt) = 0; return PT_ENDED; } while(0)
+
+#endif
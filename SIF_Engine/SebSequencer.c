@@ -5,27 +5,151 @@
 
 // The sequencer will run called by interrupt to increment the states (PC)
 
+#ifdef SEQUENCER_TRACE
+SQ_Trace_t SQ_Trace;
+
+void NewSQ_Trace(void) {
+
+  CoreDebug->DEMCR |= CoreDebug_DEMCR_TRCENA_Msk; // enable the DWT cycle counter
+  DWT->CTRL |= DWT_CTRL_CYCCNTENA_Msk;
+  SQ_Trace.Count = 0;
+}
+
+void SQ_TraceEvent(u32 Event, u32 fnJob) { // from any context
+
+  SQ_TraceEvent_t* E;
+  u32 Primask = __get_PRIMASK();
+  __disable_irq();
+
+  E = &SQ_Trace.Events[SQ_Trace.Count++ & (SQ_TRACE_SIZE-1)];
+  E->Stamp = (Event<<30) | (DWT->CYCCNT & 0x3FFFFFFF);
+  E->fnJob = fnJob;
+
+  __set_PRIMASK(Primask);
+}
+#endif
+
+// A job artery is classic or power of two (NewSA_Pow2): the sequencer clips and glues through the mode of the artery,
+// as the classic functions don't move the free running indexes. A NewSA_MPSC() artery is drained by MPSCJobToDo() only
+static void sq_ClipSA_Down(StuffsArtery_t* SA) {
+
+  if(SA->MPSC) while(1); // use MPSCJobToDo()
+  if(SA->Mask) ClipSA_DownPow2(SA);
+  else ClipSA_Down(SA);
+}
+
+static u32 sq_GlueSA(StuffsArtery_t* SA, u32 Job, u32 Down) { // Down: at the clipping side, to run next
+
+  if(SA->MPSC) {
+    if(Down) while(1); // the producers only glue up
+    return GlueSA_MPSC(SA, Job);
+  };
+  SA->In = Job;
+  if(SA->Mask) return Down ? GlueSA_DownPow2(SA) : GlueSA_UpPow2(SA);
+  return Down ? GlueSA_Down(SA) : GlueSA_Up(SA);
+}
 
 u32 JobToDo(u32 u) { // this can be called by others OR by the DMA interrupt of this SPI
   
   u32 CallbackArmed = 0;
   StuffsArtery_t* SA = (StuffsArtery_t*) u;
   
+  if(SA->JobArmed) { // back from the interrupt
+    SA->JobArmed = 0;
+    SQ_TRACE(SQ_TRACE_RESUME, ((OneJob_t*)SA->Out)->fnJob);
+  };
+
   do {
-    ClipSA_Down(SA); // this will trigger empty fifo?
+    sq_ClipSA_Down(SA); // this will trigger empty fifo?
     OneJob_t* Job = (OneJob_t*)SA->Out;
     if(Job->fnJob) {
+      SQ_TRACE(SQ_TRACE_START, Job->fnJob);
       CallbackArmed = Job->fnJob((u32)Job->ctJobs);//, Job->Param1, Job->Param2, Job->Param3);
+      SQ_TRACE(SQ_TRACE_END, Job->fnJob);
     }else{
       while(1); // error, no function to call; Did you initialize the SA before your periph_Init() function? Otherwise, it is still 00000 inside...
     };
     
-    if(CallbackArmed) return CallbackArmed; // a task taking time is now done by HW, once finished, it will return back to this function (the interrupt handler will return to this function)
+    if(CallbackArmed) {
+      SA->JobArmed = 1;
+      return CallbackArmed; // a task taking time is now done by HW, once finished, it will return back to this function (the interrupt handler will return to this function)
+    };
   }while(SA->bCount);
   
   return 0;
 }
 
+// Only one context drains (the consumer), the producers post with GlueSA_MPSC() from anywhere
+u32 MPSCJobToDo(u32 u) {
+
+  u32 CallbackArmed;
+  StuffsArtery_t* SA = (StuffsArtery_t*) u;
+  OneJob_t* Job;
+
+  if(SA->JobArmed) { // back from the interrupt
+    SA->JobArmed = 0;
+    SQ_TRACE(SQ_TRACE_RESUME, ((OneJob_t*)SA->Out)->fnJob);
+  };
+
+  while((Job = (OneJob_t*)ClipSA_MPSC(SA))!=0) {
+    if(Job->fnJob) {
+      SQ_TRACE(SQ_TRACE_START, Job->fnJob);
+      CallbackArmed = Job->fnJob((u32)Job->ctJobs);
+      SQ_TRACE(SQ_TRACE_END, Job->fnJob);
+    }else{
+      while(1); // error, no function to call
+    };
+
+    if(CallbackArmed) {
+      SA->Out = (u32)Job; // for the resume trace
+      SA->JobArmed = 1;
+      return CallbackArmed; // the interrupt handler will come back here
+    };
+  };
+
+  SA->FlagEmptied = 1; // as far as we know
+  return 0;
+}
+
+u32 ResumeJobToDo(u32 u) {
+
+  StuffsArtery_t* SA = (StuffsArtery_t*) u;
+
+  if(SA->Dispatched) { // the dispatcher will run the next job of this bus
+    SQ_TRACE(SQ_TRACE_RESUME, ((OneJob_t*)SA->Out)->fnJob);
+    SA->JobArmed = 0;
+    return 0;
+  };
+
+  if(SA->bCount) return JobToDo(u); // it traces the resume
+  SA->JobArmed = 0; // the armed job was the last one
+  SQ_TRACE(SQ_TRACE_RESUME, ((OneJob_t*)SA->Out)->fnJob);
+  return 0;
+}
+
+// For a periodic sequence: hook it to a timer countdown, and end the sequence with a sq_ReArmTimerCountdown job
+u32 ReplaySA(u32 u) {
+
+  if(RearmSA_Replay((StuffsArtery_t*) u))
+    return JobToDo(u);
+  return 0; // the previous run is not over, this one is skipped
+}
+
+u32 AddJobToSA(StuffsArtery_t* SA, OneJob_t* Job) {
+
+  SQ_TRACE(SQ_TRACE_ENQUEUE, Job->fnJob);
+  return sq_GlueSA(SA, (u32)Job, 0);
+}
+
+u32 AddJobsToSA(StuffsArtery_t* SA, const OneJob_t* const* Jobs, u32 n) {
+
+#ifdef SEQUENCER_TRACE
+  u32 i;
+  for(i=0;i<n;i++)
+    SQ_TRACE(SQ_TRACE_ENQUEUE, Jobs[i]->fnJob);
+#endif
+  return GlueSA_UpN(SA, (const u32*)Jobs, n);
+}
 
 // For sequences using interrupts (bitbanging I2C/SPI), call directly JobToDo (no return)  (that the sequence is non blocking)
 u32 StartJobToDoInBackground(u32 u) { // this can be called by others OR by the DMA interrupt of this SPI
@@ -35,6 +159,7 @@ u32 StartJobToDoInBackground(u32 u) { // this can be called by others OR by the
   if(u==0) while(1);
   if(SA->bCount==0) while(1);
   SA->FlagEmptied = 0;
+  SA->JobArmed = 0; // a start, not a resume
   
 //  u32 Primask = __get_PRIMASK(); // get current primask (in the future, it should be to raise the priority to be the same as the IRQ handlers dealing with this sequence... to look like an interrupt
   __disable_irq(); // better is to set to the IRQ level 1 (level 0 being other higher priority normal functions like USB)
@@ -54,8 +179,526 @@ u32 StartJobToDoInForeground(u32 u) { // this can be called by others OR by the
   if(u==0) while(1);
   if(SA->bCount==0) while(1);
   SA->FlagEmptied = 0;
+  SA->JobArmed = 0; // a start, not a resume
   
   JobToDo(u);
   
   return 0;
 }
+
+
+//==========================================================
+// Bus dispatcher: while a bus waits for its DMA or bit timing interrupt, the jobs of the other buses go on
+u32 NewBusDispatcher(BusDispatcher_t* BD) {
+
+  BD->Count = 0;
+  BD->Next = 0;
+  BD->Jobs = BD->Idle = 0;
+  return 0;
+}
+
+u32 AddBusToDispatcher(BusDispatcher_t* BD, StuffsArtery_t* SA) {
+
+  if(BD->Count>=BUS_DISPATCH_MAX) while(1); // too many buses, increase BUS_DISPATCH_MAX
+
+  SA->JobArmed = 0;
+  SA->Dispatched = 1;
+  BD->SA[BD->Count++] = SA;
+  return 0;
+}
+
+u32 BusDispatcherJobToDo(u32 u) {
+
+  BusDispatcher_t* BD = (BusDispatcher_t*) u;
+  StuffsArtery_t* SA;
+  OneJob_t* Job;
+  u32 n;
+
+  for(n=0;n<BD->Count;n++) {
+    SA = BD->SA[BD->Next];
+    if(++BD->Next>=BD->Count) BD->Next = 0;
+    if((SA->bCount==0)||(SA->JobArmed)) continue; // nothing to do, or waiting for its interrupt
+
+    sq_ClipSA_Down(SA);
+    Job = (OneJob_t*)SA->Out;
+    if(Job->fnJob==0) while(1); // error, no function to call
+
+    SA->JobArmed = 1; // before the call: the interrupt can come before the job returns
+    SQ_TRACE(SQ_TRACE_START, Job->fnJob);
+    if(Job->fnJob((u32)Job->ctJobs)==0)
+      SA->JobArmed = 0; // no callback, the bus is ready for its next job
+    SQ_TRACE(SQ_TRACE_END, Job->fnJob);
+    BD->Jobs++;
+    return 1;
+  };
+
+  BD->Idle++;
+  return 0;
+}
+
+
+//==========================================================
+// Priority lanes: urgent sequences (a sensor read with a deadline) overtake bulk ones (a display frame upload) between two jobs
+u32 NewJobLanes(JobLanes_t* JL) {
+
+  u32 n;
+  for(n=0;n<JOB_LANES_MAX;n++)
+    JL->Lane[n] = 0;
+  JL->NonEmpty = 0;
+  JL->FlagEmptied = 1;
+  return 0;
+}
+
+u32 SetJobLane(JobLanes_t* JL, u32 Lane, StuffsArtery_t* SA) {
+
+  if(Lane>=JOB_LANES_MAX) while(1); // this lane does not exist
+
+  JL->Lane[Lane] = SA;
+  if(SA->bCount)
+    JL->NonEmpty |= 0x80000000 >> Lane;
+  return 0;
+}
+
+static void SQ_SyncLane(JobLanes_t* JL, u32 Lane) { // the NonEmpty bit follows bCount, masked as the interrupts post jobs too
+
+  u32 Primask = __get_PRIMASK();
+  __disable_irq();
+  if(JL->Lane[Lane]->bCount) {
+    JL->NonEmpty |= 0x80000000 >> Lane;
+    JL->FlagEmptied = 0;
+  }else{
+    JL->NonEmpty &= ~(0x80000000 >> Lane);
+  };
+  __set_PRIMASK(Primask);
+}
+
+u32 AddJobToLane(JobLanes_t* JL, u32 Lane, u32 Job) {
+
+  if((Lane>=JOB_LANES_MAX)||(JL->Lane[Lane]==0)) while(1); // this lane does not exist
+
+  AddJobToSA(JL->Lane[Lane], (OneJob_t*)Job);
+  SQ_SyncLane(JL, Lane);
+  return 0;
+}
+
+u32 LanesJobToDo(u32 u) { // same as JobToDo(), the lane is chosen again before each job
+
+  u32 CallbackArmed, Lane;
+  JobLanes_t* JL = (JobLanes_t*) u;
+  StuffsArtery_t* SA;
+  OneJob_t* Job;
+
+  while(JL->NonEmpty) {
+    Lane = __CLZ(JL->NonEmpty);
+    SA = JL->Lane[Lane];
+    sq_ClipSA_Down(SA);
+
+    Job = (OneJob_t*)SA->Out;
+    if(Job->fnJob) {
+      SQ_TRACE(SQ_TRACE_START, Job->fnJob);
+      CallbackArmed = Job->fnJob((u32)Job->ctJobs);
+      SQ_TRACE(SQ_TRACE_END, Job->fnJob);
+    }else{
+      while(1); // error, no function to call
+    };
+    SQ_SyncLane(JL, Lane); // after the job: a suspended job program glued itself back on its lane
+
+    if(CallbackArmed) return CallbackArmed; // the interrupt handler will come back here (hooked with LanesJobToDo and this JobLanes_t)
+  };
+
+  JL->FlagEmptied = 1;
+  return 0;
+}
+
+u32 StartLanesJobToDoInBackground(u32 u) {
+
+  JobLanes_t* JL = (JobLanes_t*) u;
+
+  if(u==0) while(1);
+  if(JL->NonEmpty==0) while(1);
+
+  __disable_irq(); // same as StartJobToDoInBackground()
+  LanesJobToDo(u);
+  __enable_irq();
+
+  return 0;
+}
+
+u32 StartLanesJobToDoInForeground(u32 u) {
+
+  JobLanes_t* JL = (JobLanes_t*) u;
+
+  if(u==0) while(1);
+  if(JL->NonEmpty==0) while(1);
+
+  LanesJobToDo(u);
+
+  return 0;
+}
+
+
+//==========================================================
+// Job programs: loops, conditions and jumps without the CPU expanding or queuing the jobs one by one
+static u32 JP_OpSize(u32 Op) { // in words
+
+  if(((Op>>24)==JP_OP_CALL)||((Op>>24)==JP_OP_TEST))
+    return 2 + ((Op>>20) & 0xF);
+  return 1;
+}
+
+u32 AddProgramToSA(StuffsArtery_t* SA, JobProgram_t* P, const u32* Code) {
+
+  if(SA->MPSC) while(1); // a suspended program is glued back Down, the MPSC producers only glue Up
+  P->Code = Code;
+  P->PC = 0;
+  P->Depth = 0;
+  P->Result = 0;
+  P->SA = SA;
+  P->Job.fnJob = sq_JobProgram;
+  P->Job.ctJobs[0] = (u32)P;
+  return AddJobToSA(SA, &P->Job);
+}
+
+u32 sq_JobProgram(u32 u) {
+
+  u32* p = (u32*) u;
+  JobProgram_t* P = (JobProgram_t*) p[0];
+  u32 Op, n, k, i, Result;
+
+  while(1) {
+
+    Op = P->Code[P->PC];
+    switch(Op>>24) {
+
+    case JP_OP_END:
+      P->PC = 0; // ready to be queued again
+      return 0;
+
+    case JP_OP_CALL:
+    case JP_OP_TEST:
+      n = (Op>>20) & 0xF;
+      k = (Op>>16) & 0xF;
+      if(n>4) while(1); // 4 parameters at most
+      for(i=0;i<n;i++)
+        P->Args[i] = P->Code[P->PC + 2 + i];
+      if(k) { // strided parameter
+        if(k>n) while(1); // k is not one of the n parameters
+        if(P->Depth==0) while(1); // a stride needs a loop
+        P->Args[k-1] += P->Loop[P->Depth-1].Index * (Op & 0xFFFF);
+      };
+      Result = ((u32(*)(u32))P->Code[P->PC + 1])((u32)P->Args);
+      P->PC += 2 + n;
+      if((Op>>24)==JP_OP_TEST) {
+        P->Result = Result;
+      }else if(Result) { // callback armed: resume from the next op when it comes back to JobToDo()
+        sq_GlueSA(P->SA, (u32)&P->Job, 1); // in the mode of the artery, LanesJobToDo() sees it after the return
+        P->SA->FlagEmptied = 0; // it was set when the program was clipped
+        return Result;
+      };
+      break;
+
+    case JP_OP_SKIP_IF:
+    case JP_OP_SKIP_IFNOT:
+      P->PC++;
+      if((P->Result!=0)==((Op>>24)==JP_OP_SKIP_IF))
+        for(i=0;i<(Op & 0xFFFFFF);i++)
+          P->PC += JP_OpSize(P->Code[P->PC]);
+      break;
+
+    case JP_OP_JUMP:
+      P->PC = Op & 0xFFFFFF;
+      break;
+
+    case JP_OP_LOOP:
+      if((P->Depth>=JP_LOOP_DEPTH)||((Op & 0xFFFFFF)==0)) while(1); // too deep, or nothing to loop
+      P->PC++;
+      P->Loop[P->Depth].Start = P->PC;
+      P->Loop[P->Depth].Index = 0;
+      P->Loop[P->Depth].Count = Op & 0xFFFFFF;
+      P->Depth++;
+      break;
+
+    case JP_OP_ENDLOOP:
+      if(P->Depth==0) while(1); // no loop to end
+      if(++P->Loop[P->Depth-1].Index < P->Loop[P->Depth-1].Count) {
+        P->PC = P->Loop[P->Depth-1].Start;
+      }else{
+        P->Depth--;
+        P->PC++;
+      };
+      break;
+
+    default:
+      while(1); // unknown op
+    };
+  };
+}
+
+//============================================
+// Move coalescing: each transfer pays its setup (DMA programming, start of a bitbanged block...), one merged transfer pays it once
+#define SQ_MOVE_MAX 65535 // bytes per merged transfer: SPI_MasterHW writes the count into the 16 bit DMA NDTR
+
+// No I2C_MasterIO entry: its direction is in M->SlaveAdr, not in the job, and a read of n clocks n+1 bytes,
+// so two contiguous reads merged are another bus transaction. A caller whose I2C moves are all writes
+// can list { sq_I2C_MIO_MoveJob, 1, 0, 2, 3 } (block, count, more coming) in its own layouts
+const MoveJobLayout_t MoveJobLayouts[] = {
+  { sq_SPI_MHW_MoveJob, 1, 2, 3, 0 }, // TX, RX, count
+};
+const u32 MoveJobLayoutsCount = countof(MoveJobLayouts);
+
+u32 NewJobCoalescer(JobCoalescer_t* JC, const MoveJobLayout_t* Layouts, u32 LayoutsCount, OneJob_t* Pool, u32 PoolSize) {
+
+  if(PoolSize>32) while(1); // one bit of PoolQueued per slot
+  JC->Layouts = Layouts;
+  JC->LayoutsCount = LayoutsCount;
+  JC->Pool = Pool;
+  JC->PoolSize = PoolSize;
+  JC->PoolUsed = 0;
+  JC->PoolQueued = 0;
+  JC->Passes = JC->Scanned = JC->Removed = JC->Merged = JC->BytesMerged = 0;
+  return 0;
+}
+
+static const MoveJobLayout_t* SQ_MoveLayout(JobCoalescer_t* JC, OneJob_t* Job) {
+
+  u32 n;
+  for(n=0;n<JC->LayoutsCount;n++)
+    if(JC->Layouts[n].fnMove==Job->fnJob)
+      return &JC->Layouts[n];
+  return 0; // not a move
+}
+
+static u32 SQ_PoolIndex(JobCoalescer_t* JC, OneJob_t* Job) { // the pool slot of a merged job, PoolSize if not one
+
+  if(((u32)Job<(u32)JC->Pool)||((u32)Job>=(u32)&JC->Pool[JC->PoolSize])) return JC->PoolSize;
+  return Job - JC->Pool;
+}
+
+static u32 SQ_MoveFollows(const MoveJobLayout_t* L, OneJob_t* Prev, OneJob_t* Next) { // can Next be merged at the end of Prev?
+
+  if((Next->fnJob!=Prev->fnJob)||(Next->ctJobs[0]!=Prev->ctJobs[0])) return 0; // another function or another bus
+  if((Prev->ctJobs[L->iTX]==0)||(Next->ctJobs[L->iTX]!=(Prev->ctJobs[L->iTX] + Prev->ctJobs[L->iCount]))) return 0;
+  if(L->iRX)
+    if((Prev->ctJobs[L->iRX]==0)||(Next->ctJobs[L->iRX]!=(Prev->ctJobs[L->iRX] + Prev->ctJobs[L->iCount]))) return 0;
+  if(L->iMoreComing)
+    if(Prev->ctJobs[L->iMoreComing]==0) return 0; // the bus stops after Prev
+  if((Prev->ctJobs[L->iCount] + Next->ctJobs[L->iCount])>SQ_MOVE_MAX) return 0; // the DMA count (NDTR) is 16 bit
+  return 1;
+}
+
+u32 CoalesceSA_Moves(StuffsArtery_t* SA, JobCoalescer_t* JC) {
+
+  u32 r, w, n, Count, Slot, Removed = 0;
+  OneJob_t *Job, *Prev = 0;
+  const MoveJobLayout_t* L = 0;
+
+  if((SA->Mask)||(SA->MPSC)||(SA->ReplayCount)) while(1); // classic mode only, and a recorded sequence must stay as is
+
+  JC->Passes++;
+  JC->PoolQueued = 0; // the merged jobs of the previous passes still queued keep their slot, the others are free again
+  JC->PoolUsed = 0;
+  r = SA->pbDown;
+  for(n=0;n<SA->bCount;n++) {
+    Slot = SQ_PoolIndex(JC, (OneJob_t*)SA->Table[r]);
+    if(++r>SA->pbHighest) r = 0; // rollover
+    if((Slot<JC->PoolSize)&&((JC->PoolQueued & (1<<Slot))==0)) {
+      JC->PoolQueued |= 1<<Slot;
+      JC->PoolUsed++;
+    };
+  };
+  if(SA->bCount<2) return 0; // nothing to merge
+
+  Count = SA->bCount;
+  r = w = SA->pbDown; // the jobs are compacted in place, from the tail
+  for(n=0;n<Count;n++) {
+    Job = (OneJob_t*)SA->Table[r];
+    if(++r>SA->pbHighest) r = 0; // rollover
+    JC->Scanned++;
+
+    if(L && SQ_MoveFollows(L, Prev, Job)) { // merge it
+      if(SQ_PoolIndex(JC, Prev)>=JC->PoolSize) { // the first merge: Prev is copied into a free slot of the pool, its slot then points to the copy
+        for(Slot=0;Slot<JC->PoolSize;Slot++)
+          if((JC->PoolQueued & (1<<Slot))==0) break;
+        if(Slot>=JC->PoolSize) { // no more room, keep it as is
+          L = 0;
+        }else{
+          JC->Pool[Slot] = *Prev;
+          JC->PoolQueued |= 1<<Slot;
+          JC->PoolUsed++;
+          Prev = &JC->Pool[Slot];
+          SA->Table[(w==0) ? SA->pbHighest : w - 1] = (u32)Prev;
+          JC->Merged++;
+          JC->BytesMerged += Prev->ctJobs[L->iCount];
+        };
+      }; // else Prev is already merged (this pass or a previous one), it grows in place
+      if(L) {
+        Prev->ctJobs[L->iCount] += Job->ctJobs[L->iCount];
+        if(L->iMoreComing)
+          Prev->ctJobs[L->iMoreComing] = Job->ctJobs[L->iMoreComing];
+        JC->BytesMerged += Job->ctJobs[L->iCount];
+        Slot = SQ_PoolIndex(JC, Job);
+        if((Slot<JC->PoolSize)&&(JC->PoolQueued & (1<<Slot))) { // a merged job merged again, its slot is free
+          JC->PoolQueued &= ~(1<<Slot);
+          JC->PoolUsed--;
+        };
+        Removed++;
+        continue;
+      };
+    };
+
+    SA->Table[w] = (u32)Job; // kept
+    if(++w>SA->pbHighest) w = 0;
+    Prev = Job;
+    L = SQ_MoveLayout(JC, Job);
+  };
+
+  if(Removed) {
+    SA->pbUp = (w==0) ? SA->pbHighest : w - 1;
+    SA->bCount = Count - Removed; // still non zero, no hook involved
+    JC->Removed += Removed;
+  };
+  return Removed;
+}
+
+
+//============================================
+// Deadline scheduler
+
+#define EDF_BEFORE(a,b) ((s32)((a)-(b))<0) // tick a comes before tick b
+
+static DeadlineJob_t* EDF_At(DeadlineScheduler_t* E, u32 Waiting, u32 i) { // the waiting heap grows down from the top of the table
+
+  return Waiting ? &E->Table[E->bCountLimit - 1 - i] : &E->Table[i];
+}
+
+static u32 EDF_Key(DeadlineJob_t* D, u32 Waiting) {
+
+  return Waiting ? D->Release : D->Deadline;
+}
+
+static void EDF_Push(DeadlineScheduler_t* E, u32 Waiting, DeadlineJob_t* D) {
+
+  u32 i = Waiting ? E->bWaiting++ : E->bReady++;
+  u32 Key = EDF_Key(D, Waiting);
+  u32 Parent;
+
+  while(i) { // sift up
+    Parent = (i - 1) / 2;
+    if(!EDF_BEFORE(Key, EDF_Key(EDF_At(E, Waiting, Parent), Waiting))) break;
+    *EDF_At(E, Waiting, i) = *EDF_At(E, Waiting, Parent);
+    i = Parent;
+  };
+  *EDF_At(E, Waiting, i) = *D;
+}
+
+static void EDF_Pop(DeadlineScheduler_t* E, u32 Waiting, DeadlineJob_t* D) {
+
+  u32 n = Waiting ? --E->bWaiting : --E->bReady;
+  DeadlineJob_t Last = *EDF_At(E, Waiting, n);
+  u32 Key = EDF_Key(&Last, Waiting);
+  u32 i = 0, Child;
+
+  *D = *EDF_At(E, Waiting, 0);
+  while((Child = 2 * i + 1) < n) { // sift down
+    if((Child + 1 < n) && EDF_BEFORE(EDF_Key(EDF_At(E, Waiting, Child + 1), Waiting), EDF_Key(EDF_At(E, Waiting, Child), Waiting)))
+      Child++;
+    if(!EDF_BEFORE(EDF_Key(EDF_At(E, Waiting, Child), Waiting), Key)) break;
+    *EDF_At(E, Waiting, i) = *EDF_At(E, Waiting, Child);
+    i = Child;
+  };
+  *EDF_At(E, Waiting, i) = Last;
+}
+
+u32 NewEDF(DeadlineScheduler_t* E, u32 begin, s32 size, Timer_t* Timer) {
+
+  if((size<=0)||(Timer==0))
+    while(1); // no memory for it, or no time base?
+
+  E->Table = (DeadlineJob_t*)begin;
+  E->bCountLimit = size;
+  E->bReady = E->bWaiting = E->bCountMax = 0;
+  E->Timer = Timer;
+  E->Dispatched = E->Missed = E->WorstLateness = 0;
+  E->FlagMissed = 0;
+  E->FlagEmptied = 1;
+  return begin;
+}
+
+u32 HookEDF_Missed(DeadlineScheduler_t* E, u32 (*fn)(u32), u32 ct) {
+
+  E->ctMissed = ct;
+  E->fnMissed = fn;
+  return 0;
+}
+
+u32 AddJobToEDF(DeadlineScheduler_t* E, OneJob_t* Job, u32 Release, u32 Deadline) {
+
+  DeadlineJob_t D = { Job, Release, Deadline };
+  u32 Primask;
+
+  SQ_TRACE(SQ_TRACE_ENQUEUE, Job->fnJob);
+  Primask = __get_PRIMASK();
+  __disable_irq();
+
+  if((E->bReady + E->bWaiting)>=E->bCountLimit)
+    while(1); // too many jobs! improve memory allocation
+
+  EDF_Push(E, EDF_BEFORE(E->Timer->Ticks, Release), &D);
+  if((E->bReady + E->bWaiting)>E->bCountMax) E->bCountMax = E->bReady + E->bWaiting; // statistics
+  E->FlagEmptied = 0;
+
+  __set_PRIMASK(Primask);
+  return 0;
+}
+
+u32 EDFJobToDo(u32 u) {
+
+  u32 CallbackArmed, Lateness;
+  DeadlineScheduler_t* E = (DeadlineScheduler_t*) u;
+  DeadlineJob_t D;
+  u32 Primask = __get_PRIMASK();
+  __disable_irq();
+
+  while(E->bWaiting && !EDF_BEFORE(E->Timer->Ticks, E->Table[E->bCountLimit - 1].Release)) { // released: move to the ready heap
+    EDF_Pop(E, 1, &D);
+    EDF_Push(E, 0, &D);
+  };
+
+  if(E->bReady==0) { // nothing to do now
+    __set_PRIMASK(Primask);
+    return 0;
+  };
+
+  EDF_Pop(E, 0, &D);
+  __set_PRIMASK(Primask);
+
+  E->Dispatched++;
+  if(D.Job->fnJob) {
+    SQ_TRACE(SQ_TRACE_START, D.Job->fnJob);
+    CallbackArmed = D.Job->fnJob((u32)D.Job->ctJobs);
+    SQ_TRACE(SQ_TRACE_END, D.Job->fnJob);
+  }else{
+    while(1); // error, no function to call
+  };
+  if(CallbackArmed)
+    while(1); // nothing would come back here: run it on a JobToDo artery, or post it from the job
+
+  if(EDF_BEFORE(D.Deadline, E->Timer->Ticks)) { // too late
+    Lateness = E->Timer->Ticks - D.Deadline;
+    E->Missed++;
+    if(Lateness>E->WorstLateness) E->WorstLateness = Lateness;
+    if(E->fnMissed) {
+      E->fnMissed(E->ctMissed);
+    }else{
+      E->FlagMissed = 1;
+    };
+  };
+
+  Primask = __get_PRIMASK();
+  __disable_irq();
+  if((E->bReady + E->bWaiting)==0)
+    E->FlagEmptied = 1;
+  __set_PRIMASK(Primask);
+
+  return 0;
+}
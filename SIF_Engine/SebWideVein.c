@@ -0,0 +1,18 @@
+
+#include "sebEngine.h"
+#include <string.h> // memcpy for the bulk span functions
+
+// The functions for both widths are generated from the same source
+#define WIDE_VEIN_BODY
+
+#define VEIN_WIDTH 16
+#define VEIN_ITEM u16
+#include "SebWideVein_Template.h"
+#undef VEIN_WIDTH
+#undef VEIN_ITEM
+
+#define VEIN_WIDTH 32
+#define VEIN_ITEM u32
+#include "SebWideVein_Template.h"
+#undef VEIN_WIDTH
+#undef VEIN_ITEM
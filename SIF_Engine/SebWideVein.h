@@ -0,0 +1,27 @@
+
+#ifndef _WIDE_VEIN_H_
+#define _WIDE_VEIN_H_
+
+// The byte vein at native width, for ADC/DAC samples (u16) and timer captures (u32): no packing into bytes or pointer slots
+// Same Glue/Clip/hooks as ByteVein_t, one item per glue or clip, bulk span with 2 memcpy at most
+// Both widths come from SebWideVein_Template.h: Vein16_t with NewVein16(), GlueVein16_Up()... and Vein32_t with NewVein32(), GlueVein32_Up()...
+// size is in items (like StuffsArtery_t), not in bytes
+
+#define WV_PASTE3_(a,b,c) a##b##c
+#define WV_PASTE3(a,b,c) WV_PASTE3_(a,b,c)
+#define WV_PASTE4_(a,b,c,d) a##b##c##d
+#define WV_PASTE4(a,b,c,d) WV_PASTE4_(a,b,c,d)
+
+#define VEIN_WIDTH 16
+#define VEIN_ITEM u16
+#include "SebWideVein_Template.h"
+#undef VEIN_WIDTH
+#undef VEIN_ITEM
+
+#define VEIN_WIDTH 32
+#define VEIN_ITEM u32
+#include "SebWideVein_Template.h"
+#undef VEIN_WIDTH
+#undef VEIN_ITEM
+
+#endif
@@ -0,0 +1,229 @@
+
+// No include guard: included once per width by SebWideVein.h (declarations) and SebWideVein.c (WIDE_VEIN_BODY defined)
+// VEIN_WIDTH (16 or 32) and VEIN_ITEM (u16 or u32) are set by the includer
+
+#define WV_T WV_PASTE3(Vein, VEIN_WIDTH, _t)
+#define WV_FN(pre,post) WV_PASTE4(pre, Vein, VEIN_WIDTH, post)
+
+#ifndef WIDE_VEIN_BODY
+
+typedef struct {
+  VEIN_ITEM* Table; // points to the assigned table
+  u32 bCountLimit; // table size in items
+  u32 bCount; // used items
+  u32 bCountMax; // for stats
+  u32 iDown; // current tail (inclusive)
+  u32 iUp; // current head (inclusive)
+
+  u32 In; // the item to glue
+  u32 Out; // the item that was clipped
+
+  u32 (*fnNoLongerEmpty)(u32);
+  u32 ctNoLongerEmpty;
+  u32 (*fnEmptied)(u32);
+  u32 ctEmptied;
+
+  u8 FlagNoLongerEmpty : 1;
+  u8 FlagEmptied : 1;
+
+} WV_T;
+
+u32 WV_FN(New,)(WV_T* V, u32 begin, s32 size);
+u32 WV_FN(Hook,_NoLongerEmpty)(WV_T* V, u32 (*fn)(u32), u32 ct);
+u32 WV_FN(Hook,_Emptied)(WV_T* V, u32 (*fn)(u32), u32 ct);
+u32 WV_FN(Glue,_Down)(WV_T* V);
+u32 WV_FN(Clip,_Down)(WV_T* V);
+u32 WV_FN(Glue,_Up)(WV_T* V);
+u32 WV_FN(Clip,_Up)(WV_T* V);
+u32 WV_FN(AddTo,)(WV_T* V, u32 In);
+u32 WV_FN(Glue,_UpN)(WV_T* V, u32 Adr, u32 n); // n items from Adr, returns n
+u32 WV_FN(Clip,_DownN)(WV_T* V, u32 Adr, u32 n);
+
+#else
+
+u32 WV_FN(Hook,_NoLongerEmpty)(WV_T* V, u32 (*fn)(u32), u32 ct) {
+
+  V->ctNoLongerEmpty = ct;
+  V->fnNoLongerEmpty = fn;
+  return 0;
+}
+
+u32 WV_FN(Hook,_Emptied)(WV_T* V, u32 (*fn)(u32), u32 ct) {
+
+  V->ctEmptied = ct;
+  V->fnEmptied = fn;
+  return 0;
+}
+
+static void WV_FN(,_Glued)(WV_T* V, u32 n) {
+
+  V->bCount += n;
+  if(V->bCount>V->bCountMax) V->bCountMax = V->bCount;// statistics
+
+  if(V->bCount==n) {
+    if(V->fnNoLongerEmpty) {// if the strand not empty, tell someone?
+      V->fnNoLongerEmpty(V->ctNoLongerEmpty); //!!! this can activate interrupt IRQ...
+    }else{
+      V->FlagNoLongerEmpty = 1;
+    };
+  };
+}
+
+static void WV_FN(,_Clipped)(WV_T* V, u32 n) {
+
+  V->bCount -= n;
+
+  if(V->bCount==0) {
+    if(V->fnEmptied) {// if the strand turns empty, tell someone?
+      V->fnEmptied(V->ctEmptied);
+    }else{
+      V->FlagEmptied = 1;
+    };
+  };
+}
+
+//==========================================================
+// StrandCreation
+u32 WV_FN(New,)(WV_T* V, u32 begin, s32 size) {
+
+  if(size<=0)
+    while(1); // no memory for it?
+
+  V->Table = (VEIN_ITEM*)begin;
+  V->bCountLimit = size;
+  V->bCount = 0;
+  return begin;
+}
+
+//==========================================================
+// manage the left side
+u32 WV_FN(Glue,_Down)(WV_T* V) {
+
+  if(V->bCount==0) { // if strand empty: Create the first item
+    V->iDown = V->iUp = 0; // arbitrary left is the start creation side
+  }
+  else {  // the strand exist, check fullness
+    if(V->bCount>=V->bCountLimit)
+      while(1); // too big! improve memory allocation
+
+    if(V->iDown==0) // rollover if out of range
+      V->iDown = V->bCountLimit;
+    V->iDown--;
+  };
+
+  V->Table[V->iDown] = V->In;
+  WV_FN(,_Glued)(V, 1);
+  return V->iDown;
+}
+
+u32 WV_FN(Clip,_Down)(WV_T* V) {
+
+  if(V->bCount==0) // if strand empty, nothing to read from it, error
+    while(1); // error, nothing on this strand, check its size is non zero first!
+
+  V->Out = V->Table[V->iDown];
+  V->iDown++;
+  if(V->iDown>=V->bCountLimit) // rollover
+    V->iDown = 0;
+
+  WV_FN(,_Clipped)(V, 1);
+  return V->Out;
+}
+
+//==========================================================
+// manage the right side
+u32 WV_FN(Glue,_Up)(WV_T* V) {
+
+  if(V->bCount==0) { // if strand empty: Create the first item
+    V->iUp = V->iDown = 0; // arbitrary left is the start creation side
+  }
+  else {  // the strand exist, check fullness
+    if(V->bCount>=V->bCountLimit)
+      while(1); // too big! improve memory allocation
+
+    V->iUp++;
+    if(V->iUp>=V->bCountLimit) // rollover if out of range
+      V->iUp = 0;
+  };
+
+  V->Table[V->iUp] = V->In;
+  WV_FN(,_Glued)(V, 1);
+  return V->iUp;
+}
+
+u32 WV_FN(Clip,_Up)(WV_T* V) {
+
+  if(V->bCount==0) // if strand empty, nothing to read from it, error
+    while(1); // error, nothing on this strand, check its size is non zero first!
+
+  V->Out = V->Table[V->iUp];
+  if(V->iUp==0) // rollover
+    V->iUp = V->bCountLimit;
+  V->iUp--;
+
+  WV_FN(,_Clipped)(V, 1);
+  return V->Out;
+}
+
+u32 WV_FN(AddTo,)(WV_T* V, u32 In) {
+
+  V->In = In;
+  return WV_FN(Glue,_Up)(V);
+}
+
+//==========================================================
+// Bulk span: at most 2 memcpy (before and after the rollover point), the hooks are triggered at most once per call
+u32 WV_FN(Glue,_UpN)(WV_T* V, u32 Adr, u32 n) {
+
+  u32 iNext, Span;
+
+  if(n==0) return 0; // nothing to glue
+  if((V->bCount + n)>V->bCountLimit)
+    while(1); // too big! improve memory allocation
+
+  if(V->bCount==0) { // if strand empty: the span starts on the arbitrary left side
+    iNext = V->iDown = 0;
+  }else{
+    iNext = V->iUp + 1;
+    if(iNext>=V->bCountLimit) // rollover if out of range
+      iNext = 0;
+  };
+
+  Span = V->bCountLimit - iNext; // room until the rollover
+  if(Span>n) Span = n;
+  memcpy(&V->Table[iNext], (VEIN_ITEM*)Adr, Span * sizeof(VEIN_ITEM));
+  if(Span<n) // the rest goes from the bottom
+    memcpy(&V->Table[0], ((VEIN_ITEM*)Adr) + Span, (n - Span) * sizeof(VEIN_ITEM));
+  V->iUp = (Span<n) ? (n - Span - 1) : (iNext + Span - 1);
+
+  V->In = ((VEIN_ITEM*)Adr)[n-1]; // as if glued one by one
+  WV_FN(,_Glued)(V, n);
+  return n;
+}
+
+u32 WV_FN(Clip,_DownN)(WV_T* V, u32 Adr, u32 n) {
+
+  u32 Span;
+
+  if(n==0) return 0; // nothing to clip
+  if(n>V->bCount) // not enough in the strand, error
+    while(1); // error, check bCount first!
+
+  Span = V->bCountLimit - V->iDown; // filled until the rollover
+  if(Span>n) Span = n;
+  memcpy((VEIN_ITEM*)Adr, &V->Table[V->iDown], Span * sizeof(VEIN_ITEM));
+  if(Span<n) // the rest comes from the bottom
+    memcpy(((VEIN_ITEM*)Adr) + Span, &V->Table[0], (n - Span) * sizeof(VEIN_ITEM));
+  V->iDown += n;
+  if(V->iDown>=V->bCountLimit) // rollover
+    V->iDown -= V->bCountLimit;
+
+  V->Out = ((VEIN_ITEM*)Adr)[n-1]; // as if clipped one by one
+  WV_FN(,_Clipped)(V, n);
+  return n;
+}
+
+#endif
+
+#undef WV_T
+#undef WV_FN
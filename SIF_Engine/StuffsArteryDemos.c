@@ -39,3 +39,12 @@ void SA_Test(void) {
 
 
 
+
+//==========================================================
+// u16 rollover tricks versus power of two mask, for FIFO, LIFO and deque access patterns: one driver runs them all, Queue_BenchRun()
+// Compare QB_Results[2][][] with QB_Results[3][][] (watch them in the debugger), on a PC StuffsArtery versus StuffsArteryPow2 in HostTests/QueueBench.c
+void SA_Pow2_Bench(void) {
+  
+  Queue_BenchRun(0);
+  while(1);
+}
@@ -3,5 +3,6 @@
 #define _STUFFS_ARTERY_DEMOS_H_
 
 void SA_Test(void);
+void SA_Pow2_Bench(void);
 
 #endif
@@ -0,0 +1,66 @@
+#!/usr/bin/env python3
+# Converts a dump of SQ_Trace (see sebSequencer.h) to the Chrome trace event JSON, for chrome://tracing or ui.perfetto.dev
+# The dump is the raw struct, little endian, e.g. from gdb: dump binary value trace.bin SQ_Trace
+# The job names come from the ELF symbol table through nm: SQ_TraceToChrome.py trace.bin -e firmware.elf -m 168 > trace.json
+# START/END are the job runs, ENQUEUE an instant, and END..RESUME of the same job the wait for its interrupt (an async slice)
+
+import argparse, json, struct, subprocess, sys
+
+SQ_TRACE_SIZE = 256 # events, as in sebSequencer.h
+
+def ReadEvents(Path):
+  Data = open(Path, "rb").read()
+  if len(Data) < SQ_TRACE_SIZE * 8 + 4: sys.exit("%s: %d bytes, SQ_Trace is %d" % (Path, len(Data), SQ_TRACE_SIZE * 8 + 4))
+  Count, = struct.unpack_from("<I", Data, SQ_TRACE_SIZE * 8)
+  if Count <= SQ_TRACE_SIZE: Order = range(Count)
+  else: Order = [(Count + n) & (SQ_TRACE_SIZE - 1) for n in range(SQ_TRACE_SIZE)] # the oldest first
+  Events, Cycles, Last = [], 0, None
+  for n in Order:
+    Stamp, fnJob = struct.unpack_from("<II", Data, n * 8)
+    Stamp30 = Stamp & 0x3FFFFFFF
+    if Last is not None: Cycles += (Stamp30 - Last) & 0x3FFFFFFF # the stamp wraps at 2^30 cycles
+    Last = Stamp30
+    Events.append((Stamp >> 30, Cycles, fnJob & ~1)) # bit 0: thumb
+  return Events
+
+def ReadSymbols(Elf, Nm):
+  Symbols = {}
+  if Elf is None: return Symbols
+  Out = subprocess.run([Nm, "--defined-only", Elf], capture_output=True, text=True, check=True).stdout
+  for Line in Out.splitlines():
+    Fields = Line.split()
+    if len(Fields) == 3 and Fields[1] in "tTwW": Symbols[int(Fields[0], 16) & ~1] = Fields[2]
+  return Symbols
+
+def Name(Symbols, Address):
+  return Symbols.get(Address, "0x%08X" % Address)
+
+def main():
+  P = argparse.ArgumentParser(description="SQ_Trace dump to Chrome trace event JSON")
+  P.add_argument("dump", help="the raw SQ_Trace struct")
+  P.add_argument("-e", "--elf", help="the firmware, for the job names")
+  P.add_argument("-m", "--mhz", type=float, default=168.0, help="core clock, the DWT cycles per microsecond (default 168)")
+  P.add_argument("--nm", default="arm-none-eabi-nm")
+  A = P.parse_args()
+
+  Symbols = ReadSymbols(A.elf, A.nm)
+  Trace, Armed, Waits = [], {}, 0
+  for Event, Cycles, fnJob in ReadEvents(A.dump):
+    E = { "name": Name(Symbols, fnJob), "ts": Cycles / A.mhz, "pid": 1, "tid": 1 }
+    if Event == 0: E.update(ph="i", s="t", cat="enqueue")
+    elif Event == 1: E.update(ph="B", cat="job")
+    elif Event == 2:
+      E.update(ph="E", cat="job")
+      Armed[fnJob] = E["ts"] # a RESUME of this job tells the callback was armed
+    else:
+      E.update(ph="i", s="t", cat="resume")
+      if fnJob in Armed:
+        Waits += 1
+        Wait = { "name": E["name"], "cat": "wait", "pid": 1, "tid": 1, "id": Waits }
+        Trace.append(dict(Wait, ph="b", ts=Armed.pop(fnJob)))
+        Trace.append(dict(Wait, ph="e", ts=E["ts"]))
+    Trace.append(E)
+  json.dump({ "traceEvents": Trace, "displayTimeUnit": "ns" }, sys.stdout, indent=1)
+
+if __name__ == "__main__":
+  main()
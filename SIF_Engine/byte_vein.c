@@ -8,6 +8,7 @@
 // too many checks for a single bit write.
 // that's why we arbitrary talk 1,4,8,16,24,32 bits... or even more!
 // bit stream engines
+// => done in SebBitVein.c: BitVein_t instances, packed words, 1 to 32 bits per glue/clip. This single bit-band strand stays for the existing users.
 
 u32 pbLowest; // inclusive
 u32 pbHighest;  // inclusive
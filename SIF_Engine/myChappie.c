@@ -27,17 +27,22 @@ static NHD_LCD16x2_t myLCD; // a 16x2 char LCD Low power display, which relies o
 static StuffsArtery_t UrgentTopSA, NormalTopSA; // These are the different global and common sequences
 static u32 UrgentTopSpace[100]; // pointers list
 static u32 NormalTopSpace[100]; // pointers list
+static JobLanes_t TopLanes; // urgent jobs overtake normal ones
 
 
 // we should create a mega structure which groups all this...
 //MCUClocks_t* GetMCUClockTree(void) // unique global resource
 void NewChappie(void) {
 
-//  StuffsArtery_t* UrgentTop = &UrgentTopSA; // program
-//  NewSA(UrgentTop, (u32)&UrgentTopSpace[0], countof(UrgentTopSpace));
+  StuffsArtery_t* UrgentTop = &UrgentTopSA; // program
+  NewSA(UrgentTop, (u32)&UrgentTopSpace[0], countof(UrgentTopSpace));
   
   StuffsArtery_t* NormalTop = &NormalTopSA; // program
   NewSA(NormalTop, (u32)&NormalTopSpace[0], countof(NormalTopSpace));
+  
+  NewJobLanes(&TopLanes); // add the jobs with AddJobToLane(&TopLanes, 0 or 1, Job)
+  SetJobLane(&TopLanes, 0, UrgentTop);
+  SetJobLane(&TopLanes, 1, NormalTop);
 }
 
 void SetChappieTimings(void) {
@@ -56,8 +61,8 @@ u32 EnableChappie(void) {
 //    while(UrgentSA.FlagEmptied==0);
 //    NOPs(1);
   
-    StartJobToDoInForeground((u32)&NormalTopSA); // will come back if there is background task going on...
-    while(NormalTopSA.FlagEmptied==0);
+    StartLanesJobToDoInForeground((u32)&TopLanes); // urgent jobs first, will come back if there is background task going on...
+    while(TopLanes.FlagEmptied==0);
     NOPs(1);
   
     return 0;
@@ -122,8 +122,7 @@ typedef struct {
   void                  (*fnClk) (u32,FunctionalState);
   u32                 ctClk;
   u32                  IRQn;
-  u32                  fnIRQ;
-  u32                  ctIRQ;
+  u32                  Hook; // index in NVIC_Hooks[], NVIC_NO_HOOK if none
   
 } MCU_NodeDependency_t; // this points to a const data // this is one entry
 
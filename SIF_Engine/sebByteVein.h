@@ -6,10 +6,17 @@
 // can grow up from its head, or from its tail, and like the game, the snake can get longer or shorter from either head or tail.
 // Once it becomes empty, a hook can be triggered, or a flag set
 // Once it is no longer empty, same phylosophy
-// TODO: Full, nolongerfull management
+// Once it becomes full or no longer full, same phylosophy. What happens to a byte glued on a full strand depends on the overflow policy
+// Once the count crosses the high watermark upward, or the low watermark downward, same phylosophy: a consumer can be woken once per batch
 // The bit version is called bitcapillar
 // The pointer version is called StuffsArtery
 
+typedef enum {
+  BV_HANG_WHEN_FULL, // default: stop here, the memory allocation has to be improved
+  BV_DROP_NEWEST, // the byte to glue is lost (and counted)
+  BV_OVERWRITE_OLDEST, // the byte at the other end is lost (and counted) to make room
+} BV_OverflowPolicy_t;
+
 typedef struct {
   // by playing with head and tail, any emulation is possible like FIFO, STACK and any exotic things including duplicates, like DNA Strands
   u32 pbLowest; // points to assigned SRAM start address (telomere)
@@ -22,6 +29,17 @@ typedef struct {
 
   u32 In; // the byte to glue
   u32 Out; // the byte that was clipped
+
+  // single producer/single consumer mode: the producer only writes bHead, the consumer only writes bTail, bCount is not used
+  // power of two mode: bHead is one past the head (Up), bTail is the tail (Down), both free running and masked by bMask
+  volatile u32 bHead; // next slot to write, from pbLowest
+  volatile u32 bTail; // next slot to read, from pbLowest
+  u32 bMask; // power of two mode: size - 1
+
+  // zero copy: contiguous regions handed to a DMA, accounted later by the commit
+  u32 pbUpReserved; // where the producer (DMA) writes
+  u32 bUpReserved; // how many bytes it may write there
+  u32 bDownReserved; // how many bytes the consumer (DMA) may read from pbDown
   
 //TBD  u32 (*fnOut)(u32); // This hook is called when an item is added
 //TBD  u32 ctOut;
@@ -34,15 +52,28 @@ typedef struct {
   u32 (*fnEmptied)(u32);
   u32 ctEmptied;
   
-//  u32 (*fnFull)(u32);
-//  u32 ctFull;
-//  u32 (*fnNoLongerFull)(u32);
-//  u32 ctNoLongerFull;
+  u32 (*fnFull)(u32);
+  u32 ctFull;
+  u32 (*fnNoLongerFull)(u32);
+  u32 ctNoLongerFull;
+  
+  u32 (*fnHighWater)(u32); // bCount reached bHighWater from below
+  u32 ctHighWater;
+  u32 (*fnLowWater)(u32); // bCount went down to bLowWater from above
+  u32 ctLowWater;
+  u32 bHighWater; // 0: not used
+  u32 bLowWater; // 0: not used (see fnEmptied)
+  
+  u32 bDropped; // bytes lost by the overflow policy, for telemetry
+  u8 Policy; // BV_OverflowPolicy_t
 
   u8 FlagNoLongerEmpty : 1; // unused
   u8 FlagEmptied : 1; // unused
-//  u8 FlagFull : 1; // unused
-//  u8 FlagNoLongerFull : 1; // unused
+  u8 SPSC : 1; // set by NewBV_SPSC, the vein is then only driven by the *_SPSC functions
+  u8 FlagFull : 1;
+  u8 FlagNoLongerFull : 1;
+  u8 FlagHighWater : 1;
+  u8 FlagLowWater : 1;
   
 } ByteVein_t;
 
@@ -50,6 +81,11 @@ typedef struct {
 u32 NewBV(ByteVein_t* BV, u32 begin, s32 size);
 u32 HookBV_NoLongerEmpty(ByteVein_t* BV, u32 (*fn)(u32), u32 ct);
 u32 HookBV_Emptied(ByteVein_t* BV, u32 (*fn)(u32), u32 ct);
+u32 HookBV_Full(ByteVein_t* BV, u32 (*fn)(u32), u32 ct);
+u32 HookBV_NoLongerFull(ByteVein_t* BV, u32 (*fn)(u32), u32 ct);
+u32 HookBV_HighWater(ByteVein_t* BV, u32 Level, u32 (*fn)(u32), u32 ct); // not for SPSC mode
+u32 HookBV_LowWater(ByteVein_t* BV, u32 Level, u32 (*fn)(u32), u32 ct);
+u32 SetBV_OverflowPolicy(ByteVein_t* BV, BV_OverflowPolicy_t Policy); // for GlueBV_Up/Down/UpN, drop newest only for SPSC, power of two mode always hangs
 u32 GlueBV_Down(ByteVein_t* BV);
 u32 ClipBV_Down(ByteVein_t* BV);
 u32 GlueBV_Up(ByteVein_t* BV);
@@ -64,5 +100,32 @@ u32 GetBV_Up(ByteVein_t* BV);
 
 u32 AddToBV(ByteVein_t* BV, u32 In);
 
+//---------- single producer (ISR) / single consumer (main loop) without interrupt masking
+// one slot is kept free to tell full from empty: size-1 bytes can be stored
+u32 NewBV_SPSC(ByteVein_t* BV, u32 begin, s32 size);
+u32 GetBV_SPSC_Count(ByteVein_t* BV);
+u32 GlueBV_SPSC(ByteVein_t* BV);
+u32 ClipBV_SPSC(ByteVein_t* BV);
+u32 AddToBV_SPSC(ByteVein_t* BV, u32 In);
+
+//---------- power of two size: free running indexes and a mask, no rollover test, full and empty never ambiguous
+u32 NewBV_Pow2(ByteVein_t* BV, u32 begin, s32 size);
+u32 GlueBV_DownPow2(ByteVein_t* BV);
+u32 ClipBV_DownPow2(ByteVein_t* BV);
+u32 GlueBV_UpPow2(ByteVein_t* BV);
+u32 ClipBV_UpPow2(ByteVein_t* BV);
+
+//---------- zero copy: reserve the largest contiguous region, let the DMA move it, then commit what was really transferred
+u32 ReserveBV_Up(ByteVein_t* BV); // returns the free contiguous size, at BV->pbUpReserved
+u32 CommitBV_Up(ByteVein_t* BV, u32 n); // n bytes were written there
+u32 ReserveBV_Down(ByteVein_t* BV); // returns the filled contiguous size, at BV->pbDown
+u32 CommitBV_Down(ByteVein_t* BV, u32 n); // n bytes were read from there
+u32 CommitBV_UpFromDMA(ByteVein_t* BV, DMA_Stream_TypeDef* Stream); // what the stream really moved (reservation - NDTR)
+u32 CommitBV_DownFromDMA(ByteVein_t* BV, DMA_Stream_TypeDef* Stream);
+
+//---------- bulk span, one count update and at most one hook call per call
+u32 GlueBV_UpN(ByteVein_t* BV, u32 Adr, u32 n);
+u32 ClipBV_DownN(ByteVein_t* BV, u32 Adr, u32 n);
+
 
 #endif
@@ -50,9 +50,9 @@ void HookEXTIn(u32 n, u32 fn, u32 ct) { // if adr = 0, unhook a function from th
   // if 0: Disable the feature
   // if same: Clear the pending
   // if new, Enable the feature
-  if(n>countof(fnEXTIs)) while(1); // index too big, this EXTI does not exist
+  if(n>15) while(1); // index too big, this EXTI does not exist
 
-  oldfn = fnEXTIs[n];
+  oldfn = fnEXTIs(n);
 
   if(oldfn && fn) while(1); // can't hook a function if it is already hooked to another one already! Unhook first with "0"
 
@@ -62,8 +62,8 @@ void HookEXTIn(u32 n, u32 fn, u32 ct) { // if adr = 0, unhook a function from th
   if(oldfn==fn)
     return; // no change
 
-  ctEXTIs[n] = ct;
-  fnEXTIs[n] = fn;//0 here
+  ctEXTIs(n) = ct;
+  fnEXTIs(n) = fn;//0 here
 
 }
 
@@ -132,7 +132,7 @@ u32 EXTI_IsIRQHooked(u32 n) {
   for(i=0;i<15;i++) { // sweep all 16 channels
 
       if(       (IRQ==chToIRQn[i]) // if it is the right IRQ...
-        &&      (fnEXTIs[i]!=0) ) return TRUE; // ... and it is hooked, then stop right there, it's hooked!
+        &&      (fnEXTIs(i)!=0) ) return TRUE; // ... and it is hooked, then stop right there, it's hooked!
   }
 
   return FALSE;
@@ -146,7 +146,7 @@ u32 EXTI_IsAnyIRQHooked(void) {
   for(i=0;i<15;i++) { // sweep all 16 channels
 
       if(       (1) // if it is the right IRQ...
-        &&      (fnEXTIs[i]!=0) ) return TRUE; // ... and it is hooked, then stop right there, it's hooked!
+        &&      (fnEXTIs(i)!=0) ) return TRUE; // ... and it is hooked, then stop right there, it's hooked!
   }
 
   return FALSE;
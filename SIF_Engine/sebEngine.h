@@ -7,8 +7,10 @@
 #include "upgrade.h" // This will include all the things your main project include files has. Can be anything outside this repo
 
 #define ADD_EXAMPLES_TO_PROJECT // Comment this line to remove all examples from the project
+//#define SEQUENCER_TRACE // Uncomment this line to record the sequencer job events in SQ_Trace (see sebSequencer.h)
+//#define NVIC_STATS // Uncomment this line to measure the interrupt durations and periods in NVIC_Stats (see sebNVIC.h)
 
-// this tells which NVIC Interrupt handlers to activate
+// this tells which NVIC Interrupt handlers to activate. A value selects a lean handler without the pre/post hooks, like #define SebTIM2 NVIC_BARE (see sebNVIC.h)
 #define SebEXTI1
 #define SebEXTI2
 #define SebEXTI9_5
@@ -40,6 +42,7 @@
 #define SebTIM8_TRG_COM_TIM14
 
 #define SebADC
+//#define SebPendSV // Uncomment this line for the deferred jobs (see DeferJob), then remove PendSV_Handler() from your stm32f4xx_it.c
 
 // These are types we use and might not be available for other compilers or libraries
 /*!< STM32F10x Standard Peripheral Library old types (maintained for legacy purpose) */
@@ -123,7 +126,10 @@ typedef struct {
 //#include "sebBasicTimer.h"
 #include "SebTimer.h"
 #include "SebByteVein.h"
+#include "SebBitVein.h"
+#include "SebWideVein.h"
 #include "SebStuffsArtery.h"
+#include "SebProtothread.h"
 #include "SebPrintf.h"
 #include "SebDac.h"
 #include "sebAdc.h"
@@ -150,6 +156,7 @@ typedef struct {
 #include "RFFE_MasterIO_Demos.h"
 #include "RS232_HW_Demos.h"
 #include "StuffsArteryDemos.h"
+#include "QueueBenchDemos.h"
 #include "ADC_Demos.h"
 
 #endif
@@ -1,5 +1,6 @@
 
 #include "sebEngine.h"
+#include <string.h>
 
 // this file is MCU salestype dependent
 
@@ -106,46 +107,106 @@ typedef enum IRQn
 
 // we are going to put ALL the interrupt vectors and related stuff here (NVIC specific)
 
-#define NVIC_IRQn_Count 90
 #define NVIC_ReleasePendingIRQ(IRQn) NVIC->ICPR[((uint32_t)(IRQn) >> 5)] = (1 << ((uint32_t)(IRQn) & 0x1F)) // Clear pending interrupt
 
-// ~120 hooks = 500 RAM bytes
-// ~90x20 = 180 bytes  stats structure for NVIC
+// ~120 hooks = 1kb RAM bytes (NVIC_Hooks)
 // ~90x4 = 360 bytes for pre-post hooks
-// ~1kb SRAM for NVIC handlers and statistics. Statistics could be unioned SRAM area depending on needs.
+// ~90x76 = 6.8kb for the statistics, only with NVIC_STATS
+
+u32   fnPreNVICs[NVIC_IRQn_Count]; // called with the IRQn, before the hook
+u32   fnPostNVICs[NVIC_IRQn_Count]; // called with the IRQn, after the hook
 
 //============== 8>< ~~~~~~~~~~~~~~~~~~~~~~~~~
-// for statistics. By default, they are disabled. Can be enabled manually, no function to hook/unhook yet by SW
-typedef struct {
-  u16 Start_cy;
-  u16 End_cy;
-  u16 Max_cy;
-  u16 Count;
-  u16 TooLong_cy;
-  u32 fnTooLong; // hook
-  u32 ctTooLong; // hook
-} NVIC_StatsTypeDef;
-
-NVIC_StatsTypeDef NVIC_Stats[NVIC_IRQn_Count]; // 0 1 2 3 4 5..9 10..15
-u32   fnPreNVICs[NVIC_IRQn_Count];
-u32   fnPostNVICs[NVIC_IRQn_Count];
-// these function can be called to check the duration of interrupt stay within needs
+// Statistics, per IRQ, with the DWT cycle counter. They run as the pre and post hooks of the enabled IRQs:
+// a disabled IRQ costs the same null hook test as before, nothing more.
+// The duration includes the time spent in the higher priority interrupts which preempted this one.
+#ifdef NVIC_STATS
+NVIC_StatsTypeDef NVIC_Stats[NVIC_IRQn_Count];
+u32 NVIC_StatsMask[(NVIC_IRQn_Count+31)/32]; // 1 bit per IRQ, set by NVIC_StatsEnable()
+
 u32 PreNVICs(u32 u) {
-//-  NVIC_StatsTypeDef* NVIC_Stat = (NVIC_StatsTypeDef*) u;
-  Set_LED_7(0);
-//-  NVIC_Stat->Start_cy = TIME_GetTimeNow_us(); // pre
+
+  NVIC_StatsTypeDef* S = &NVIC_Stats[u];
+  u32 Now = DWT->CYCCNT;
+  u32 Period = Now - S->Entry_cy; // rollover safe
+
+  if(S->Count) { // the first entry has no previous one
+    MakeItNoMoreThan(S->MinPeriod_cy, Period);
+    MakeItNoLessThan(S->MaxPeriod_cy, Period);
+  };
+  S->Entry_cy = Now;
   return u;
 }
 
 u32 PostNVICs(u32 u) {
-  NVIC_StatsTypeDef* NVIC_Stat = (NVIC_StatsTypeDef*) u;
-//-  NVIC_Stat->End_cy = TIME_GetTimeStamp_cy(); // post
-  NVIC_Stat->Max_cy = max2(NVIC_Stat->Max_cy,NVIC_Stat->End_cy-NVIC_Stat->Start_cy); // even if rollover comes, it should work (unless more than 1 rollover time elapsed which is too abnormal for interrupt handlers)
-  if((NVIC_Stat->TooLong_cy!=0)&&(NVIC_Stat->Max_cy>NVIC_Stat->TooLong_cy))    while(1);
-  NVIC_Stat->Count++;
-  Set_LED_7(1);
+
+  NVIC_StatsTypeDef* S = &NVIC_Stats[u];
+  u32 Duration = DWT->CYCCNT - S->Entry_cy;
+  u32 Bin = 31 - __CLZ(Duration | 1); // log2
+
+  MakeItNoMoreThan(S->Min_cy, Duration);
+  MakeItNoLessThan(S->Max_cy, Duration);
+  S->Sum_cy += Duration;
+  S->Count++;
+  MakeItNoMoreThan(Bin, NVIC_STATS_BINS-1);
+  if(S->Bins[Bin] != 0xFFFF) S->Bins[Bin]++; // saturates
+
+  if((S->TooLong_cy!=0)&&(Duration>S->TooLong_cy)) {
+    if(S->fnTooLong) ((u32(*)(u32))S->fnTooLong)(S->ctTooLong);
+    else while(1); // this interrupt is over its budget
+  };
   return u;
 }
+
+void NVIC_StatsEnable(u32 IRQn, FunctionalState Enable) {
+
+  NVIC_StatsTypeDef* S = &NVIC_Stats[IRQn];
+  if(IRQn>=NVIC_IRQn_Count) while(1); // this IRQ does not exist
+
+  CoreDebug->DEMCR |= CoreDebug_DEMCR_TRCENA_Msk; // enable the DWT cycle counter
+  DWT->CTRL |= DWT_CTRL_CYCCNTENA_Msk;
+
+  fnPreNVICs[IRQn] = 0; // stop first, then clear
+  fnPostNVICs[IRQn] = 0;
+  NVIC_StatsMask[IRQn>>5] &= ~(1<<(IRQn & 0x1F));
+  if(Enable==DISABLE) return; // the figures stay readable
+
+  memset(S->Bins, 0, sizeof(S->Bins));
+  S->Count = S->Sum_cy = S->Max_cy = S->MaxPeriod_cy = 0;
+  S->Min_cy = S->MinPeriod_cy = 0xFFFFFFFF;
+  NVIC_StatsMask[IRQn>>5] |= 1<<(IRQn & 0x1F);
+  fnPostNVICs[IRQn] = (u32)PostNVICs;
+  fnPreNVICs[IRQn] = (u32)PreNVICs;
+}
+
+// One line per enabled IRQ that ran, then its histogram: bin n counts the durations of 2^n..2^(n+1)-1 cycles
+void NVIC_StatsDump(u32 Print) {
+
+  PrintfHk_t* P = (PrintfHk_t*) Print;
+  NVIC_StatsTypeDef S;
+  u32 IRQn, n, Primask;
+
+  for(IRQn=0;IRQn<NVIC_IRQn_Count;IRQn++) {
+    if((NVIC_StatsMask[IRQn>>5] & (1<<(IRQn & 0x1F)))==0) continue;
+
+    Primask = __get_PRIMASK(); // consistent snapshot, the printing is slow
+    __disable_irq();
+    S = NVIC_Stats[IRQn];
+    __set_PRIMASK(Primask);
+    if(S.Count==0) continue;
+
+    SebPrintf(P, "IRQ%d n=%d cy min %d avg %d max %d", IRQn, S.Count, S.Min_cy, S.Sum_cy / S.Count, S.Max_cy);
+    if(S.Count>1)
+      SebPrintf(P, " period %d..%d jitter %d", S.MinPeriod_cy, S.MaxPeriod_cy, S.MaxPeriod_cy - S.MinPeriod_cy);
+    if(NVIC_Storms[IRQn].Storms)
+      SebPrintf(P, " storms %d", (u32)NVIC_Storms[IRQn].Storms);
+    SebPrintf(P, "\n ");
+    for(n=0;n<NVIC_STATS_BINS;n++)
+      SebPrintf(P, " %d", (u32)S.Bins[n]);
+    SebPrintf(P, "\n");
+  };
+}
+#endif
 //============== 8>< ~~~~~~~~~~~~~~~~~~~~~~~~~
 
 //==============================
@@ -156,904 +217,542 @@ u32     u32_fn_u32(u32 u) {
 }
 
 //=========================
-//#if defined(SebEXTI0)||defined(SebEXTI1)||defined(SebEXTI2)||defined(SebEXTI3)||defined(SebEXTI4)||defined(SebEXTI5_9)||defined(SebEXTI15_10)
-u32 fnEXTIs[16],ctEXTIs[16];
-//#endif
-//#if defined(SebDMA1_Stream0)||defined(SebDMA1_Stream1)||defined(SebDMA1_Stream2)||defined(SebDMA1_Stream3)||defined(SebDMA1_Stream4)||defined(SebDMA1_Stream5)||defined(SebDMA1_Stream6)||defined(SebDMA1_Stream7)
-u32 fnDMA1s[8],ctDMA1s[8];
-//#endif
-//#if defined(SebDMA2_Stream0)||defined(SebDMA2_Stream1)||defined(SebDMA2_Stream2)||defined(SebDMA2_Stream3)||defined(SebDMA2_Stream4)||defined(SebDMA2_Stream5)||defined(SebDMA2_Stream6)||defined(SebDMA2_Stream7)
-u32 fnDMA2s[8],ctDMA2s[8];
-//#endif
-u32 fnWWDG,ctWWDG;
-u32 fnPVD,ctPVD;
-u32 fnTAMP_STAMP,ctTAMP_STAMP;
-u32 fnRTC_WKUP,ctRTC_WKUP;
-u32 fnFLASH,ctFLASH;
-u32 fnRCC,ctRCC;
-u32 fnADC1,fnADC2,fnADC3,ctADC1,ctADC2,ctADC3;
-u32 fnCAN1_TX,ctCAN1_TX;
-u32 fnCAN1_RX0,ctCAN1_RX0;
-u32 fnCAN1_RX1,ctCAN1_RX1;
-u32 fnCAN1_SCE,ctCAN1_SCE;
-
-//u32 fnTIM1_BRK_TIM9,ctTIM1_BRK_TIM9;
-u32 fnTIM1_BRK,ctTIM1_BRK;
-u32 fnTIM9,ctTIM9;
-
-//u32 fnTIM1_UP_TIM10,ctTIM1_UP_TIM10;
-u32 fnTIM1_UP,ctTIM1_UP;
-u32 fnTIM10,ctTIM10;
-
-//u32 fnTIM1_TRG_COM_TIM11,ctTIM1_TRG_COM_TIM11;
-u32 fnTIM1_TRG,ctTIM1_TRG;
-u32 fnTIM11, ctTIM11;
-
-u32 fnTIM1_CC,ctTIM1_CC;
-u32 fnTIM2,ctTIM2;
-u32 fnTIM3,ctTIM3;
-u32 fnTIM4,ctTIM4;
-u32 fnI2C1_EV,ctI2C1_EV;
-u32 fnI2C1_ER,ctI2C1_ER;
-u32 fnI2C2_EV,ctI2C2_EV;
-u32 fnI2C2_ER,ctI2C2_ER;
-u32 fnSPI1,ctSPI1;
-u32 fnSPI2,ctSPI2;
-u32 fnUSART1,ctUSART1,lpUSART1;
-u32 fnUSART2,ctUSART2;
-u32 fnUSART3,ctUSART3;
-u32 fnRTC_Alarm,ctRTC_Alarm;
-u32 fnOTG_FS_WKUP,ctOTG_FS_WKUP;
-
-//u32 fnTIM8_BRK_TIM12,ctTIM8_BRK_TIM12;
-u32 fnTIM8_BRK,ctTIM8_BRK;
-u32 fnTIM12,ctTIM12;
-
-//u32 fnTIM8_UP_TIM13,ctTIM8_UP_TIM13;
-u32 fnTIM8_UP,ctTIM8_UP;
-u32 fnTIM13,ctTIM13;
-
-//u32 fnTIM8_TRG_COM_TIM14,ctTIM8_TRG_COM_TIM14;
-u32 fnTIM8_TRG_COM,ctTIM8_TRG_COM;
-u32 fnTIM14,ctTIM14;
-
-u32 fnTIM8_CC,ctTIM8_CC;
-u32 fnFSMC,ctFSMC;
-u32 fnSDIO,ctSDIO;
-u32 fnTIM5,ctTIM5;
-u32 fnSPI3,ctSPI3;
-u32 fnUART4,ctUART4;
-u32 fnUART5,ctUART5;
-u32 fnTIM6_DAC,ctTIM6_DAC;
-u32 fnTIM7,ctTIM7;
-u32 fnETH,ctETH;
-u32 fnETH_WKUP,ctETH_WKUP;
-u32 fnCAN2_TX,ctCAN2_TX;
-u32 fnCAN2_RX0,ctCAN2_RX0;
-u32 fnCAN2_RX1,ctCAN2_RX1;
-u32 fnCAN2_SCE,ctCAN2_SCE;
-u32 fnOTG_FS,ctOTG_FS;
-u32 fnUSART6,ctUSART6;
-u32 fnI2C3_EV,ctI2C3_EV;
-u32 fnI2C3_ER,ctI2C3_ER;
-u32 fnOTG_HS_EP1_OUT,ctOTG_HS_EP1_OUT;
-u32 fnOTG_HS_EP1_IN,ctOTG_HS_EP1_IN;
-u32 fnOTG_HS_WKUP,ctOTG_HS_WKUP;
-u32 fnOTG_HS,ctOTG_HS;
-u32 fnDCMI,ctDCMI;
-u32 fnCRYP,ctCRYP;
-u32 fnHASH_RNG,ctHASH_RNG;
-u32 fnFPU,ctFPU;
-u32 fnSPI4,ctSPI4;
-u32 fnSPI5,ctSPI5;
-u32 fnSPI6,ctSPI6;
+// The hook table, all zero at reset: an unhooked shared channel is served by its demux (see NVIC_Unhooked), which leaves no address in an initializer
+#define NVIC_EXTI_LINES(First,Last,IRQn) (((2<<(Last)) - (1<<(First))) | ((IRQn)<<16)) // [15:0] the lines of the channel
+
+static u32 NVIC_EXTIs_Demux(u32 u);
+static u32 NVIC_ADCs_Demux(u32 u);
+static u32 NVIC_TIMs_Demux(u32 u);
+
+NVIC_Hook_t NVIC_Hooks[NVIC_HOOK_COUNT];
+
+u32 lpUSART1;
+
 //=========================
+// When nothing is hooked, a shared channel goes to its demux. Otherwise clear the source when we know how, or stop right here: an interrupt is enabled without its handler
+static void NVIC_Unhooked(u32 IRQn) {
+
+  switch(IRQn) {
+  case EXTI0_IRQn: NVIC_EXTIs_Demux(NVIC_EXTI_LINES(0,0,EXTI0_IRQn)); break;
+  case EXTI1_IRQn: NVIC_EXTIs_Demux(NVIC_EXTI_LINES(1,1,EXTI1_IRQn)); break;
+  case EXTI2_IRQn: NVIC_EXTIs_Demux(NVIC_EXTI_LINES(2,2,EXTI2_IRQn)); break;
+  case EXTI3_IRQn: NVIC_EXTIs_Demux(NVIC_EXTI_LINES(3,3,EXTI3_IRQn)); break;
+  case EXTI4_IRQn: NVIC_EXTIs_Demux(NVIC_EXTI_LINES(4,4,EXTI4_IRQn)); break;
+  case EXTI9_5_IRQn: NVIC_EXTIs_Demux(NVIC_EXTI_LINES(5,9,EXTI9_5_IRQn)); break;
+  case EXTI15_10_IRQn: NVIC_EXTIs_Demux(NVIC_EXTI_LINES(10,15,EXTI15_10_IRQn)); break;
+  case ADC_IRQn: NVIC_ADCs_Demux(0); break;
+  case TIM1_BRK_TIM9_IRQn: NVIC_TIMs_Demux(0); break; // index in NVIC_TIM_Sources[]
+  case TIM1_UP_TIM10_IRQn: NVIC_TIMs_Demux(1); break;
+  case TIM1_TRG_COM_TIM11_IRQn: NVIC_TIMs_Demux(2); break;
+  case TIM8_BRK_TIM12_IRQn: NVIC_TIMs_Demux(3); break;
+  case TIM8_UP_TIM13_IRQn: NVIC_TIMs_Demux(4); break;
+  case TIM8_TRG_COM_TIM14_IRQn: NVIC_TIMs_Demux(5); break;
+  case USART1_IRQn:
+    if((USART1->CR1 & USART_FLAG_TXE)&&(USART1->SR & USART_FLAG_TXE)) // if ready to transmit by interrupt... send a dummy! Write to DR
+      USART1->DR = lpUSART1; // LF ASCII char, will clear the interrupt
+    else lpUSART1 = USART1->DR;   // dummy read of the data to clear the pending interrupt, this will clear PE, RXNE and FE bits (this will route RX back to TX)
+    break;
+  case TIM6_DAC_IRQn: TIM6->SR &= ~1; break;
+  case TIM7_IRQn: TIM7->SR &= ~1; break;
+  case ETH_IRQn: NVIC_ReleasePendingIRQ(ETH_IRQn); break;
+  default: while(1);//TODO clear the pending flag
+  };
+}
+
+// Only the pending and enabled lines of the channel are served, lowest line first, one CLZ per line
+static u32 NVIC_EXTIs_Demux(u32 u) {
+
+  u32 n;
+  NVIC_Hook_t* H;
+  u32 Pending = EXTI->PR & EXTI->IMR & u & 0xFFFF;
+  while(Pending) {
+    n = __CLZ(__RBIT(Pending)); // the lowest set bit
+    H = &NVIC_Hooks[NVIC_HOOK_EXTI(n)];
+    if(H->fn) ((u32(*)(u32))H->fn)(H->ct);
+    else EXTI->PR = 1<<n; // clear the signal causing the interrupt when no handler
+    Pending &= ~(1<<n);
+    if(Pending) Pending &= EXTI->PR; // a hook may serve several lines (I2C slave SDA and SCL): skip what it cleared
+  };
+  NVIC_ReleasePendingIRQ(u>>16);
+  return u;
+}
 
+static u32 NVIC_ADCs_Demux(u32 u) {
 
-//=====================================
-//===== 8>< ~~~~~~~~~~~~~~~~~~~~~~
-#ifdef SebWWDG
-__irq void WWDG_IRQHandler(void) { //  WWDG_IRQn                   = 0,      /*!< Window WatchDog Interrupt                                         */
-  if(fnPreNVICs[WWDG_IRQn]) ((u32(*)(u32))fnPreNVICs[WWDG_IRQn])((u32)&NVIC_Stats[WWDG_IRQn]); // call either an empty function or a hooked one with desired context predefined (if context missing... error)
-    if(fnWWDG) ((u32(*)(u32))fnWWDG)(ctWWDG); // call either an empty function or a hooked one with desired context predefined (if context missing... error)
-    else while(1);//TODO clear the pending flag EXTI->PR |= (1<<10);  // clear the pending flag
-  if(fnPostNVICs[WWDG_IRQn]) ((u32(*)(u32))fnPostNVICs[WWDG_IRQn])((u32)&NVIC_Stats[WWDG_IRQn]); // call either an empty function or a hooked one with desired context predefined (if context missing... error)
+  u32 n, Hooked = 0;
+  NVIC_Hook_t* H;
+  for(n = NVIC_HOOK_ADC1; n <= NVIC_HOOK_ADC3; n++) {
+    H = &NVIC_Hooks[n];
+    if(H->fn) {
+      ((u32(*)(u32))H->fn)(H->ct);
+      Hooked++;
+    };
+  };
+  if(Hooked==0) while(1);//TODO clear the pending flag
+  NVIC_ReleasePendingIRQ(ADC_IRQn);
+  return u;
 }
-#endif
 
-#ifdef SebPVD
-__irq void PVD_IRQHandler(void) {//  PVD_IRQn                    = 1,      /*!< PVD through EXTI Line detection Interrupt                         */
-  if(fnPreNVICs[PVD_IRQn]) ((u32(*)(u32))fnPreNVICs[PVD_IRQn])((u32)&NVIC_Stats[PVD_IRQn]); // call either an empty function or a hooked one with desired context predefined (if context missing... error)
-    if(fnPVD) ((u32(*)(u32))fnPVD)(ctPVD); // call either an empty function or a hooked one with desired context predefined (if context missing... error)
-    else while(1);//TODO clear the pending flag EXTI->PR |= (1<<10);  // clear the pending flag
-  if(fnPostNVICs[PVD_IRQn]) ((u32(*)(u32))fnPostNVICs[PVD_IRQn])((u32)&NVIC_Stats[PVD_IRQn]); // call either an empty function or a hooked one with desired context predefined (if context missing... error)
+// TIM1 and TIM8 share their vectors with TIM9..14. Each source is a (timer, flags, hook) row: a source is served
+// when one of its flags is both set and enabled, so one register pair per source, and both sources in one entry.
+typedef struct {
+  TIM_TypeDef* TIM;
+  u16 Flags; // its flags served by this vector
+  u16 Hook;
+} NVIC_TIM_Source_t;
+
+static const NVIC_TIM_Source_t NVIC_TIM_Sources[][2] = { // small timer first, as before
+  { { TIM9,  TIM_FLAG_Update | TIM_FLAG_CC1 | TIM_FLAG_CC2 | TIM_FLAG_Trigger, NVIC_HOOK_TIM9 },  { TIM1, TIM_FLAG_Break, NVIC_HOOK_TIM1_BRK } },
+  { { TIM10, TIM_FLAG_Update | TIM_FLAG_CC1,                                   NVIC_HOOK_TIM10 }, { TIM1, TIM_FLAG_Update, NVIC_HOOK_TIM1_UP } },
+  { { TIM11, TIM_FLAG_Update | TIM_FLAG_CC1,                                   NVIC_HOOK_TIM11 }, { TIM1, TIM_FLAG_Trigger | TIM_FLAG_COM, NVIC_HOOK_TIM1_TRG_COM } },
+  { { TIM12, TIM_FLAG_Update | TIM_FLAG_CC1 | TIM_FLAG_CC2 | TIM_FLAG_Trigger, NVIC_HOOK_TIM12 }, { TIM8, TIM_FLAG_Break, NVIC_HOOK_TIM8_BRK } },
+  { { TIM13, TIM_FLAG_Update | TIM_FLAG_CC1,                                   NVIC_HOOK_TIM13 }, { TIM8, TIM_FLAG_Update, NVIC_HOOK_TIM8_UP } },
+  { { TIM14, TIM_FLAG_Update | TIM_FLAG_CC1,                                   NVIC_HOOK_TIM14 }, { TIM8, TIM_FLAG_Trigger | TIM_FLAG_COM, NVIC_HOOK_TIM8_TRG_COM } },
+};
+
+static u32 NVIC_TIMs_Demux(u32 u) {
+
+  const NVIC_TIM_Source_t* S = NVIC_TIM_Sources[u];
+  NVIC_Hook_t* H;
+  u32 i, Served = 0;
+  for(i=0;i<2;i++,S++) {
+    if((S->TIM->SR & S->TIM->DIER & S->Flags)==0) continue;
+    H = &NVIC_Hooks[S->Hook];
+    if(H->fn) ((u32(*)(u32))H->fn)(H->ct);
+    else while(1);//TODO clear the pending flag
+    Served++;
+  };
+  if(Served==0) { // a flag outside the table: the big timer hook sorts it out, as it did before
+    H = &NVIC_Hooks[NVIC_TIM_Sources[u][1].Hook];
+    if(H->fn) ((u32(*)(u32))H->fn)(H->ct);
+    else while(1);//TODO clear the pending flag
+  };
+  return u;
 }
+
+//=========================
+// Interrupt storm guard. The window restarts at the first entry after it expired (no sliding window, no history to keep)
+NVIC_Storm_t NVIC_Storms[NVIC_IRQn_Count];
+u32 NVIC_StormCount;
+static StuffsArtery_t* NVIC_StormSA; // where the release job goes, 0: NVIC_StormRelease() is called by hand
+static OneJob_t NVIC_StormJob;
+static u8 NVIC_StormJobQueued;
+
+#if defined(__ARM_ARCH_7M__) || defined(__ARM_ARCH_7EM__)
+#define NVIC_STORM_LDREX
+#endif
+
+static u32 NVIC_StormClaimJob(void) { // test and set: 1 if the caller posts the release job. A storm can preempt another one
+#ifdef NVIC_STORM_LDREX
+  do {
+    if(__LDREXB(&NVIC_StormJobQueued)) {
+      __CLREX();
+      return 0; // already queued
+    };
+  }while(__STREXB(1, &NVIC_StormJobQueued));
+  return 1;
+#else
+  return __atomic_exchange_n(&NVIC_StormJobQueued, 1, __ATOMIC_ACQ_REL)==0;
 #endif
+}
 
-#ifdef SebTAMP_STAMP
-__irq void TAMP_STAMP_IRQHandler(void) {//  TAMP_STAMP_IRQn             = 2,      /*!< Tamper and TimeStamp interrupts through the EXTI line             */
-  if(fnPreNVICs[TAMP_STAMP_IRQn]) ((u32(*)(u32))fnPreNVICs[TAMP_STAMP_IRQn])((u32)&NVIC_Stats[TAMP_STAMP_IRQn]); // call either an empty function or a hooked one with desired context predefined (if context missing... error)
-    if(fnTAMP_STAMP) ((u32(*)(u32))fnTAMP_STAMP)(ctTAMP_STAMP); // call either an empty function or a hooked one with desired context predefined (if context missing... error)
-    else while(1);//TODO clear the pending flag EXTI->PR |= (1<<10);  // clear the pending flag
-  if(fnPostNVICs[TAMP_STAMP_IRQn]) ((u32(*)(u32))fnPostNVICs[TAMP_STAMP_IRQn])((u32)&NVIC_Stats[TAMP_STAMP_IRQn]); // call either an empty function or a hooked one with desired context predefined (if context missing... error)
+static void NVIC_StormPost(void) {
+
+  if(NVIC_StormSA && NVIC_StormClaimJob())
+    if(GlueSA_MPSC(NVIC_StormSA, (u32)&NVIC_StormJob)==0)
+      NVIC_StormJobQueued = 0; // artery full, the next storm or release will try again
 }
-#endif
 
-#ifdef SebRTC_WKUP
-__irq void RTC_WKUP_IRQHandler(void) {//  RTC_WKUP_IRQn               = 3,      /*!< RTC Wakeup interrupt through the EXTI line                        */
-  if(fnPreNVICs[RTC_WKUP_IRQn]) ((u32(*)(u32))fnPreNVICs[RTC_WKUP_IRQn])((u32)&NVIC_Stats[RTC_WKUP_IRQn]); // call either an empty function or a hooked one with desired context predefined (if context missing... error)
-    if(fnRTC_WKUP) ((u32(*)(u32))fnRTC_WKUP)(ctRTC_WKUP); // call either an empty function or a hooked one with desired context predefined (if context missing... error)
-    else while(1);//TODO clear the pending flag EXTI->PR |= (1<<10);  // clear the pending flag
-  if(fnPostNVICs[RTC_WKUP_IRQn]) ((u32(*)(u32))fnPostNVICs[RTC_WKUP_IRQn])((u32)&NVIC_Stats[RTC_WKUP_IRQn]); // call either an empty function or a hooked one with desired context predefined (if context missing... error)
+void NewNVIC_StormGuard(u32 SA) {
+
+  if(SA && ((StuffsArtery_t*)SA)->MPSC==0) while(1); // posted from interrupts: only a NewSA_MPSC() artery is safe here
+  NVIC_StormJob.fnJob = NVIC_StormRelease;
+  NVIC_StormJobQueued = 0;
+  NVIC_StormSA = (StuffsArtery_t*) SA;
 }
-#endif
 
-#ifdef SebFLASH
-__irq void FLASH_IRQHandler(void) {//  FLASH_IRQn                  = 4,      /*!< FLASH global Interrupt                                            */
-  if(fnPreNVICs[FLASH_IRQn]) ((u32(*)(u32))fnPreNVICs[FLASH_IRQn])((u32)&NVIC_Stats[FLASH_IRQn]); // call either an empty function or a hooked one with desired context predefined (if context missing... error)
-    if(fnFLASH) ((u32(*)(u32))fnFLASH)(ctFLASH); // call either an empty function or a hooked one with desired context predefined (if context missing... error)
-    else while(1);//TODO clear the pending flag EXTI->PR |= (1<<10);  // clear the pending flag
-  if(fnPostNVICs[FLASH_IRQn]) ((u32(*)(u32))fnPostNVICs[FLASH_IRQn])((u32)&NVIC_Stats[FLASH_IRQn]); // call either an empty function or a hooked one with desired context predefined (if context missing... error)
+void NVIC_StormLimit(u32 IRQn, u32 MaxEntries, u32 Window_cy) {
+
+  NVIC_Storm_t* S = &NVIC_Storms[IRQn];
+  if(IRQn>=NVIC_IRQn_Count) while(1); // this IRQ does not exist
+  if(MaxEntries>0xFFFF) while(1); // use a shorter window
+
+  CoreDebug->DEMCR |= CoreDebug_DEMCR_TRCENA_Msk; // enable the DWT cycle counter
+  DWT->CTRL |= DWT_CTRL_CYCCNTENA_Msk;
+
+  S->MaxEntries = 0; // the dispatcher ignores it while we change it
+  S->Window_cy = Window_cy;
+  S->WindowStart_cy = DWT->CYCCNT;
+  S->Entries = 0;
+  S->MaxEntries = MaxEntries;
 }
-#endif
 
-#ifdef SebRCC
-__irq void RCC_IRQHandler(void) {//  RCC_IRQn                    = 5,      /*!< RCC global Interrupt                                              */
-  if(fnPreNVICs[RCC_IRQn]) ((u32(*)(u32))fnPreNVICs[RCC_IRQn])((u32)&NVIC_Stats[RCC_IRQn]); // call either an empty function or a hooked one with desired context predefined (if context missing... error)
-    if(fnRCC) ((u32(*)(u32))fnRCC)(ctRCC); // call either an empty function or a hooked one with desired context predefined (if context missing... error)
-    else while(1);//TODO clear the pending flag EXTI->PR |= (1<<10);  // clear the pending flag
-  if(fnPostNVICs[RCC_IRQn]) ((u32(*)(u32))fnPostNVICs[RCC_IRQn])((u32)&NVIC_Stats[RCC_IRQn]); // call either an empty function or a hooked one with desired context predefined (if context missing... error)
+// this entry is still served, the next ones wait for the release job
+static void NVIC_StormCheck(u32 IRQn) {
+
+  NVIC_Storm_t* S = &NVIC_Storms[IRQn];
+  u32 Now = DWT->CYCCNT;
+
+  if((Now - S->WindowStart_cy) >= S->Window_cy) { // rollover safe
+    S->WindowStart_cy = Now;
+    S->Entries = 0;
+  };
+  if(++S->Entries <= S->MaxEntries) return;
+
+  NVIC->ICER[IRQn >> 5] = 1 << (IRQn & 0x1F); // mask the line, its pending flag stays for later
+  S->Masked = 1;
+  S->Storms++;
+  NVIC_StormCount++;
+  NVIC_StormPost();
+}
+
+// A line is unmasked once its window is over, the ones still inside it keep the job posted
+u32 NVIC_StormRelease(u32 u) { // job compatible, from the main loop
+
+  u32 IRQn, Now, Waiting = 0;
+  NVIC_Storm_t* S;
+  (void)u;
+  NVIC_StormJobQueued = 0; // from now on, a new storm posts the job again
+
+  for(IRQn=0;IRQn<NVIC_IRQn_Count;IRQn++) {
+    S = &NVIC_Storms[IRQn];
+    if(S->Masked==0) continue;
+    Now = DWT->CYCCNT;
+    if((Now - S->WindowStart_cy) < S->Window_cy) { // rollover safe
+      Waiting++;
+      continue;
+    };
+    S->Masked = 0;
+    S->WindowStart_cy = Now; // a fresh window
+    S->Entries = 0;
+    NVIC->ISER[IRQn >> 5] = 1 << (IRQn & 0x1F);
+  };
+  if(Waiting) NVIC_StormPost(); // behind the jobs queued meanwhile
+  return 0;
+}
+
+//=========================
+// Deferred work. Posting twice the same job runs it twice: a job which drains a vein should be posted when the vein gets no longer empty
+static StuffsArtery_t* NVIC_DeferredSA;
+u32 NVIC_DeferredLost;
+
+void NewNVIC_Deferred(u32 SA) {
+
+  if(SA==0 || ((StuffsArtery_t*)SA)->MPSC==0) while(1); // posted from interrupts: only a NewSA_MPSC() artery is safe here
+  NVIC_DeferredLost = 0;
+  NVIC_DeferredSA = (StuffsArtery_t*) SA;
+  NVIC_SetPriority(PendSV_IRQn, (1<<__NVIC_PRIO_BITS) - 1); // below all the IRQs, it only preempts the main loop
+}
+
+u32 DeferJob(u32 Job) { // hook compatible
+
+  if(NVIC_DeferredSA==0) while(1); // call NewNVIC_Deferred() first
+  if(GlueSA_MPSC(NVIC_DeferredSA, Job)==0) {
+    NVIC_DeferredLost++;
+    return 0;
+  };
+  SCB->ICSR = SCB_ICSR_PENDSVSET_Msk; // after the glue: a PendSV already running will see the job, or run once more
+  return Job;
+}
+
+#ifdef SebPendSV
+__irq void PendSV_Handler(void) {
+
+  if(MPSCJobToDo((u32)NVIC_DeferredSA)) while(1); // a deferred job armed a callback: nothing would resume it here
 }
 #endif
 
-#ifdef SebEXTI0
-__irq void EXTI0_IRQHandler(void) {//  EXTI0_IRQn                  = 6,      /*!< EXTI Line0 Interrupt                                              */
-  if(fnPreNVICs[EXTI0_IRQn]) ((u32(*)(u32))fnPreNVICs[EXTI0_IRQn])((u32)&NVIC_Stats[EXTI0_IRQn]); // call either an empty function or a hooked one with desired context predefined (if context missing... error)
-    if(fnEXTIs[0]) ((u32(*)(u32))fnEXTIs[0])(ctEXTIs[0]); // call either an empty function or a hooked one with desired context predefined (if context missing... error)
-    else EXTI->PR |= (1<<0);  // clear the pending flag
-    NVIC_ReleasePendingIRQ(EXTI0_IRQn);
-  if(fnPostNVICs[EXTI0_IRQn]) ((u32(*)(u32))fnPostNVICs[EXTI0_IRQn])((u32)&NVIC_Stats[EXTI0_IRQn]); // call either an empty function or a hooked one with desired context predefined (if context missing... error)
+//=========================
+// The one interrupt handler. IPSR holds the active exception number, which is 16 + IRQn
+void NVIC_Dispatch(void) {
+
+  NVIC_Serve((__get_IPSR() & 0x1FF) - 16); // a tail branch at worst
+}
+
+void NVIC_Serve(u32 IRQn) {
+
+  NVIC_Hook_t* H = &NVIC_Hooks[IRQn];
+  if(NVIC_Storms[IRQn].MaxEntries) NVIC_StormCheck(IRQn);
+  if(fnPreNVICs[IRQn]) ((u32(*)(u32))fnPreNVICs[IRQn])(IRQn);
+  if(H->fn) ((u32(*)(u32))H->fn)(H->ct); // call the hooked function with its context
+  else NVIC_Unhooked(IRQn);
+  if(fnPostNVICs[IRQn]) ((u32(*)(u32))fnPostNVICs[IRQn])(IRQn);
 }
+
+u32 HookIRQn(u32 Hook, u32 fn, u32 ct) {
+
+  u32 oldfn;
+  if(Hook>=NVIC_HOOK_COUNT) while(1); // this hook does not exist
+  oldfn = NVIC_Hooks[Hook].fn;
+  NVIC_Hooks[Hook].ct = ct; // context first, the handler only looks at fn
+  NVIC_Hooks[Hook].fn = fn;
+  return oldfn;
+}
+
+// The lean bodies: IRQn is a constant in the vectors, the table entry address is folded, no IPSR read
+#define NVIC_SERVE(IRQn) NVIC_Dispatch()
+#define NVIC_SERVE_BARE(IRQn) { NVIC_Hook_t* H = &NVIC_Hooks[IRQn]; if(H->fn) ((u32(*)(u32))H->fn)(H->ct); else NVIC_Unhooked(IRQn); }
+#define NVIC_SERVE_DIRECT(IRQn) ((u32(*)(u32))NVIC_Hooks[IRQn].fn)(NVIC_Hooks[IRQn].ct)
+
+//=====================================
+// The startup file vectors are weak: each activated one lands here
+// Mode is the SebXXX define, expanded first: empty branches to NVIC_Dispatch(), NVIC_BARE (_BARE) and NVIC_DIRECT (_DIRECT) select the lean bodies
+// Name is pasted before any expansion: TIM2, RCC, USART1... are also the peripheral macros of the ST headers
+#define NVIC_VECTOR(Name, Mode) NVIC_VECTOR_(Name##_IRQHandler, Name##_IRQn, Mode)
+#define NVIC_VECTOR_(Handler, IRQn, Mode) __irq void Handler(void) { NVIC_SERVE##Mode(IRQn); }
+
+#ifdef SebWWDG
+NVIC_VECTOR(WWDG, SebWWDG)
+#endif
+#ifdef SebPVD
+NVIC_VECTOR(PVD, SebPVD)
+#endif
+#ifdef SebTAMP_STAMP
+NVIC_VECTOR(TAMP_STAMP, SebTAMP_STAMP)
+#endif
+#ifdef SebRTC_WKUP
+NVIC_VECTOR(RTC_WKUP, SebRTC_WKUP)
+#endif
+#ifdef SebFLASH
+NVIC_VECTOR(FLASH, SebFLASH)
+#endif
+#ifdef SebRCC
+NVIC_VECTOR(RCC, SebRCC)
+#endif
+#ifdef SebEXTI0
+NVIC_VECTOR(EXTI0, SebEXTI0)
 #endif
 #ifdef SebEXTI1
-__irq void EXTI1_IRQHandler(void) {//  EXTI1_IRQn                  = 7,      /*!< EXTI Line1 Interrupt                                              */
-  if(fnPreNVICs[EXTI1_IRQn]) ((u32(*)(u32))fnPreNVICs[EXTI1_IRQn])((u32)&NVIC_Stats[EXTI1_IRQn]); // call either an empty function or a hooked one with desired context predefined (if context missing... error)
-    if(fnEXTIs[1]) ((u32(*)(u32))fnEXTIs[1])(ctEXTIs[1]); // call either an empty function or a hooked one with desired context predefined (if context missing... error)
-    else EXTI->PR |= (1<<1);  // clear the pending flag
-    NVIC_ReleasePendingIRQ(EXTI1_IRQn);
-  if(fnPostNVICs[EXTI1_IRQn]) ((u32(*)(u32))fnPostNVICs[EXTI1_IRQn])((u32)&NVIC_Stats[EXTI1_IRQn]); // call either an empty function or a hooked one with desired context predefined (if context missing... error)
-}
+NVIC_VECTOR(EXTI1, SebEXTI1)
 #endif
 #ifdef SebEXTI2
-__irq void EXTI2_IRQHandler(void) {//  EXTI2_IRQn                  = 8,      /*!< EXTI Line2 Interrupt                                              */
-  if(fnPreNVICs[EXTI2_IRQn]) ((u32(*)(u32))fnPreNVICs[EXTI2_IRQn])((u32)&NVIC_Stats[EXTI2_IRQn]); // call either an empty function or a hooked one with desired context predefined (if context missing... error)
-    if(fnEXTIs[2]) ((u32(*)(u32))fnEXTIs[2])(ctEXTIs[2]); // call either an empty function or a hooked one with desired context predefined (if context missing... error)
-    else EXTI->PR |= (1<<2);  // clear the pending flag
-    NVIC_ReleasePendingIRQ(EXTI2_IRQn);
-  if(fnPostNVICs[EXTI2_IRQn]) ((u32(*)(u32))fnPostNVICs[EXTI2_IRQn])((u32)&NVIC_Stats[EXTI2_IRQn]); // call either an empty function or a hooked one with desired context predefined (if context missing... error)
-}
+NVIC_VECTOR(EXTI2, SebEXTI2)
 #endif
 #ifdef SebEXTI3
-__irq void EXTI3_IRQHandler(void) {//  EXTI3_IRQn                  = 9,      /*!< EXTI Line3 Interrupt                                              */
-  if(fnPreNVICs[EXTI3_IRQn]) ((u32(*)(u32))fnPreNVICs[EXTI3_IRQn])((u32)&NVIC_Stats[EXTI3_IRQn]); // call either an empty function or a hooked one with desired context predefined (if context missing... error)
-    if(fnEXTIs[3]) ((u32(*)(u32))fnEXTIs[3])(ctEXTIs[3]); // call either an empty function or a hooked one with desired context predefined (if context missing... error)
-    else EXTI->PR |= (1<<3);  // clear the pending flag
-    NVIC_ReleasePendingIRQ(EXTI3_IRQn);
-  if(fnPostNVICs[EXTI3_IRQn]) ((u32(*)(u32))fnPostNVICs[EXTI3_IRQn])((u32)&NVIC_Stats[EXTI3_IRQn]); // call either an empty function or a hooked one with desired context predefined (if context missing... error)
-}
+NVIC_VECTOR(EXTI3, SebEXTI3)
 #endif
 #ifdef SebEXTI4
-__irq void EXTI4_IRQHandler(void) {//  EXTI4_IRQn                  = 10,     /*!< EXTI Line4 Interrupt                                              */
-  if(fnPreNVICs[EXTI4_IRQn]) ((u32(*)(u32))fnPreNVICs[EXTI4_IRQn])((u32)&NVIC_Stats[EXTI4_IRQn]); // call either an empty function or a hooked one with desired context predefined (if context missing... error)
-    if(fnEXTIs[4]) ((u32(*)(u32))fnEXTIs[4])(ctEXTIs[4]); // call either an empty function or a hooked one with desired context predefined (if context missing... error)
-    else EXTI->PR |= (1<<4);  // clear the pending flag
-    NVIC_ReleasePendingIRQ(EXTI4_IRQn);
-  if(fnPostNVICs[EXTI4_IRQn]) ((u32(*)(u32))fnPostNVICs[EXTI4_IRQn])((u32)&NVIC_Stats[EXTI4_IRQn]); // call either an empty function or a hooked one with desired context predefined (if context missing... error)
-}
+NVIC_VECTOR(EXTI4, SebEXTI4)
 #endif
-
 #ifdef SebDMA1_Stream0
-__irq void DMA1_Stream0_IRQHandler(void) {//  DMA1_Stream0_IRQn           = 11,     /*!< DMA1 Stream 0 global Interrupt                                    */
-  if(fnPreNVICs[DMA1_Stream0_IRQn]) ((u32(*)(u32))fnPreNVICs[DMA1_Stream0_IRQn])((u32)&NVIC_Stats[DMA1_Stream0_IRQn]); // call either an empty function or a hooked one with desired context predefined (if context missing... error)
-    if(fnDMA1s[0]) ((u32(*)(u32))fnDMA1s[0])(ctDMA1s[0]); // call either an empty function or a hooked one with desired context predefined (if context missing... error)
-    else while(1);//TODO clear the pending flag EXTI->PR |= (1<<10);  // clear the pending flag
-  if(fnPostNVICs[DMA1_Stream0_IRQn]) ((u32(*)(u32))fnPostNVICs[DMA1_Stream0_IRQn])((u32)&NVIC_Stats[DMA1_Stream0_IRQn]); // call either an empty function or a hooked one with desired context predefined (if context missing... error)
-}
+NVIC_VECTOR(DMA1_Stream0, SebDMA1_Stream0)
 #endif
 #ifdef SebDMA1_Stream1
-__irq void DMA1_Stream1_IRQHandler(void) {//  DMA1_Stream1_IRQn           = 12,     /*!< DMA1 Stream 1 global Interrupt                                    */
-  if(fnPreNVICs[DMA1_Stream1_IRQn]) ((u32(*)(u32))fnPreNVICs[DMA1_Stream1_IRQn])((u32)&NVIC_Stats[DMA1_Stream1_IRQn]); // call either an empty function or a hooked one with desired context predefined (if context missing... error)
-    if(fnDMA1s[1]) ((u32(*)(u32))fnDMA1s[1])(ctDMA1s[1]); // call either an empty function or a hooked one with desired context predefined (if context missing... error)
-    else while(1);//TODO clear the pending flag EXTI->PR |= (1<<10);  // clear the pending flag
-  if(fnPostNVICs[DMA1_Stream1_IRQn]) ((u32(*)(u32))fnPostNVICs[DMA1_Stream1_IRQn])((u32)&NVIC_Stats[DMA1_Stream1_IRQn]); // call either an empty function or a hooked one with desired context predefined (if context missing... error)
-}
+NVIC_VECTOR(DMA1_Stream1, SebDMA1_Stream1)
 #endif
 #ifdef SebDMA1_Stream2
-__irq void DMA1_Stream2_IRQHandler(void) {//  DMA1_Stream2_IRQn           = 13,     /*!< DMA1 Stream 2 global Interrupt                                    */
-  if(fnPreNVICs[DMA1_Stream2_IRQn]) ((u32(*)(u32))fnPreNVICs[DMA1_Stream2_IRQn])((u32)&NVIC_Stats[DMA1_Stream2_IRQn]); // call either an empty function or a hooked one with desired context predefined (if context missing... error)
-    if(fnDMA1s[2]) ((u32(*)(u32))fnDMA1s[2])(ctDMA1s[2]); // call either an empty function or a hooked one with desired context predefined (if context missing... error)
-    else while(1);//TODO clear the pending flag EXTI->PR |= (1<<10);  // clear the pending flag
-  if(fnPostNVICs[DMA1_Stream2_IRQn]) ((u32(*)(u32))fnPostNVICs[DMA1_Stream2_IRQn])((u32)&NVIC_Stats[DMA1_Stream2_IRQn]); // call either an empty function or a hooked one with desired context predefined (if context missing... error)
-}
+NVIC_VECTOR(DMA1_Stream2, SebDMA1_Stream2)
 #endif
 #ifdef SebDMA1_Stream3
-__irq void DMA1_Stream3_IRQHandler(void) {//  DMA1_Stream3_IRQn           = 14,     /*!< DMA1 Stream 3 global Interrupt                                    */
-  if(fnPreNVICs[DMA1_Stream3_IRQn]) ((u32(*)(u32))fnPreNVICs[DMA1_Stream3_IRQn])((u32)&NVIC_Stats[DMA1_Stream3_IRQn]); // call either an empty function or a hooked one with desired context predefined (if context missing... error)
-    if(fnDMA1s[3]) ((u32(*)(u32))fnDMA1s[3])(ctDMA1s[3]); // call either an empty function or a hooked one with desired context predefined (if context missing... error)
-    else while(1);//TODO clear the pending flag EXTI->PR |= (1<<10);  // clear the pending flag
-  if(fnPostNVICs[DMA1_Stream3_IRQn]) ((u32(*)(u32))fnPostNVICs[DMA1_Stream3_IRQn])((u32)&NVIC_Stats[DMA1_Stream3_IRQn]); // call either an empty function or a hooked one with desired context predefined (if context missing... error)
-}
+NVIC_VECTOR(DMA1_Stream3, SebDMA1_Stream3)
 #endif
 #ifdef SebDMA1_Stream4
-__irq void DMA1_Stream4_IRQHandler(void) {//  DMA1_Stream4_IRQn           = 15,     /*!< DMA1 Stream 4 global Interrupt                                    */
-  if(fnPreNVICs[DMA1_Stream4_IRQn]) ((u32(*)(u32))fnPreNVICs[DMA1_Stream4_IRQn])((u32)&NVIC_Stats[DMA1_Stream4_IRQn]); // call either an empty function or a hooked one with desired context predefined (if context missing... error)
-    if(fnDMA1s[4]) ((u32(*)(u32))fnDMA1s[4])(ctDMA1s[4]); // call either an empty function or a hooked one with desired context predefined (if context missing... error)
-    else while(1);//TODO clear the pending flag EXTI->PR |= (1<<10);  // clear the pending flag
-  if(fnPostNVICs[DMA1_Stream4_IRQn]) ((u32(*)(u32))fnPostNVICs[DMA1_Stream4_IRQn])((u32)&NVIC_Stats[DMA1_Stream4_IRQn]); // call either an empty function or a hooked one with desired context predefined (if context missing... error)
-}
+NVIC_VECTOR(DMA1_Stream4, SebDMA1_Stream4)
 #endif
 #ifdef SebDMA1_Stream5
-__irq void DMA1_Stream5_IRQHandler(void) {//  DMA1_Stream5_IRQn           = 16,     /*!< DMA1 Stream 5 global Interrupt                                    */
-  if(fnPreNVICs[DMA1_Stream5_IRQn]) ((u32(*)(u32))fnPreNVICs[DMA1_Stream5_IRQn])((u32)&NVIC_Stats[DMA1_Stream5_IRQn]); // call either an empty function or a hooked one with desired context predefined (if context missing... error)
-    if(fnDMA1s[5]) ((u32(*)(u32))fnDMA1s[5])(ctDMA1s[5]); // call either an empty function or a hooked one with desired context predefined (if context missing... error)
-    else while(1);//TODO clear the pending flag EXTI->PR |= (1<<10);  // clear the pending flag
-  if(fnPostNVICs[DMA1_Stream5_IRQn]) ((u32(*)(u32))fnPostNVICs[DMA1_Stream5_IRQn])((u32)&NVIC_Stats[DMA1_Stream5_IRQn]); // call either an empty function or a hooked one with desired context predefined (if context missing... error)
-}
+NVIC_VECTOR(DMA1_Stream5, SebDMA1_Stream5)
 #endif
 #ifdef SebDMA1_Stream6
-__irq void DMA1_Stream6_IRQHandler(void) {//  DMA1_Stream6_IRQn           = 17,     /*!< DMA1 Stream 6 global Interrupt                                    */
-  if(fnPreNVICs[DMA1_Stream6_IRQn]) ((u32(*)(u32))fnPreNVICs[DMA1_Stream6_IRQn])((u32)&NVIC_Stats[DMA1_Stream6_IRQn]); // call either an empty function or a hooked one with desired context predefined (if context missing... error)
-    if(fnDMA1s[6]) ((u32(*)(u32))fnDMA1s[6])(ctDMA1s[6]); // call either an empty function or a hooked one with desired context predefined (if context missing... error)
-    else while(1);//TODO clear the pending flag EXTI->PR |= (1<<10);  // clear the pending flag
-  if(fnPostNVICs[DMA1_Stream6_IRQn]) ((u32(*)(u32))fnPostNVICs[DMA1_Stream6_IRQn])((u32)&NVIC_Stats[DMA1_Stream6_IRQn]); // call either an empty function or a hooked one with desired context predefined (if context missing... error)
-}
+NVIC_VECTOR(DMA1_Stream6, SebDMA1_Stream6)
 #endif
-
 #ifdef SebADC
-__irq void ADC_IRQHandler(void) {//  ADC_IRQn                    = 18,     /*!< ADC1, ADC2 and ADC3 global Interrupts                             */
-  if(fnPreNVICs[ADC_IRQn]) ((u32(*)(u32))fnPreNVICs[ADC_IRQn])((u32)&NVIC_Stats[ADC_IRQn]); // call either an empty function or a hooked one with desired context predefined (if context missing... error)
-    if(fnADC1) ((u32(*)(u32))fnADC1)(ctADC1); // call either an empty function or a hooked one with desired context predefined (if context missing... error)
-    else while(1);//TODO clear the pending flag EXTI->PR |= (1<<10);  // clear the pending flag
-    if(fnADC2) ((u32(*)(u32))fnADC2)(ctADC2); // call either an empty function or a hooked one with desired context predefined (if context missing... error)
-    else while(1);//TODO clear the pending flag EXTI->PR |= (1<<10);  // clear the pending flag
-    if(fnADC3) ((u32(*)(u32))fnADC3)(ctADC3); // call either an empty function or a hooked one with desired context predefined (if context missing... error)
-    else while(1);//TODO clear the pending flag EXTI->PR |= (1<<10);  // clear the pending flag
-    // if all hooks are null, disable the NVIC
-    NVIC_ReleasePendingIRQ(ADC_IRQn);
-  if(fnPostNVICs[ADC_IRQn]) ((u32(*)(u32))fnPostNVICs[ADC_IRQn])((u32)&NVIC_Stats[ADC_IRQn]); // call either an empty function or a hooked one with desired context predefined (if context missing... error)
-}
+NVIC_VECTOR(ADC, SebADC)
 #endif
-
 #ifdef SebCAN1_TX
-__irq void CAN1_TX_IRQHandler(void) {//  CAN1_TX_IRQn                = 19,     /*!< CAN1 TX Interrupt                                                 */
-  if(fnPreNVICs[CAN1_TX_IRQn]) ((u32(*)(u32))fnPreNVICs[CAN1_TX_IRQn])((u32)&NVIC_Stats[CAN1_TX_IRQn]); // call either an empty function or a hooked one with desired context predefined (if context missing... error)
-    if(fnCAN1_TX) ((u32(*)(u32))fnCAN1_TX)(ctCAN1_TX); // call either an empty function or a hooked one with desired context predefined (if context missing... error)
-    else while(1);//TODO clear the pending flag EXTI->PR |= (1<<10);  // clear the pending flag
-  if(fnPostNVICs[CAN1_TX_IRQn]) ((u32(*)(u32))fnPostNVICs[CAN1_TX_IRQn])((u32)&NVIC_Stats[CAN1_TX_IRQn]); // call either an empty function or a hooked one with desired context predefined (if context missing... error)
-}
+NVIC_VECTOR(CAN1_TX, SebCAN1_TX)
 #endif
 #ifdef SebCAN1_RX0
-__irq void CAN1_RX0_IRQHandler(void) {//  CAN1_RX0_IRQn               = 20,     /*!< CAN1 RX0 Interrupt                                                */
-  if(fnPreNVICs[CAN1_RX0_IRQn]) ((u32(*)(u32))fnPreNVICs[CAN1_RX0_IRQn])((u32)&NVIC_Stats[CAN1_RX0_IRQn]); // call either an empty function or a hooked one with desired context predefined (if context missing... error)
-    if(fnCAN1_RX0) ((u32(*)(u32))fnCAN1_RX0)(ctCAN1_RX0); // call either an empty function or a hooked one with desired context predefined (if context missing... error)
-    else while(1);//TODO clear the pending flag EXTI->PR |= (1<<10);  // clear the pending flag
-  if(fnPostNVICs[CAN1_RX0_IRQn]) ((u32(*)(u32))fnPostNVICs[CAN1_RX0_IRQn])((u32)&NVIC_Stats[CAN1_RX0_IRQn]); // call either an empty function or a hooked one with desired context predefined (if context missing... error)
-}
+NVIC_VECTOR(CAN1_RX0, SebCAN1_RX0)
 #endif
 #ifdef SebCAN1_RX1
-__irq void CAN1_RX1_IRQHandler(void) {//  CAN1_RX1_IRQn               = 21,     /*!< CAN1 RX1 Interrupt                                                */
-  if(fnPreNVICs[CAN1_RX1_IRQn]) ((u32(*)(u32))fnPreNVICs[CAN1_RX1_IRQn])((u32)&NVIC_Stats[CAN1_RX1_IRQn]); // call either an empty function or a hooked one with desired context predefined (if context missing... error)
-    if(fnCAN1_RX1) ((u32(*)(u32))fnCAN1_RX1)(ctCAN1_RX1); // call either an empty function or a hooked one with desired context predefined (if context missing... error)
-    else while(1);//TODO clear the pending flag EXTI->PR |= (1<<10);  // clear the pending flag
-  if(fnPostNVICs[CAN1_RX1_IRQn]) ((u32(*)(u32))fnPostNVICs[CAN1_RX1_IRQn])((u32)&NVIC_Stats[CAN1_RX1_IRQn]); // call either an empty function or a hooked one with desired context predefined (if context missing... error)
-}
+NVIC_VECTOR(CAN1_RX1, SebCAN1_RX1)
 #endif
 #ifdef SebCAN1_SCE
-__irq void CAN1_SCE_IRQHandler(void) {//  CAN1_SCE_IRQn               = 22,     /*!< CAN1 SCE Interrupt                                                */
-  if(fnPreNVICs[CAN1_SCE_IRQn]) ((u32(*)(u32))fnPreNVICs[CAN1_SCE_IRQn])((u32)&NVIC_Stats[CAN1_SCE_IRQn]); // call either an empty function or a hooked one with desired context predefined (if context missing... error)
-    if(fnCAN1_SCE) ((u32(*)(u32))fnCAN1_SCE)(ctCAN1_SCE); // call either an empty function or a hooked one with desired context predefined (if context missing... error)
-    else while(1);//TODO clear the pending flag EXTI->PR |= (1<<10);  // clear the pending flag
-  if(fnPostNVICs[CAN1_SCE_IRQn]) ((u32(*)(u32))fnPostNVICs[CAN1_SCE_IRQn])((u32)&NVIC_Stats[CAN1_SCE_IRQn]); // call either an empty function or a hooked one with desired context predefined (if context missing... error)
-}
+NVIC_VECTOR(CAN1_SCE, SebCAN1_SCE)
 #endif
-
 #ifdef SebEXTI9_5
-__irq void EXTI9_5_IRQHandler(void) {//  EXTI9_5_IRQn                = 23,     /*!< External Line[9:5] Interrupts                                     */
-  if(fnPreNVICs[EXTI9_5_IRQn]) ((u32(*)(u32))fnPreNVICs[EXTI9_5_IRQn])((u32)&NVIC_Stats[EXTI9_5_IRQn]); // call either an empty function or a hooked one with desired context predefined (if context missing... error)
-    if(fnEXTIs[5]) ((u32(*)(u32))fnEXTIs[5])(ctEXTIs[5]); // call either an empty function or a hooked one with desired context predefined (if context missing... error)
-    else EXTI->PR |= (1<<5); // clear the signal causing the interrupt when no handler
-    if(fnEXTIs[6]) ((u32(*)(u32))fnEXTIs[6])(ctEXTIs[6]); // call either an empty function or a hooked one with desired context predefined (if context missing... error)
-    else EXTI->PR |= (1<<6); // clear the signal causing the interrupt when no handler
-    if(fnEXTIs[7]) ((u32(*)(u32))fnEXTIs[7])(ctEXTIs[7]); // call either an empty function or a hooked one with desired context predefined (if context missing... error)
-    else EXTI->PR |= (1<<7); // clear the signal causing the interrupt when no handler
-    if(fnEXTIs[8]) ((u32(*)(u32))fnEXTIs[8])(ctEXTIs[8]); // call either an empty function or a hooked one with desired context predefined (if context missing... error)
-    else EXTI->PR |= (1<<8); // clear the signal causing the interrupt when no handler
-    if(fnEXTIs[9]) ((u32(*)(u32))fnEXTIs[9])(ctEXTIs[9]); // call either an empty function or a hooked one with desired context predefined (if context missing... error)
-    else EXTI->PR |= (1<<9); // clear the signal causing the interrupt when no handler
-    NVIC_ReleasePendingIRQ(EXTI9_5_IRQn);
-  if(fnPostNVICs[EXTI9_5_IRQn]) ((u32(*)(u32))fnPostNVICs[EXTI9_5_IRQn])((u32)&NVIC_Stats[EXTI9_5_IRQn]); // call either an empty function or a hooked one with desired context predefined (if context missing... error)
-}
+NVIC_VECTOR(EXTI9_5, SebEXTI9_5)
 #endif
-
 #ifdef SebTIM1_BRK_TIM9
-__irq void TIM1_BRK_TIM9_IRQHandler(void) {//  TIM1_BRK_TIM9_IRQn          = 24,     /*!< TIM1 Break interrupt and TIM9 global interrupt                    */
-  if(fnPreNVICs[TIM1_BRK_TIM9_IRQn]) ((u32(*)(u32))fnPreNVICs[TIM1_BRK_TIM9_IRQn])((u32)&NVIC_Stats[TIM1_BRK_TIM9_IRQn]); // call either an empty function or a hooked one with desired context predefined (if context missing... error)
-  
-    if((TIM9->SR & TIM9->DIER) & (TIM_FLAG_Update || TIM_FLAG_CC1 || TIM_FLAG_CC2)) {// if there is a pending interrupt for TIM9
-      if(fnTIM9) ((u32(*)(u32))fnTIM9)(ctTIM9); // call either an empty function or a hooked one with desired context predefined (if context missing... error)
-      else while(1);//TODO clear the pending flag EXTI->PR |= (1<<10);  // clear the pending flag
-    }else{ // TIM1_BRK
-      if(fnTIM1_BRK) ((u32(*)(u32))fnTIM1_BRK)(ctTIM1_BRK); // call either an empty function or a hooked one with desired context predefined (if context missing... error)
-      else while(1);//TODO clear the pending flag EXTI->PR |= (1<<10);  // clear the pending flag
-    };
-  
-  if(fnPostNVICs[TIM1_BRK_TIM9_IRQn]) ((u32(*)(u32))fnPostNVICs[TIM1_BRK_TIM9_IRQn])((u32)&NVIC_Stats[TIM1_BRK_TIM9_IRQn]); // call either an empty function or a hooked one with desired context predefined (if context missing... error)
-}
+NVIC_VECTOR(TIM1_BRK_TIM9, SebTIM1_BRK_TIM9)
 #endif
-
 #ifdef SebTIM1_UP_TIM10
-__irq void TIM1_UP_TIM10_IRQHandler(void) {//  TIM1_UP_TIM10_IRQn          = 25,     /*!< TIM1 Update Interrupt and TIM10 global interrupt                  */
-  if(fnPreNVICs[TIM1_UP_TIM10_IRQn]) ((u32(*)(u32))fnPreNVICs[TIM1_UP_TIM10_IRQn])((u32)&NVIC_Stats[TIM1_UP_TIM10_IRQn]); // call either an empty function or a hooked one with desired context predefined (if context missing... error)
-  
-  // Sort out the interrupt source, is it from TIM10 or TIM1_UP? Should be XOR or OR processing here? (ifelse or ifif)
-    if((TIM10->SR & TIM10->DIER) & (TIM_FLAG_Update || TIM_FLAG_CC1)) {// if there is a pending interrupt for TIM10, process TIM10
-      if(fnTIM10) ((u32(*)(u32))fnTIM10)(ctTIM10); // call either an empty function or a hooked one with desired context predefined (if context missing... error)
-      else while(1);//TODO clear the pending flag EXTI->PR |= (1<<10);  // clear the pending flag
-    }else{ // TIM1_UP
-      if(fnTIM1_UP) ((u32(*)(u32))fnTIM1_UP)(ctTIM1_UP); // call either an empty function or a hooked one with desired context predefined (if context missing... error)
-      else while(1);//TODO clear the pending flag EXTI->PR |= (1<<10);  // clear the pending flag
-    };
-    
-  if(fnPostNVICs[TIM1_UP_TIM10_IRQn]) ((u32(*)(u32))fnPostNVICs[TIM1_UP_TIM10_IRQn])((u32)&NVIC_Stats[TIM1_UP_TIM10_IRQn]); // call either an empty function or a hooked one with desired context predefined (if context missing... error)
-}
+NVIC_VECTOR(TIM1_UP_TIM10, SebTIM1_UP_TIM10)
 #endif
-
 #ifdef SebTIM1_TRG_COM_TIM11
-__irq void TIM1_TRG_COM_TIM11_IRQHandler(void) {//  TIM1_TRG_COM_TIM11_IRQn     = 26,     /*!< TIM1 Trigger and Commutation Interrupt and TIM11 global interrupt */
-  if(fnPreNVICs[TIM1_TRG_COM_TIM11_IRQn]) ((u32(*)(u32))fnPreNVICs[TIM1_TRG_COM_TIM11_IRQn])((u32)&NVIC_Stats[TIM1_TRG_COM_TIM11_IRQn]); // call either an empty function or a hooked one with desired context predefined (if context missing... error)
-  
-    if((TIM11->SR & TIM11->DIER) & (TIM_FLAG_Update || TIM_FLAG_CC1)) {// if there is a pending interrupt for TIM9
-      if(fnTIM11) ((u32(*)(u32))fnTIM11)(ctTIM11); // call either an empty function or a hooked one with desired context predefined (if context missing... error)
-      else while(1);//TODO clear the pending flag EXTI->PR |= (1<<10);  // clear the pending flag
-    }else{ // TIM1_TRG
-      if(fnTIM1_TRG) ((u32(*)(u32))fnTIM1_TRG)(ctTIM1_TRG); // call either an empty function or a hooked one with desired context predefined (if context missing... error)
-      else while(1);//TODO clear the pending flag EXTI->PR |= (1<<10);  // clear the pending flag
-    };
-  
-  if(fnPostNVICs[TIM1_TRG_COM_TIM11_IRQn]) ((u32(*)(u32))fnPostNVICs[TIM1_TRG_COM_TIM11_IRQn])((u32)&NVIC_Stats[TIM1_TRG_COM_TIM11_IRQn]); // call either an empty function or a hooked one with desired context predefined (if context missing... error)
-}
+NVIC_VECTOR(TIM1_TRG_COM_TIM11, SebTIM1_TRG_COM_TIM11)
 #endif
-
 #ifdef SebTIM1_CC
-__irq void TIM1_CC_IRQHandler(void) {//  TIM1_CC_IRQn                = 27,     /*!< TIM1 Capture Compare Interrupt                                    */
-  if(fnPreNVICs[TIM1_CC_IRQn]) ((u32(*)(u32))fnPreNVICs[TIM1_CC_IRQn])((u32)&NVIC_Stats[TIM1_CC_IRQn]); // call either an empty function or a hooked one with desired context predefined (if context missing... error)
-    if(fnTIM1_CC) ((u32(*)(u32))fnTIM1_CC)(ctTIM1_CC); // call either an empty function or a hooked one with desired context predefined (if context missing... error)
-    else while(1);//TODO clear the pending flag EXTI->PR |= (1<<10);  // clear the pending flag
-  if(fnPostNVICs[TIM1_CC_IRQn]) ((u32(*)(u32))fnPostNVICs[TIM1_CC_IRQn])((u32)&NVIC_Stats[TIM1_CC_IRQn]); // call either an empty function or a hooked one with desired context predefined (if context missing... error)
-}
+NVIC_VECTOR(TIM1_CC, SebTIM1_CC)
 #endif
-
 #ifdef SebTIM2
-__irq void TIM2_IRQHandler(void) {//  TIM2_IRQn                   = 28,     /*!< TIM2 global Interrupt                                             */
-  if(fnPreNVICs[TIM2_IRQn]) ((u32(*)(u32))fnPreNVICs[TIM2_IRQn])((u32)&NVIC_Stats[TIM2_IRQn]); // call either an empty function or a hooked one with desired context predefined (if context missing... error)
-    if(fnTIM2) ((u32(*)(u32))fnTIM2)(ctTIM2); // call either an empty function or a hooked one with desired context predefined (if context missing... error)
-    else while(1);//TODO clear the pending flag EXTI->PR |= (1<<10);  // clear the pending flag
-  if(fnPostNVICs[TIM2_IRQn]) ((u32(*)(u32))fnPostNVICs[TIM2_IRQn])((u32)&NVIC_Stats[TIM2_IRQn]); // call either an empty function or a hooked one with desired context predefined (if context missing... error)
-}
+NVIC_VECTOR(TIM2, SebTIM2)
 #endif
 #ifdef SebTIM3
-__irq void TIM3_IRQHandler(void) {//  TIM3_IRQn                   = 29,     /*!< TIM3 global Interrupt                                             */
-  if(fnPreNVICs[TIM3_IRQn]) ((u32(*)(u32))fnPreNVICs[TIM3_IRQn])((u32)&NVIC_Stats[TIM3_IRQn]); // call either an empty function or a hooked one with desired context predefined (if context missing... error)
-    if(fnTIM3) ((u32(*)(u32))fnTIM3)(ctTIM3); // call either an empty function or a hooked one with desired context predefined (if context missing... error)
-    else while(1);//TODO clear the pending flag EXTI->PR |= (1<<10);  // clear the pending flag
-  if(fnPostNVICs[TIM3_IRQn]) ((u32(*)(u32))fnPostNVICs[TIM3_IRQn])((u32)&NVIC_Stats[TIM3_IRQn]); // call either an empty function or a hooked one with desired context predefined (if context missing... error)
-}
+NVIC_VECTOR(TIM3, SebTIM3)
 #endif
 #ifdef SebTIM4
-__irq void TIM4_IRQHandler(void) {//  TIM4_IRQn                   = 30,     /*!< TIM4 global Interrupt                                             */
-  if(fnPreNVICs[TIM4_IRQn]) ((u32(*)(u32))fnPreNVICs[TIM4_IRQn])((u32)&NVIC_Stats[TIM4_IRQn]); // call either an empty function or a hooked one with desired context predefined (if context missing... error)
-    if(fnTIM4) ((u32(*)(u32))fnTIM4)(ctTIM4); // call either an empty function or a hooked one with desired context predefined (if context missing... error)
-    else while(1);//TODO clear the pending flag EXTI->PR |= (1<<10);  // clear the pending flag
-  if(fnPostNVICs[TIM4_IRQn]) ((u32(*)(u32))fnPostNVICs[TIM4_IRQn])((u32)&NVIC_Stats[TIM4_IRQn]); // call either an empty function or a hooked one with desired context predefined (if context missing... error)
-}
+NVIC_VECTOR(TIM4, SebTIM4)
 #endif
-
 #ifdef SebI2C1_EV
-__irq void I2C1_EV_IRQHandler(void) {//  I2C1_EV_IRQn                = 31,     /*!< I2C1 Event Interrupt                                              */
-  if(fnPreNVICs[I2C1_EV_IRQn]) ((u32(*)(u32))fnPreNVICs[I2C1_EV_IRQn])((u32)&NVIC_Stats[I2C1_EV_IRQn]); // call either an empty function or a hooked one with desired context predefined (if context missing... error)
-    if(fnI2C1_EV) ((u32(*)(u32))fnI2C1_EV)(ctI2C1_EV); // call either an empty function or a hooked one with desired context predefined (if context missing... error)
-    else while(1);//TODO clear the pending flag EXTI->PR |= (1<<10);  // clear the pending flag
-  if(fnPostNVICs[I2C1_EV_IRQn]) ((u32(*)(u32))fnPostNVICs[I2C1_EV_IRQn])((u32)&NVIC_Stats[I2C1_EV_IRQn]); // call either an empty function or a hooked one with desired context predefined (if context missing... error)
-}
+NVIC_VECTOR(I2C1_EV, SebI2C1_EV)
 #endif
-
 #ifdef SebI2C1_ER
-__irq void I2C1_ER_IRQHandler(void) {//  I2C1_ER_IRQn                = 32,     /*!< I2C1 Error Interrupt                                              */
-  if(fnPreNVICs[I2C1_ER_IRQn]) ((u32(*)(u32))fnPreNVICs[I2C1_ER_IRQn])((u32)&NVIC_Stats[I2C1_ER_IRQn]); // call either an empty function or a hooked one with desired context predefined (if context missing... error)
-    if(fnI2C1_ER) ((u32(*)(u32))fnI2C1_ER)(ctI2C1_ER); // call either an empty function or a hooked one with desired context predefined (if context missing... error)
-    else while(1);//TODO clear the pending flag EXTI->PR |= (1<<10);  // clear the pending flag
-  if(fnPostNVICs[I2C1_ER_IRQn]) ((u32(*)(u32))fnPostNVICs[I2C1_ER_IRQn])((u32)&NVIC_Stats[I2C1_ER_IRQn]); // call either an empty function or a hooked one with desired context predefined (if context missing... error)
-}
+NVIC_VECTOR(I2C1_ER, SebI2C1_ER)
 #endif
 #ifdef SebI2C2_EV
-__irq void I2C2_EV_IRQHandler(void) {//  I2C2_EV_IRQn                = 33,     /*!< I2C2 Event Interrupt                                              */
-  if(fnPreNVICs[I2C2_EV_IRQn]) ((u32(*)(u32))fnPreNVICs[I2C2_EV_IRQn])((u32)&NVIC_Stats[I2C2_EV_IRQn]); // call either an empty function or a hooked one with desired context predefined (if context missing... error)
-    if(fnI2C2_EV) ((u32(*)(u32))fnI2C2_EV)(ctI2C2_EV); // call either an empty function or a hooked one with desired context predefined (if context missing... error)
-    else while(1);//TODO clear the pending flag EXTI->PR |= (1<<10);  // clear the pending flag
-  if(fnPostNVICs[I2C2_EV_IRQn]) ((u32(*)(u32))fnPostNVICs[I2C2_EV_IRQn])((u32)&NVIC_Stats[I2C2_EV_IRQn]); // call either an empty function or a hooked one with desired context predefined (if context missing... error)
-}
+NVIC_VECTOR(I2C2_EV, SebI2C2_EV)
 #endif
 #ifdef SebI2C2_ER
-__irq void I2C2_ER_IRQHandler(void) {//  I2C2_ER_IRQn                = 34,     /*!< I2C2 Error Interrupt                                              */
-  if(fnPreNVICs[I2C2_ER_IRQn]) ((u32(*)(u32))fnPreNVICs[I2C2_ER_IRQn])((u32)&NVIC_Stats[I2C2_ER_IRQn]); // call either an empty function or a hooked one with desired context predefined (if context missing... error)
-    if(fnI2C2_ER) ((u32(*)(u32))fnI2C2_ER)(ctI2C2_ER); // call either an empty function or a hooked one with desired context predefined (if context missing... error)
-    else while(1);//TODO clear the pending flag EXTI->PR |= (1<<10);  // clear the pending flag
-  if(fnPostNVICs[I2C2_ER_IRQn]) ((u32(*)(u32))fnPostNVICs[I2C2_ER_IRQn])((u32)&NVIC_Stats[I2C2_ER_IRQn]); // call either an empty function or a hooked one with desired context predefined (if context missing... error)
-}
+NVIC_VECTOR(I2C2_ER, SebI2C2_ER)
 #endif
-
 #ifdef SebSPI1
-__irq void SPI1_IRQHandler(void) {//  SPI1_IRQn                   = 35,     /*!< SPI1 global Interrupt                                             */
-  if(fnPreNVICs[SPI1_IRQn]) ((u32(*)(u32))fnPreNVICs[SPI1_IRQn])((u32)&NVIC_Stats[SPI1_IRQn]); // call either an empty function or a hooked one with desired context predefined (if context missing... error)
-    if(fnSPI1) ((u32(*)(u32))fnSPI1)(ctSPI1); // call either an empty function or a hooked one with desired context predefined (if context missing... error)
-    else while(1);//TODO clear the pending flag EXTI->PR |= (1<<10);  // clear the pending flag
-  if(fnPostNVICs[SPI1_IRQn]) ((u32(*)(u32))fnPostNVICs[SPI1_IRQn])((u32)&NVIC_Stats[SPI1_IRQn]); // call either an empty function or a hooked one with desired context predefined (if context missing... error)
-}
+NVIC_VECTOR(SPI1, SebSPI1)
 #endif
 #ifdef SebSPI2
-__irq void SPI2_IRQHandler(void) {//  SPI2_IRQn                   = 36,     /*!< SPI2 global Interrupt                                             */
-  if(fnPreNVICs[SPI2_IRQn]) ((u32(*)(u32))fnPreNVICs[SPI2_IRQn])((u32)&NVIC_Stats[SPI2_IRQn]); // call either an empty function or a hooked one with desired context predefined (if context missing... error)
-    if(fnSPI2) ((u32(*)(u32))fnSPI2)(ctSPI2); // call either an empty function or a hooked one with desired context predefined (if context missing... error)
-    else while(1);//TODO clear the pending flag EXTI->PR |= (1<<10);  // clear the pending flag
-  if(fnPostNVICs[SPI2_IRQn]) ((u32(*)(u32))fnPostNVICs[SPI2_IRQn])((u32)&NVIC_Stats[SPI2_IRQn]); // call either an empty function or a hooked one with desired context predefined (if context missing... error)
-}
+NVIC_VECTOR(SPI2, SebSPI2)
 #endif
-
 #ifdef SebUSART1
-__irq void USART1_IRQHandler(void) {//  USART1_IRQn                 = 37,     /*!< USART1 global Interrupt                                           */
-  if(fnPreNVICs[USART1_IRQn]) ((u32(*)(u32))fnPreNVICs[USART1_IRQn])((u32)&NVIC_Stats[USART1_IRQn]); // call either an empty function or a hooked one with desired context predefined (if context missing... error)
-    if(fnUSART1) ((u32(*)(u32))fnUSART1)(ctUSART1); // call either an empty function or a hooked one with desired context predefined (if context missing... error)
-    else { // clear the pending flag
-      if((USART1->CR1 & USART_FLAG_TXE)&&(USART1->SR & USART_FLAG_TXE)) // if ready to transmit by interrupt... send a dummy! Write to DR
-          USART1->DR = lpUSART1; // LF ASCII char, will clear the interrupt
-      else lpUSART1 = USART1->DR;   // dummy read of the data to clear the pending interrupt, this will clear PE, RXNE and FE bits (this will route RX back to TX)
-    }
-  if(fnPostNVICs[USART1_IRQn]) ((u32(*)(u32))fnPostNVICs[USART1_IRQn])((u32)&NVIC_Stats[USART1_IRQn]); // call either an empty function or a hooked one with desired context predefined (if context missing... error)
-}
+NVIC_VECTOR(USART1, SebUSART1)
 #endif
 #ifdef SebUSART2
-__irq void USART2_IRQHandler(void) {//  USART2_IRQn                 = 38,     /*!< USART2 global Interrupt                                           */
-  if(fnPreNVICs[USART2_IRQn]) ((u32(*)(u32))fnPreNVICs[USART2_IRQn])((u32)&NVIC_Stats[USART2_IRQn]); // call either an empty function or a hooked one with desired context predefined (if context missing... error)
-    if(fnUSART2) ((u32(*)(u32))fnUSART2)(ctUSART2); // call either an empty function or a hooked one with desired context predefined (if context missing... error)
-    else while(1);//TODO clear the pending flag EXTI->PR |= (1<<10);  // clear the pending flag
-  if(fnPostNVICs[USART2_IRQn]) ((u32(*)(u32))fnPostNVICs[USART2_IRQn])((u32)&NVIC_Stats[USART2_IRQn]); // call either an empty function or a hooked one with desired context predefined (if context missing... error)
-}
+NVIC_VECTOR(USART2, SebUSART2)
 #endif
 #ifdef SebUSART3
-__irq void USART3_IRQHandler(void) {//  USART3_IRQn                 = 39,     /*!< USART3 global Interrupt                                           */
-  if(fnPreNVICs[USART3_IRQn]) ((u32(*)(u32))fnPreNVICs[USART3_IRQn])((u32)&NVIC_Stats[USART3_IRQn]); // call either an empty function or a hooked one with desired context predefined (if context missing... error)
-    if(fnUSART3) ((u32(*)(u32))fnUSART3)(ctUSART3); // call either an empty function or a hooked one with desired context predefined (if context missing... error)
-    else while(1);//TODO clear the pending flag EXTI->PR |= (1<<10);  // clear the pending flag
-  if(fnPostNVICs[USART3_IRQn]) ((u32(*)(u32))fnPostNVICs[USART3_IRQn])((u32)&NVIC_Stats[USART3_IRQn]); // call either an empty function or a hooked one with desired context predefined (if context missing... error)
-}
+NVIC_VECTOR(USART3, SebUSART3)
 #endif
-
 #ifdef SebEXTI15_10
-__irq void EXTI15_10_IRQHandler(void) {//  EXTI15_10_IRQn              = 40,     /*!< External Line[15:10] Interrupts                                   */
-//  Set_LED_7(0);
-  if(fnPreNVICs[EXTI15_10_IRQn]) ((u32(*)(u32))fnPreNVICs[EXTI15_10_IRQn])((u32)&NVIC_Stats[EXTI15_10_IRQn]); // call either an empty function or a hooked one with desired context predefined (if context missing... error)
-    if(fnEXTIs[10]) ((u32(*)(u32))fnEXTIs[10])(ctEXTIs[10]); // call either an empty function or a hooked one with desired context predefined (if context missing... error)
-    else EXTI->PR |= (1<<10); // clear the signal causing the interrupt when no handler
-    if(fnEXTIs[11]) ((u32(*)(u32))fnEXTIs[11])(ctEXTIs[11]); // call either an empty function or a hooked one with desired context predefined (if context missing... error)
-    else EXTI->PR |= (1<<11); // clear the signal causing the interrupt when no handler
-    if(fnEXTIs[12]) ((u32(*)(u32))fnEXTIs[12])(ctEXTIs[12]); // call either an empty function or a hooked one with desired context predefined (if context missing... error)
-    else EXTI->PR |= (1<<12); // clear the signal causing the interrupt when no handler
-    if(fnEXTIs[13]) ((u32(*)(u32))fnEXTIs[13])(ctEXTIs[13]); // call either an empty function or a hooked one with desired context predefined (if context missing... error)
-    else EXTI->PR |= (1<<13); // clear the signal causing the interrupt when no handler
-    if(fnEXTIs[14]) ((u32(*)(u32))fnEXTIs[14])(ctEXTIs[14]); // call either an empty function or a hooked one with desired context predefined (if context missing... error)
-    else EXTI->PR |= (1<<14); // clear the signal causing the interrupt when no handler
-    if(fnEXTIs[15]) ((u32(*)(u32))fnEXTIs[15])(ctEXTIs[15]); // call either an empty function or a hooked one with desired context predefined (if context missing... error)
-    else EXTI->PR |= (1<<15); // clear the signal causing the interrupt when no handler
-    NVIC_ReleasePendingIRQ(EXTI15_10_IRQn);
-  if(fnPostNVICs[EXTI15_10_IRQn]) ((u32(*)(u32))fnPostNVICs[EXTI15_10_IRQn])((u32)&NVIC_Stats[EXTI15_10_IRQn]); // call either an empty function or a hooked one with desired context predefined (if context missing... error)
-//  Set_LED_7(1);
-}
+NVIC_VECTOR(EXTI15_10, SebEXTI15_10)
 #endif
-
 #ifdef SebRTC_Alarm
-__irq void RTC_Alarm_IRQHandler(void) {//  RTC_Alarm_IRQn              = 41,     /*!< RTC Alarm (A and B) through EXTI Line Interrupt                   */
-  if(fnPreNVICs[RTC_Alarm_IRQn]) ((u32(*)(u32))fnPreNVICs[RTC_Alarm_IRQn])((u32)&NVIC_Stats[RTC_Alarm_IRQn]); // call either an empty function or a hooked one with desired context predefined (if context missing... error)
-    if(fnRTC_Alarm) ((u32(*)(u32))fnRTC_Alarm)(ctRTC_Alarm); // call either an empty function or a hooked one with desired context predefined (if context missing... error)
-    else while(1);//TODO clear the pending flag EXTI->PR |= (1<<10);  // clear the pending flag
-  if(fnPostNVICs[RTC_Alarm_IRQn]) ((u32(*)(u32))fnPostNVICs[RTC_Alarm_IRQn])((u32)&NVIC_Stats[RTC_Alarm_IRQn]); // call either an empty function or a hooked one with desired context predefined (if context missing... error)
-}
+NVIC_VECTOR(RTC_Alarm, SebRTC_Alarm)
 #endif
-
 #ifdef SebOTG_FS_WKUP
-__irq void OTG_FS_WKUP_IRQHandler(void) {//  OTG_FS_WKUP_IRQn            = 42,     /*!< USB OTG FS Wakeup through EXTI line interrupt                     */
-  if(fnPreNVICs[OTG_FS_WKUP_IRQn]) ((u32(*)(u32))fnPreNVICs[OTG_FS_WKUP_IRQn])((u32)&NVIC_Stats[OTG_FS_WKUP_IRQn]); // call either an empty function or a hooked one with desired context predefined (if context missing... error)
-    if(fnOTG_FS_WKUP) ((u32(*)(u32))fnOTG_FS_WKUP)(ctOTG_FS_WKUP); // call either an empty function or a hooked one with desired context predefined (if context missing... error)
-    else while(1);//TODO clear the pending flag EXTI->PR |= (1<<10);  // clear the pending flag
-  if(fnPostNVICs[OTG_FS_WKUP_IRQn]) ((u32(*)(u32))fnPostNVICs[OTG_FS_WKUP_IRQn])((u32)&NVIC_Stats[OTG_FS_WKUP_IRQn]); // call either an empty function or a hooked one with desired context predefined (if context missing... error)
-}
+NVIC_VECTOR(OTG_FS_WKUP, SebOTG_FS_WKUP)
 #endif
-
 #ifdef SebTIM8_BRK_TIM12
-__irq void TIM8_BRK_TIM12_IRQHandler(void) {//  TIM8_BRK_TIM12_IRQn         = 43,     /*!< TIM8 Break Interrupt and TIM12 global interrupt                   */
-  if(fnPreNVICs[TIM8_BRK_TIM12_IRQn]) ((u32(*)(u32))fnPreNVICs[TIM8_BRK_TIM12_IRQn])((u32)&NVIC_Stats[TIM8_BRK_TIM12_IRQn]); // call either an empty function or a hooked one with desired context predefined (if context missing... error)
-  
-    if((TIM12->SR & TIM12->DIER) & (TIM_FLAG_Update || TIM_FLAG_CC1 || TIM_FLAG_CC2)) {// if there is a pending interrupt for TIM9
-      if(fnTIM12) ((u32(*)(u32))fnTIM12)(ctTIM12); // call either an empty function or a hooked one with desired context predefined (if context missing... error)
-      else while(1);//TODO clear the pending flag EXTI->PR |= (1<<10);  // clear the pending flag
-    }else{ // TIM1_BRK
-      if(fnTIM8_BRK) ((u32(*)(u32))fnTIM8_BRK)(ctTIM8_BRK); // call either an empty function or a hooked one with desired context predefined (if context missing... error)
-      else while(1);//TODO clear the pending flag EXTI->PR |= (1<<10);  // clear the pending flag
-    };
-  
-  if(fnPostNVICs[TIM8_BRK_TIM12_IRQn]) ((u32(*)(u32))fnPostNVICs[TIM8_BRK_TIM12_IRQn])((u32)&NVIC_Stats[TIM8_BRK_TIM12_IRQn]); // call either an empty function or a hooked one with desired context predefined (if context missing... error)
-}
+NVIC_VECTOR(TIM8_BRK_TIM12, SebTIM8_BRK_TIM12)
 #endif
 #ifdef SebTIM8_UP_TIM13
-__irq void TIM8_UP_TIM13_IRQHandler(void) {//  TIM8_UP_TIM13_IRQn          = 44,     /*!< TIM8 Update Interrupt and TIM13 global interrupt                  */
-  if(fnPreNVICs[TIM8_UP_TIM13_IRQn]) ((u32(*)(u32))fnPreNVICs[TIM8_UP_TIM13_IRQn])((u32)&NVIC_Stats[TIM8_UP_TIM13_IRQn]); // call either an empty function or a hooked one with desired context predefined (if context missing... error)
-  
-    if((TIM13->SR & TIM13->DIER) & (TIM_FLAG_Update || TIM_FLAG_CC1)) {// if there is a pending interrupt for TIM9
-      if(fnTIM13) ((u32(*)(u32))fnTIM13)(ctTIM13); // call either an empty function or a hooked one with desired context predefined (if context missing... error)
-      else while(1);//TODO clear the pending flag EXTI->PR |= (1<<10);  // clear the pending flag
-    }else{ // TIM1_BRK
-      if(fnTIM8_UP) ((u32(*)(u32))fnTIM8_UP)(ctTIM8_UP); // call either an empty function or a hooked one with desired context predefined (if context missing... error)
-      else while(1);//TODO clear the pending flag EXTI->PR |= (1<<10);  // clear the pending flag
-    };
-  
-  if(fnPostNVICs[TIM8_UP_TIM13_IRQn]) ((u32(*)(u32))fnPostNVICs[TIM8_UP_TIM13_IRQn])((u32)&NVIC_Stats[TIM8_UP_TIM13_IRQn]); // call either an empty function or a hooked one with desired context predefined (if context missing... error)
-}
+NVIC_VECTOR(TIM8_UP_TIM13, SebTIM8_UP_TIM13)
 #endif
 #ifdef SebTIM8_TRG_COM_TIM14
-__irq void TIM8_TRG_COM_TIM14_IRQHandler(void) {//  TIM8_TRG_COM_TIM14_IRQn     = 45,     /*!< TIM8 Trigger and Commutation Interrupt and TIM14 global interrupt */
-  if(fnPreNVICs[TIM8_TRG_COM_TIM14_IRQn]) ((u32(*)(u32))fnPreNVICs[TIM8_TRG_COM_TIM14_IRQn])((u32)&NVIC_Stats[TIM8_TRG_COM_TIM14_IRQn]); // call either an empty function or a hooked one with desired context predefined (if context missing... error)
-  
-    if((TIM14->SR & TIM14->DIER) & (TIM_FLAG_Update || TIM_FLAG_CC1)) {// if there is a pending interrupt for TIM9
-      if(fnTIM14) ((u32(*)(u32))fnTIM14)(ctTIM14); // call either an empty function or a hooked one with desired context predefined (if context missing... error)
-      else while(1);//TODO clear the pending flag EXTI->PR |= (1<<10);  // clear the pending flag
-    }else{ // TIM1_BRK
-      if(fnTIM8_TRG_COM) ((u32(*)(u32))fnTIM8_TRG_COM)(ctTIM8_TRG_COM); // call either an empty function or a hooked one with desired context predefined (if context missing... error)
-      else while(1);//TODO clear the pending flag EXTI->PR |= (1<<10);  // clear the pending flag
-    };
-  
-  if(fnPostNVICs[TIM8_TRG_COM_TIM14_IRQn]) ((u32(*)(u32))fnPostNVICs[TIM8_TRG_COM_TIM14_IRQn])((u32)&NVIC_Stats[TIM8_TRG_COM_TIM14_IRQn]); // call either an empty function or a hooked one with desired context predefined (if context missing... error)
-}
+NVIC_VECTOR(TIM8_TRG_COM_TIM14, SebTIM8_TRG_COM_TIM14)
 #endif
 #ifdef SebTIM8_CC
-__irq void TIM8_CC_IRQHandler(void) {//  TIM8_CC_IRQn                = 46,     /*!< TIM8 Capture Compare Interrupt                                    */
-  if(fnPreNVICs[TIM8_CC_IRQn]) ((u32(*)(u32))fnPreNVICs[TIM8_CC_IRQn])((u32)&NVIC_Stats[TIM8_CC_IRQn]); // call either an empty function or a hooked one with desired context predefined (if context missing... error)
-    if(fnTIM8_CC) ((u32(*)(u32))fnTIM8_CC)(ctTIM8_CC); // call either an empty function or a hooked one with desired context predefined (if context missing... error)
-    else while(1);//TODO clear the pending flag EXTI->PR |= (1<<10);  // clear the pending flag
-  if(fnPostNVICs[TIM8_CC_IRQn]) ((u32(*)(u32))fnPostNVICs[TIM8_CC_IRQn])((u32)&NVIC_Stats[TIM8_CC_IRQn]); // call either an empty function or a hooked one with desired context predefined (if context missing... error)
-}
+NVIC_VECTOR(TIM8_CC, SebTIM8_CC)
 #endif
-
 #ifdef SebDMA1_Stream7
-__irq void DMA1_Stream7_IRQHandler(void) {//  DMA1_Stream7_IRQn           = 47,     /*!< DMA1 Stream7 Interrupt                                            */
-  if(fnPreNVICs[DMA1_Stream7_IRQn]) ((u32(*)(u32))fnPreNVICs[DMA1_Stream7_IRQn])((u32)&NVIC_Stats[DMA1_Stream7_IRQn]); // call either an empty function or a hooked one with desired context predefined (if context missing... error)
-    if(fnDMA1s[7]) ((u32(*)(u32))fnDMA1s[7])(ctDMA1s[7]); // call either an empty function or a hooked one with desired context predefined (if context missing... error)
-    else while(1);//TODO clear the pending flag EXTI->PR |= (1<<10);  // clear the pending flag
-  if(fnPostNVICs[DMA1_Stream7_IRQn]) ((u32(*)(u32))fnPostNVICs[DMA1_Stream7_IRQn])((u32)&NVIC_Stats[DMA1_Stream7_IRQn]); // call either an empty function or a hooked one with desired context predefined (if context missing... error)
-}
+NVIC_VECTOR(DMA1_Stream7, SebDMA1_Stream7)
 #endif
-
 #ifdef SebFSMC
-__irq void FSMC_IRQHandler(void) {//  FSMC_IRQn                   = 48,     /*!< FSMC global Interrupt                                             */
-  if(fnPreNVICs[FSMC_IRQn]) ((u32(*)(u32))fnPreNVICs[FSMC_IRQn])((u32)&NVIC_Stats[FSMC_IRQn]); // call either an empty function or a hooked one with desired context predefined (if context missing... error)
-    if(fnFSMC) ((u32(*)(u32))fnFSMC)(ctFSMC); // call either an empty function or a hooked one with desired context predefined (if context missing... error)
-    else while(1);//TODO clear the pending flag EXTI->PR |= (1<<10);  // clear the pending flag
-  if(fnPostNVICs[FSMC_IRQn]) ((u32(*)(u32))fnPostNVICs[FSMC_IRQn])((u32)&NVIC_Stats[FSMC_IRQn]); // call either an empty function or a hooked one with desired context predefined (if context missing... error)
-}
+NVIC_VECTOR(FSMC, SebFSMC)
 #endif
-
 #ifdef SebSDIO
-__irq void SDIO_IRQHandler(void) {//  SDIO_IRQn                   = 49,     /*!< SDIO global Interrupt                                             */
-  if(fnPreNVICs[SDIO_IRQn]) ((u32(*)(u32))fnPreNVICs[SDIO_IRQn])((u32)&NVIC_Stats[SDIO_IRQn]); // call either an empty function or a hooked one with desired context predefined (if context missing... error)
-    if(fnSDIO) ((u32(*)(u32))fnSDIO)(ctSDIO); // call either an empty function or a hooked one with desired context predefined (if context missing... error)
-    else while(1);//TODO clear the pending flag EXTI->PR |= (1<<10);  // clear the pending flag
-  if(fnPostNVICs[SDIO_IRQn]) ((u32(*)(u32))fnPostNVICs[SDIO_IRQn])((u32)&NVIC_Stats[SDIO_IRQn]); // call either an empty function or a hooked one with desired context predefined (if context missing... error)
-}
+NVIC_VECTOR(SDIO, SebSDIO)
 #endif
-
 #ifdef SebTIM5
-__irq void TIM5_IRQHandler(void) {//  TIM5_IRQn                   = 50,     /*!< TIM5 global Interrupt                                             */
-  if(fnPreNVICs[TIM5_IRQn]) ((u32(*)(u32))fnPreNVICs[TIM5_IRQn])((u32)&NVIC_Stats[TIM5_IRQn]); // call either an empty function or a hooked one with desired context predefined (if context missing... error)
-    if(fnTIM5) ((u32(*)(u32))fnTIM5)(ctTIM5); // call either an empty function or a hooked one with desired context predefined (if context missing... error)
-    else while(1);//TODO clear the pending flag EXTI->PR |= (1<<10);  // clear the pending flag
-  if(fnPostNVICs[TIM5_IRQn]) ((u32(*)(u32))fnPostNVICs[TIM5_IRQn])((u32)&NVIC_Stats[TIM5_IRQn]); // call either an empty function or a hooked one with desired context predefined (if context missing... error)
-}
+NVIC_VECTOR(TIM5, SebTIM5)
 #endif
-
 #ifdef SebSPI3
-__irq void SPI3_IRQHandler(void) {//  SPI3_IRQn                   = 51,     /*!< SPI3 global Interrupt                                             */
-  if(fnPreNVICs[SPI3_IRQn]) ((u32(*)(u32))fnPreNVICs[SPI3_IRQn])((u32)&NVIC_Stats[SPI3_IRQn]); // call either an empty function or a hooked one with desired context predefined (if context missing... error)
-    if(fnSPI3) ((u32(*)(u32))fnSPI3)(ctSPI3); // call either an empty function or a hooked one with desired context predefined (if context missing... error)
-    else while(1);//TODO clear the pending flag EXTI->PR |= (1<<10);  // clear the pending flag
-  if(fnPostNVICs[SPI3_IRQn]) ((u32(*)(u32))fnPostNVICs[SPI3_IRQn])((u32)&NVIC_Stats[SPI3_IRQn]); // call either an empty function or a hooked one with desired context predefined (if context missing... error)
-}
+NVIC_VECTOR(SPI3, SebSPI3)
 #endif
-
 #ifdef SebUART4
-__irq void UART4_IRQHandler(void) {//  UART4_IRQn                  = 52,     /*!< UART4 global Interrupt                                            */
-  if(fnPreNVICs[UART4_IRQn]) ((u32(*)(u32))fnPreNVICs[UART4_IRQn])((u32)&NVIC_Stats[UART4_IRQn]); // call either an empty function or a hooked one with desired context predefined (if context missing... error)
-    if(fnUART4) ((u32(*)(u32))fnUART4)(ctUART4); // call either an empty function or a hooked one with desired context predefined (if context missing... error)
-    else while(1);//TODO clear the pending flag EXTI->PR |= (1<<10);  // clear the pending flag
-  if(fnPostNVICs[UART4_IRQn]) ((u32(*)(u32))fnPostNVICs[UART4_IRQn])((u32)&NVIC_Stats[UART4_IRQn]); // call either an empty function or a hooked one with desired context predefined (if context missing... error)
-}
+NVIC_VECTOR(UART4, SebUART4)
 #endif
 #ifdef SebUART5
-__irq void UART5_IRQHandler(void) {//  UART5_IRQn                  = 53,     /*!< UART5 global Interrupt                                            */
-  if(fnPreNVICs[UART5_IRQn]) ((u32(*)(u32))fnPreNVICs[UART5_IRQn])((u32)&NVIC_Stats[UART5_IRQn]); // call either an empty function or a hooked one with desired context predefined (if context missing... error)
-    if(fnUART5) ((u32(*)(u32))fnUART5)(ctUART5); // call either an empty function or a hooked one with desired context predefined (if context missing... error)
-    else while(1);//TODO clear the pending flag EXTI->PR |= (1<<10);  // clear the pending flag
-  if(fnPostNVICs[UART5_IRQn]) ((u32(*)(u32))fnPostNVICs[UART5_IRQn])((u32)&NVIC_Stats[UART5_IRQn]); // call either an empty function or a hooked one with desired context predefined (if context missing... error)
-}
+NVIC_VECTOR(UART5, SebUART5)
 #endif
-
 #ifdef SebTIM6_DAC
-__irq void TIM6_DAC_IRQHandler(void) {//  TIM6_DAC_IRQn               = 54,     /*!< TIM6 global and DAC1&2 underrun error  interrupts                 */
-  if(fnPreNVICs[TIM6_DAC_IRQn]) ((u32(*)(u32))fnPreNVICs[TIM6_DAC_IRQn])((u32)&NVIC_Stats[TIM6_DAC_IRQn]); // call either an empty function or a hooked one with desired context predefined (if context missing... error)
-    if(fnTIM6_DAC) ((u32(*)(u32))fnTIM6_DAC)(ctTIM6_DAC); // call either an empty function or a hooked one with desired context predefined (if context missing... error)
-    else TIM6->SR &= ~1;//TODO clear the pending flag EXTI->PR |= (1<<10);  // clear the pending flag
-  if(fnPostNVICs[TIM6_DAC_IRQn]) ((u32(*)(u32))fnPostNVICs[TIM6_DAC_IRQn])((u32)&NVIC_Stats[TIM6_DAC_IRQn]); // call either an empty function or a hooked one with desired context predefined (if context missing... error)
-}
+NVIC_VECTOR(TIM6_DAC, SebTIM6_DAC)
 #endif
 #ifdef SebTIM7
-__irq void TIM7_IRQHandler(void) {//  TIM7_IRQn                   = 55,     /*!< TIM7 global interrupt                                             */
-  if(fnPreNVICs[TIM7_IRQn]) ((u32(*)(u32))fnPreNVICs[TIM7_IRQn])((u32)&NVIC_Stats[TIM7_IRQn]); // call either an empty function or a hooked one with desired context predefined (if context missing... error)
-    if(fnTIM7) ((u32(*)(u32))fnTIM7)(ctTIM7); // call either an empty function or a hooked one with desired context predefined (if context missing... error)
-    else TIM7->SR &= ~1;//TODO clear the pending flag EXTI->PR |= (1<<10);  // clear the pending flag
-  if(fnPostNVICs[TIM7_IRQn]) ((u32(*)(u32))fnPostNVICs[TIM7_IRQn])((u32)&NVIC_Stats[TIM7_IRQn]); // call either an empty function or a hooked one with desired context predefined (if context missing... error)
-}
+NVIC_VECTOR(TIM7, SebTIM7)
 #endif
-
 #ifdef SebDMA2_Stream0
-__irq void DMA2_Stream0_IRQHandler(void) {//  DMA2_Stream0_IRQn           = 56,     /*!< DMA2 Stream 0 global Interrupt                                    */
-  if(fnPreNVICs[DMA2_Stream0_IRQn]) ((u32(*)(u32))fnPreNVICs[DMA2_Stream0_IRQn])((u32)&NVIC_Stats[DMA2_Stream0_IRQn]); // call either an empty function or a hooked one with desired context predefined (if context missing... error)
-    if(fnDMA2s[0]) ((u32(*)(u32))fnDMA2s[0])(ctDMA2s[0]); // call either an empty function or a hooked one with desired context predefined (if context missing... error)
-    else while(1);//TODO clear the pending flag EXTI->PR |= (1<<10);  // clear the pending flag
-  if(fnPostNVICs[DMA2_Stream0_IRQn]) ((u32(*)(u32))fnPostNVICs[DMA2_Stream0_IRQn])((u32)&NVIC_Stats[DMA2_Stream0_IRQn]); // call either an empty function or a hooked one with desired context predefined (if context missing... error)
-}
+NVIC_VECTOR(DMA2_Stream0, SebDMA2_Stream0)
 #endif
 #ifdef SebDMA2_Stream1
-__irq void DMA2_Stream1_IRQHandler(void) {//  DMA2_Stream1_IRQn           = 57,     /*!< DMA2 Stream 1 global Interrupt                                    */
-  if(fnPreNVICs[DMA2_Stream1_IRQn]) ((u32(*)(u32))fnPreNVICs[DMA2_Stream1_IRQn])((u32)&NVIC_Stats[DMA2_Stream1_IRQn]); // call either an empty function or a hooked one with desired context predefined (if context missing... error)
-    if(fnDMA2s[1]) ((u32(*)(u32))fnDMA2s[1])(ctDMA2s[1]); // call either an empty function or a hooked one with desired context predefined (if context missing... error)
-    else while(1);//TODO clear the pending flag EXTI->PR |= (1<<10);  // clear the pending flag
-  if(fnPostNVICs[DMA2_Stream1_IRQn]) ((u32(*)(u32))fnPostNVICs[DMA2_Stream1_IRQn])((u32)&NVIC_Stats[DMA2_Stream1_IRQn]); // call either an empty function or a hooked one with desired context predefined (if context missing... error)
-}
+NVIC_VECTOR(DMA2_Stream1, SebDMA2_Stream1)
 #endif
 #ifdef SebDMA2_Stream2
-__irq void DMA2_Stream2_IRQHandler(void) {//  DMA2_Stream2_IRQn           = 58,     /*!< DMA2 Stream 2 global Interrupt                                    */
-  if(fnPreNVICs[DMA2_Stream2_IRQn]) ((u32(*)(u32))fnPreNVICs[DMA2_Stream2_IRQn])((u32)&NVIC_Stats[DMA2_Stream2_IRQn]); // call either an empty function or a hooked one with desired context predefined (if context missing... error)
-    if(fnDMA2s[2]) ((u32(*)(u32))fnDMA2s[2])(ctDMA2s[2]); // call either an empty function or a hooked one with desired context predefined (if context missing... error)
-    else while(1);//TODO clear the pending flag EXTI->PR |= (1<<10);  // clear the pending flag
-  if(fnPostNVICs[DMA2_Stream2_IRQn]) ((u32(*)(u32))fnPostNVICs[DMA2_Stream2_IRQn])((u32)&NVIC_Stats[DMA2_Stream2_IRQn]); // call either an empty function or a hooked one with desired context predefined (if context missing... error)
-}
+NVIC_VECTOR(DMA2_Stream2, SebDMA2_Stream2)
 #endif
 #ifdef SebDMA2_Stream3
-__irq void DMA2_Stream3_IRQHandler(void) {//  DMA2_Stream3_IRQn           = 59,     /*!< DMA2 Stream 3 global Interrupt                                    */
-  if(fnPreNVICs[DMA2_Stream3_IRQn]) ((u32(*)(u32))fnPreNVICs[DMA2_Stream3_IRQn])((u32)&NVIC_Stats[DMA2_Stream3_IRQn]); // call either an empty function or a hooked one with desired context predefined (if context missing... error)
-    if(fnDMA2s[3]) ((u32(*)(u32))fnDMA2s[3])(ctDMA2s[3]); // call either an empty function or a hooked one with desired context predefined (if context missing... error)
-    else while(1);//TODO clear the pending flag EXTI->PR |= (1<<10);  // clear the pending flag
-  if(fnPostNVICs[DMA2_Stream3_IRQn]) ((u32(*)(u32))fnPostNVICs[DMA2_Stream3_IRQn])((u32)&NVIC_Stats[DMA2_Stream3_IRQn]); // call either an empty function or a hooked one with desired context predefined (if context missing... error)
-}
+NVIC_VECTOR(DMA2_Stream3, SebDMA2_Stream3)
 #endif
 #ifdef SebDMA2_Stream4
-__irq void DMA2_Stream4_IRQHandler(void) {//  DMA2_Stream4_IRQn           = 60,     /*!< DMA2 Stream 4 global Interrupt                                    */
-  if(fnPreNVICs[DMA2_Stream4_IRQn]) ((u32(*)(u32))fnPreNVICs[DMA2_Stream4_IRQn])((u32)&NVIC_Stats[DMA2_Stream4_IRQn]); // call either an empty function or a hooked one with desired context predefined (if context missing... error)
-    if(fnDMA2s[4]) ((u32(*)(u32))fnDMA2s[4])(ctDMA2s[4]); // call either an empty function or a hooked one with desired context predefined (if context missing... error)
-    else while(1);//TODO clear the pending flag EXTI->PR |= (1<<10);  // clear the pending flag
-  if(fnPostNVICs[DMA2_Stream4_IRQn]) ((u32(*)(u32))fnPostNVICs[DMA2_Stream4_IRQn])((u32)&NVIC_Stats[DMA2_Stream4_IRQn]); // call either an empty function or a hooked one with desired context predefined (if context missing... error)
-}
+NVIC_VECTOR(DMA2_Stream4, SebDMA2_Stream4)
 #endif
-
 #ifdef SebETH
-__irq void ETH_IRQHandler(void) {//  ETH_IRQn                    = 61,     /*!< Ethernet global Interrupt                                         */
-  if(fnPreNVICs[ETH_IRQn]) ((u32(*)(u32))fnPreNVICs[ETH_IRQn])((u32)&NVIC_Stats[ETH_IRQn]); // call either an empty function or a hooked one with desired context predefined (if context missing... error)
-    if(fnETH) ((u32(*)(u32))fnETH)(ctETH); // call either an empty function or a hooked one with desired context predefined (if context missing... error)
-    else;//TODO clear the pending flag EXTI->PR |= (1<<10);  // clear the pending flag
-    NVIC_ReleasePendingIRQ(ETH_IRQn);
-  if(fnPostNVICs[ETH_IRQn]) ((u32(*)(u32))fnPostNVICs[ETH_IRQn])((u32)&NVIC_Stats[ETH_IRQn]); // call either an empty function or a hooked one with desired context predefined (if context missing... error)
-}
+NVIC_VECTOR(ETH, SebETH)
 #endif
 #ifdef SebETH_WKUP
-__irq void ETH_WKUP_IRQHandler(void) {//  ETH_WKUP_IRQn               = 62,     /*!< Ethernet Wakeup through EXTI line Interrupt                       */
-  if(fnPreNVICs[ETH_WKUP_IRQn]) ((u32(*)(u32))fnPreNVICs[ETH_WKUP_IRQn])((u32)&NVIC_Stats[ETH_WKUP_IRQn]); // call either an empty function or a hooked one with desired context predefined (if context missing... error)
-    if(fnETH_WKUP) ((u32(*)(u32))fnETH_WKUP)(ctETH_WKUP); // call either an empty function or a hooked one with desired context predefined (if context missing... error)
-    else while(1);//TODO clear the pending flag
-  if(fnPostNVICs[ETH_WKUP_IRQn]) ((u32(*)(u32))fnPostNVICs[ETH_WKUP_IRQn])((u32)&NVIC_Stats[ETH_WKUP_IRQn]); // call either an empty function or a hooked one with desired context predefined (if context missing... error)
-}
+NVIC_VECTOR(ETH_WKUP, SebETH_WKUP)
 #endif
-
 #ifdef SebCAN2_TX
-__irq void CAN2_TX_IRQHandler(void) {//  CAN2_TX_IRQn                = 63,     /*!< CAN2 TX Interrupt                                                 */
-  if(fnPreNVICs[CAN2_TX_IRQn]) ((u32(*)(u32))fnPreNVICs[CAN2_TX_IRQn])((u32)&NVIC_Stats[CAN2_TX_IRQn]); // call either an empty function or a hooked one with desired context predefined (if context missing... error)
-    if(fnCAN2_TX) ((u32(*)(u32))fnCAN2_TX)(ctCAN2_TX); // call either an empty function or a hooked one with desired context predefined (if context missing... error)
-    else while(1);//TODO clear the pending flag
-  if(fnPostNVICs[CAN2_TX_IRQn]) ((u32(*)(u32))fnPostNVICs[CAN2_TX_IRQn])((u32)&NVIC_Stats[CAN2_TX_IRQn]); // call either an empty function or a hooked one with desired context predefined (if context missing... error)
-}
+NVIC_VECTOR(CAN2_TX, SebCAN2_TX)
 #endif
 #ifdef SebCAN2_RX0
-__irq void CAN2_RX0_IRQHandler(void) {//  CAN2_RX0_IRQn               = 64,     /*!< CAN2 RX0 Interrupt                                                */
-  if(fnPreNVICs[CAN2_RX0_IRQn]) ((u32(*)(u32))fnPreNVICs[CAN2_RX0_IRQn])((u32)&NVIC_Stats[CAN2_RX0_IRQn]); // call either an empty function or a hooked one with desired context predefined (if context missing... error)
-    if(fnCAN2_RX0) ((u32(*)(u32))fnCAN2_RX0)(ctCAN2_RX0); // call either an empty function or a hooked one with desired context predefined (if context missing... error)
-    else while(1);//TODO clear the pending flag
-  if(fnPostNVICs[CAN2_RX0_IRQn]) ((u32(*)(u32))fnPostNVICs[CAN2_RX0_IRQn])((u32)&NVIC_Stats[CAN2_RX0_IRQn]); // call either an empty function or a hooked one with desired context predefined (if context missing... error)
-}
+NVIC_VECTOR(CAN2_RX0, SebCAN2_RX0)
 #endif
 #ifdef SebCAN2_RX1
-__irq void CAN2_RX1_IRQHandler(void) {//  CAN2_RX1_IRQn               = 65,     /*!< CAN2 RX1 Interrupt                                                */
-  if(fnPreNVICs[CAN2_RX1_IRQn]) ((u32(*)(u32))fnPreNVICs[CAN2_RX1_IRQn])((u32)&NVIC_Stats[CAN2_RX1_IRQn]); // call either an empty function or a hooked one with desired context predefined (if context missing... error)
-    if(fnCAN2_RX1) ((u32(*)(u32))fnCAN2_RX1)(ctCAN2_RX1); // call either an empty function or a hooked one with desired context predefined (if context missing... error)
-    else while(1);//TODO clear the pending flag
-  if(fnPostNVICs[CAN2_RX1_IRQn]) ((u32(*)(u32))fnPostNVICs[CAN2_RX1_IRQn])((u32)&NVIC_Stats[CAN2_RX1_IRQn]); // call either an empty function or a hooked one with desired context predefined (if context missing... error)
-}
+NVIC_VECTOR(CAN2_RX1, SebCAN2_RX1)
 #endif
 #ifdef SebCAN2_SCE
-__irq void CAN2_SCE_IRQHandler(void) {//  CAN2_SCE_IRQn               = 66,     /*!< CAN2 SCE Interrupt                                                */
-  if(fnPreNVICs[CAN2_SCE_IRQn]) ((u32(*)(u32))fnPreNVICs[CAN2_SCE_IRQn])((u32)&NVIC_Stats[CAN2_SCE_IRQn]); // call either an empty function or a hooked one with desired context predefined (if context missing... error)
-    if(fnCAN2_SCE) ((u32(*)(u32))fnCAN2_SCE)(ctCAN2_SCE); // call either an empty function or a hooked one with desired context predefined (if context missing... error)
-    else while(1);//TODO clear the pending flag
-  if(fnPostNVICs[CAN2_SCE_IRQn]) ((u32(*)(u32))fnPostNVICs[CAN2_SCE_IRQn])((u32)&NVIC_Stats[CAN2_SCE_IRQn]); // call either an empty function or a hooked one with desired context predefined (if context missing... error)
-}
+NVIC_VECTOR(CAN2_SCE, SebCAN2_SCE)
 #endif
-
 #ifdef SebOTG_FS
-__irq void OTG_FS_IRQHandler(void) {//  OTG_FS_IRQn                 = 67,     /*!< USB OTG FS global Interrupt                                       */
-  if(fnPreNVICs[OTG_FS_IRQn]) ((u32(*)(u32))fnPreNVICs[OTG_FS_IRQn])((u32)&NVIC_Stats[OTG_FS_IRQn]); // call either an empty function or a hooked one with desired context predefined (if context missing... error)
-    if(fnOTG_FS) ((u32(*)(u32))fnOTG_FS)(ctOTG_FS); // call either an empty function or a hooked one with desired context predefined (if context missing... error)
-    else while(1);//TODO clear the pending flag
-  if(fnPostNVICs[OTG_FS_IRQn]) ((u32(*)(u32))fnPostNVICs[OTG_FS_IRQn])((u32)&NVIC_Stats[OTG_FS_IRQn]); // call either an empty function or a hooked one with desired context predefined (if context missing... error)
-}
+NVIC_VECTOR(OTG_FS, SebOTG_FS)
 #endif
-
 #ifdef SebDMA2_Stream5
-__irq void DMA2_Stream5_IRQHandler(void) {//  DMA2_Stream5_IRQn           = 68,     /*!< DMA2 Stream 5 global interrupt                                    */
-  if(fnPreNVICs[DMA2_Stream5_IRQn]) ((u32(*)(u32))fnPreNVICs[DMA2_Stream5_IRQn])((u32)&NVIC_Stats[DMA2_Stream5_IRQn]); // call either an empty function or a hooked one with desired context predefined (if context missing... error)
-    if(fnDMA2s[5]) ((u32(*)(u32))fnDMA2s[5])(ctDMA2s[5]); // call either an empty function or a hooked one with desired context predefined (if context missing... error)
-    else while(1);//TODO clear the pending flag
-  if(fnPostNVICs[DMA2_Stream5_IRQn]) ((u32(*)(u32))fnPostNVICs[DMA2_Stream5_IRQn])((u32)&NVIC_Stats[DMA2_Stream5_IRQn]); // call either an empty function or a hooked one with desired context predefined (if context missing... error)
-}
+NVIC_VECTOR(DMA2_Stream5, SebDMA2_Stream5)
 #endif
 #ifdef SebDMA2_Stream6
-__irq void DMA2_Stream6_IRQHandler(void) {//  DMA2_Stream6_IRQn           = 69,     /*!< DMA2 Stream 6 global interrupt                                    */
-  if(fnPreNVICs[DMA2_Stream6_IRQn]) ((u32(*)(u32))fnPreNVICs[DMA2_Stream6_IRQn])((u32)&NVIC_Stats[DMA2_Stream6_IRQn]); // call either an empty function or a hooked one with desired context predefined (if context missing... error)
-    if(fnDMA2s[6]) ((u32(*)(u32))fnDMA2s[6])(ctDMA2s[6]); // call either an empty function or a hooked one with desired context predefined (if context missing... error)
-    else while(1);//TODO clear the pending flag
-  if(fnPostNVICs[DMA2_Stream6_IRQn]) ((u32(*)(u32))fnPostNVICs[DMA2_Stream6_IRQn])((u32)&NVIC_Stats[DMA2_Stream6_IRQn]); // call either an empty function or a hooked one with desired context predefined (if context missing... error)
-}
+NVIC_VECTOR(DMA2_Stream6, SebDMA2_Stream6)
 #endif
 #ifdef SebDMA2_Stream7
-__irq void DMA2_Stream7_IRQHandler(void) {//  DMA2_Stream7_IRQn           = 70,     /*!< DMA2 Stream 7 global interrupt                                    */
-  if(fnPreNVICs[DMA2_Stream7_IRQn]) ((u32(*)(u32))fnPreNVICs[DMA2_Stream7_IRQn])((u32)&NVIC_Stats[DMA2_Stream7_IRQn]); // call either an empty function or a hooked one with desired context predefined (if context missing... error)
-    if(fnDMA2s[7]) ((u32(*)(u32))fnDMA2s[7])(ctDMA2s[7]); // call either an empty function or a hooked one with desired context predefined (if context missing... error)
-    else while(1);//TODO clear the pending flag
-  if(fnPostNVICs[DMA2_Stream7_IRQn]) ((u32(*)(u32))fnPostNVICs[DMA2_Stream7_IRQn])((u32)&NVIC_Stats[DMA2_Stream7_IRQn]); // call either an empty function or a hooked one with desired context predefined (if context missing... error)
-}
+NVIC_VECTOR(DMA2_Stream7, SebDMA2_Stream7)
 #endif
-
 #ifdef SebUSART6
-__irq void USART6_IRQHandler(void) {//  USART6_IRQn                 = 71,     /*!< USART6 global interrupt                                           */
-  if(fnPreNVICs[USART6_IRQn]) ((u32(*)(u32))fnPreNVICs[USART6_IRQn])((u32)&NVIC_Stats[USART6_IRQn]); // call either an empty function or a hooked one with desired context predefined (if context missing... error)
-    if(fnUSART6) ((u32(*)(u32))fnUSART6)(ctUSART6); // call either an empty function or a hooked one with desired context predefined (if context missing... error)
-    else while(1);//TODO clear the pending flag
-  if(fnPostNVICs[USART6_IRQn]) ((u32(*)(u32))fnPostNVICs[USART6_IRQn])((u32)&NVIC_Stats[USART6_IRQn]); // call either an empty function or a hooked one with desired context predefined (if context missing... error)
-}
+NVIC_VECTOR(USART6, SebUSART6)
 #endif
-
-#ifdef SebI2C_EV
-__irq void I2C3_EV_IRQHandler(void) {//  I2C3_EV_IRQn                = 72,     /*!< I2C3 event interrupt                                              */
-  if(fnPreNVICs[I2C3_EV_IRQn]) ((u32(*)(u32))fnPreNVICs[I2C3_EV_IRQn])((u32)&NVIC_Stats[I2C3_EV_IRQn]); // call either an empty function or a hooked one with desired context predefined (if context missing... error)
-    if(fnI2C3_EV) ((u32(*)(u32))fnI2C3_EV)(ctI2C3_EV); // call either an empty function or a hooked one with desired context predefined (if context missing... error)
-    else while(1);//TODO clear the pending flag
-  if(fnPostNVICs[I2C3_EV_IRQn]) ((u32(*)(u32))fnPostNVICs[I2C3_EV_IRQn])((u32)&NVIC_Stats[I2C3_EV_IRQn]); // call either an empty function or a hooked one with desired context predefined (if context missing... error)
-}
+#ifdef SebI2C3_EV
+NVIC_VECTOR(I2C3_EV, SebI2C3_EV)
 #endif
-
 #ifdef SebI2C3_ER
-__irq void I2C3_ER_IRQHandler(void) {//  I2C3_ER_IRQn                = 73,     /*!< I2C3 error interrupt                                              */
-  if(fnPreNVICs[I2C3_ER_IRQn]) ((u32(*)(u32))fnPreNVICs[I2C3_ER_IRQn])((u32)&NVIC_Stats[I2C3_ER_IRQn]); // call either an empty function or a hooked one with desired context predefined (if context missing... error)
-    if(fnI2C3_ER) ((u32(*)(u32))fnI2C3_ER)(ctI2C3_ER); // call either an empty function or a hooked one with desired context predefined (if context missing... error)
-    else while(1);//TODO clear the pending flag
-  if(fnPostNVICs[I2C3_ER_IRQn]) ((u32(*)(u32))fnPostNVICs[I2C3_ER_IRQn])((u32)&NVIC_Stats[I2C3_ER_IRQn]); // call either an empty function or a hooked one with desired context predefined (if context missing... error)
-}
+NVIC_VECTOR(I2C3_ER, SebI2C3_ER)
 #endif
-
-#ifdef SebOTG_EP1_OUT
-__irq void OTG_HS_EP1_OUT_IRQHandler(void) {//  OTG_HS_EP1_OUT_IRQn         = 74,     /*!< USB OTG HS End Point 1 Out global interrupt                       */
-  if(fnPreNVICs[OTG_HS_EP1_OUT_IRQn]) ((u32(*)(u32))fnPreNVICs[OTG_HS_EP1_OUT_IRQn])((u32)&NVIC_Stats[OTG_HS_EP1_OUT_IRQn]); // call either an empty function or a hooked one with desired context predefined (if context missing... error)
-    if(fnOTG_HS_EP1_OUT) ((u32(*)(u32))fnOTG_HS_EP1_OUT)(ctOTG_HS_EP1_OUT); // call either an empty function or a hooked one with desired context predefined (if context missing... error)
-    else while(1);//TODO clear the pending flag
-  if(fnPostNVICs[OTG_HS_EP1_OUT_IRQn]) ((u32(*)(u32))fnPostNVICs[OTG_HS_EP1_OUT_IRQn])((u32)&NVIC_Stats[OTG_HS_EP1_OUT_IRQn]); // call either an empty function or a hooked one with desired context predefined (if context missing... error)
-}
+#ifdef SebOTG_HS_EP1_OUT
+NVIC_VECTOR(OTG_HS_EP1_OUT, SebOTG_HS_EP1_OUT)
 #endif
-#ifdef SebOTG_HR_EP1_IN
-__irq void OTG_HS_EP1_IN_IRQHandler(void) {//  OTG_HS_EP1_IN_IRQn          = 75,     /*!< USB OTG HS End Point 1 In global interrupt                        */
-  if(fnPreNVICs[OTG_HS_EP1_IN_IRQn]) ((u32(*)(u32))fnPreNVICs[OTG_HS_EP1_IN_IRQn])((u32)&NVIC_Stats[OTG_HS_EP1_IN_IRQn]); // call either an empty function or a hooked one with desired context predefined (if context missing... error)
-    if(fnOTG_HS_EP1_IN) ((u32(*)(u32))fnOTG_HS_EP1_IN)(ctOTG_HS_EP1_IN); // call either an empty function or a hooked one with desired context predefined (if context missing... error)
-    else while(1);//TODO clear the pending flag
-  if(fnPostNVICs[OTG_HS_EP1_IN_IRQn]) ((u32(*)(u32))fnPostNVICs[OTG_HS_EP1_IN_IRQn])((u32)&NVIC_Stats[OTG_HS_EP1_IN_IRQn]); // call either an empty function or a hooked one with desired context predefined (if context missing... error)
-}
+#ifdef SebOTG_HS_EP1_IN
+NVIC_VECTOR(OTG_HS_EP1_IN, SebOTG_HS_EP1_IN)
 #endif
 #ifdef SebOTG_HS_WKUP
-__irq void OTG_HS_WKUP_IRQHandler(void) {//  OTG_HS_WKUP_IRQn            = 76,     /*!< USB OTG HS Wakeup through EXTI interrupt                          */
-  if(fnPreNVICs[OTG_HS_WKUP_IRQn]) ((u32(*)(u32))fnPreNVICs[OTG_HS_WKUP_IRQn])((u32)&NVIC_Stats[OTG_HS_WKUP_IRQn]); // call either an empty function or a hooked one with desired context predefined (if context missing... error)
-    if(fnOTG_HS_WKUP) ((u32(*)(u32))fnOTG_HS_WKUP)(ctOTG_HS_WKUP); // call either an empty function or a hooked one with desired context predefined (if context missing... error)
-    else while(1);//TODO clear the pending flag
-  if(fnPostNVICs[OTG_HS_WKUP_IRQn]) ((u32(*)(u32))fnPostNVICs[OTG_HS_WKUP_IRQn])((u32)&NVIC_Stats[OTG_HS_WKUP_IRQn]); // call either an empty function or a hooked one with desired context predefined (if context missing... error)
-}
+NVIC_VECTOR(OTG_HS_WKUP, SebOTG_HS_WKUP)
 #endif
 #ifdef SebOTG_HS
-__irq void OTG_HS_IRQHandler(void) {//  OTG_HS_IRQn                 = 77,     /*!< USB OTG HS global interrupt                                       */
-  if(fnPreNVICs[OTG_HS_IRQn]) ((u32(*)(u32))fnPreNVICs[OTG_HS_IRQn])((u32)&NVIC_Stats[OTG_HS_IRQn]); // call either an empty function or a hooked one with desired context predefined (if context missing... error)
-    if(fnOTG_HS) ((u32(*)(u32))fnOTG_HS)(ctOTG_HS); // call either an empty function or a hooked one with desired context predefined (if context missing... error)
-    else while(1);//TODO clear the pending flag
-  if(fnPostNVICs[OTG_HS_IRQn]) ((u32(*)(u32))fnPostNVICs[OTG_HS_IRQn])((u32)&NVIC_Stats[OTG_HS_IRQn]); // call either an empty function or a hooked one with desired context predefined (if context missing... error)
-}
+NVIC_VECTOR(OTG_HS, SebOTG_HS)
 #endif
-
 #ifdef SebDCMI
-__irq void DCMI_IRQHandler(void) {//  DCMI_IRQn                   = 78,     /*!< DCMI global interrupt                                             */
-  if(fnPreNVICs[DCMI_IRQn]) ((u32(*)(u32))fnPreNVICs[DCMI_IRQn])((u32)&NVIC_Stats[DCMI_IRQn]); // call either an empty function or a hooked one with desired context predefined (if context missing... error)
-    if(fnDCMI) ((u32(*)(u32))fnDCMI)(ctDCMI); // call either an empty function or a hooked one with desired context predefined (if context missing... error)
-    else while(1);//TODO clear the pending flag
-  if(fnPostNVICs[DCMI_IRQn]) ((u32(*)(u32))fnPostNVICs[DCMI_IRQn])((u32)&NVIC_Stats[DCMI_IRQn]); // call either an empty function or a hooked one with desired context predefined (if context missing... error)
-}
+NVIC_VECTOR(DCMI, SebDCMI)
 #endif
-
 #ifdef SebCRYP
-__irq void CRYP_IRQHandler(void) {//  CRYP_IRQn                   = 79,     /*!< CRYP crypto global interrupt                                      */
-  if(fnPreNVICs[CRYP_IRQn]) ((u32(*)(u32))fnPreNVICs[CRYP_IRQn])((u32)&NVIC_Stats[CRYP_IRQn]); // call either an empty function or a hooked one with desired context predefined (if context missing... error)
-    if(fnCRYP) ((u32(*)(u32))fnCRYP)(ctCRYP); // call either an empty function or a hooked one with desired context predefined (if context missing... error)
-    else while(1);//TODO clear the pending flag
-  if(fnPostNVICs[CRYP_IRQn]) ((u32(*)(u32))fnPostNVICs[CRYP_IRQn])((u32)&NVIC_Stats[CRYP_IRQn]); // call either an empty function or a hooked one with desired context predefined (if context missing... error)
-}
+NVIC_VECTOR(CRYP, SebCRYP)
 #endif
-
 #ifdef SebHASH_RNG
-__irq void HASH_RNG_IRQHandler(void) {//  HASH_RNG_IRQn               = 80,      /*!< Hash and Rng global interrupt                                     */
-  if(fnPreNVICs[HASH_RNG_IRQn]) ((u32(*)(u32))fnPreNVICs[HASH_RNG_IRQn])((u32)&NVIC_Stats[HASH_RNG_IRQn]); // call either an empty function or a hooked one with desired context predefined (if context missing... error)
-    if(fnHASH_RNG) ((u32(*)(u32))fnHASH_RNG)(ctHASH_RNG); // call either an empty function or a hooked one with desired context predefined (if context missing... error)
-    else while(1);//TODO clear the pending flag
-  if(fnPostNVICs[HASH_RNG_IRQn]) ((u32(*)(u32))fnPostNVICs[HASH_RNG_IRQn])((u32)&NVIC_Stats[HASH_RNG_IRQn]); // call either an empty function or a hooked one with desired context predefined (if context missing... error)
-}
+NVIC_VECTOR(HASH_RNG, SebHASH_RNG)
 #endif
-
 #ifdef SebFPU
-__irq void FPU_IRQHandler(void) {//  FPU_IRQn                    = 81,      /*!< FPU global interrupt                                              */
-  if(fnPreNVICs[FPU_IRQn]) ((u32(*)(u32))fnPreNVICs[FPU_IRQn])((u32)&NVIC_Stats[FPU_IRQn]); // call either an empty function or a hooked one with desired context predefined (if context missing... error)
-    if(fnFPU) ((u32(*)(u32))fnFPU)(ctFPU); // call either an empty function or a hooked one with desired context predefined (if context missing... error)
-    else while(1);//TODO clear the pending flag
-  if(fnPostNVICs[FPU_IRQn]) ((u32(*)(u32))fnPostNVICs[FPU_IRQn])((u32)&NVIC_Stats[FPU_IRQn]); // call either an empty function or a hooked one with desired context predefined (if context missing... error)
-}
+NVIC_VECTOR(FPU, SebFPU)
 #endif
-
 #ifdef SebSPI4
-__irq void SPI4_IRQHandler(void) {//  SPI4_IRQn                   = 84,     /*!< SPI4 global Interrupt                                             */
-  if(fnPreNVICs[SPI4_IRQn]) ((u32(*)(u32))fnPreNVICs[SPI4_IRQn])((u32)&NVIC_Stats[SPI4_IRQn]); // call either an empty function or a hooked one with desired context predefined (if context missing... error)
-    if(fnSPI4) ((u32(*)(u32))fnSPI4)(ctSPI4); // call either an empty function or a hooked one with desired context predefined (if context missing... error)
-    else while(1);//TODO clear the pending flag
-  if(fnPostNVICs[SPI4_IRQn]) ((u32(*)(u32))fnPostNVICs[SPI4_IRQn])((u32)&NVIC_Stats[SPI4_IRQn]); // call either an empty function or a hooked one with desired context predefined (if context missing... error)
-}
+NVIC_VECTOR(SPI4, SebSPI4)
 #endif
 #ifdef SebSPI5
-__irq void SPI5_IRQHandler(void) {//  SPI5_IRQn                   = 85,     /*!< SPI5 global Interrupt                                             */
-  if(fnPreNVICs[SPI5_IRQn]) ((u32(*)(u32))fnPreNVICs[SPI5_IRQn])((u32)&NVIC_Stats[SPI5_IRQn]); // call either an empty function or a hooked one with desired context predefined (if context missing... error)
-    if(fnSPI5) ((u32(*)(u32))fnSPI5)(ctSPI5); // call either an empty function or a hooked one with desired context predefined (if context missing... error)
-    else while(1);//TODO clear the pending flag
-  if(fnPostNVICs[SPI5_IRQn]) ((u32(*)(u32))fnPostNVICs[SPI5_IRQn])((u32)&NVIC_Stats[SPI5_IRQn]); // call either an empty function or a hooked one with desired context predefined (if context missing... error)
-}
+NVIC_VECTOR(SPI5, SebSPI5)
 #endif
 #ifdef SebSPI6
-__irq void SPI6_IRQHandler(void) {//  SPI6_IRQn                   = 86,     /*!< SPI6 global Interrupt                                             */
-  if(fnPreNVICs[SPI6_IRQn]) ((u32(*)(u32))fnPreNVICs[SPI6_IRQn])((u32)&NVIC_Stats[SPI6_IRQn]); // call either an empty function or a hooked one with desired context predefined (if context missing... error)
-    if(fnSPI6) ((u32(*)(u32))fnSPI6)(ctSPI6); // call either an empty function or a hooked one with desired context predefined (if context missing... error)
-    else while(1);//TODO clear the pending flag
-  if(fnPostNVICs[SPI6_IRQn]) ((u32(*)(u32))fnPostNVICs[SPI6_IRQn])((u32)&NVIC_Stats[SPI6_IRQn]); // call either an empty function or a hooked one with desired context predefined (if context missing... error)
-}
+NVIC_VECTOR(SPI6, SebSPI6)
 #endif
@@ -2,91 +2,253 @@
 #ifndef _SEB_NVIC_H_
 #define _SEB_NVIC_H_
 
-// These are all the NVIC hooks (positive IRQs)
-// When a single IRQ channel is shared by several interrupt sources, the hooks should be split. (for now done only for EXTI+FastIO)
-extern u32 fnWWDG,ctWWDG;
-extern u32 fnPVD,ctPVD;
-extern u32 fnTAMP_STAMP,ctTAMP_STAMP;
-extern u32 fnRTC_WKUP,ctRTC_WKUP;
-extern u32 fnFLASH,ctFLASH;
-extern u32 fnRCC,ctRCC;
-extern u32 fnEXTIs[16], ctEXTIs[16];
-extern u32 fnDMA1s[8],ctDMA1s[8];
-extern u32 fnADC1,ctADC1, fnADC2,ctADC2, fnADC3,ctADC3;
-extern u32 fnCAN1_TX,ctCAN1_RX;
-extern u32 fnCAN1_RX0,ctCAN1_RX0;
-extern u32 fnCAN1_RX1,ctCAN1_RX1;
-extern u32 fnCAN1_SCE,ctCAN1_SCE;
-//extern u32 fnTIM1_BRK_TIM9,ctTIM1_BRK_TIM9; // this should be split in 2 different hooks
-extern u32 fnTIM1_BRK,ctTIM1_BRK;
-extern u32 fnTIM9,ctTIM9;
-
-//extern u32 fnTIM1_UP_TIM10,ctTIM1_UP_TIM10; // this should be split in 2 different hooks
-extern u32 fnTIM1_UP,ctTIM1_UP;
-extern u32 fnTIM10,ctTIM10;
-
-//extern u32 fnTIM1_TRG_COM_TIM11,ctTIM1_TRG_COM_TIM11; // this should be split in 2 different hooks
-extern u32 fnTIM1_TRG_COM,ctTIM1_TRG_COM;
-extern u32 fnTIM11,ctTIM11;
-
-extern u32 fnTIM1_CC,ctTIM1_CC;
-extern u32 fnTIM2,ctTIM2;
-extern u32 fnTIM3,ctTIM3;
-extern u32 fnTIM4,ctTIM4;
-extern u32 fnI2C1_EV,ctI2C1_EV;
-extern u32 fnI2C1_ER,ctI2C1_ER;
-extern u32 fnI2C2_EV,ctI2C2_EV;
-extern u32 fnI2C2_ER,ctI2C2_ER;
-extern u32 fnSPI1,ctSPI1;
-extern u32 fnSPI2,ctSPI2;
-extern u32 fnUSART1,ctUSART1;
-extern u32 fnUSART2,ctUSART2;
-extern u32 fnUSART3,ctUSART3;
-extern u32 fnRTC_Alarm,ctRTC_Alarm;
-extern u32 fnOTG_FS_WKUP,ctOTG_FS_WKUP;
-//extern u32 fnTIM8_BRK_TIM12,ctTIM8_BRK_TIM12; // this should be flipped to 2 different hooks
-extern u32 fnTIM8_BRK,ctTIM8_BRK;
-extern u32 fnTIM12,ctTIM12;
-
-//extern u32 fnTIM8_UP_TIM13,ctTIM8_UP_TIM13; // this should be flipped to 2 different hooks
-extern u32 fnTIM8_UP,ctTIM8_UP;
-extern u32 fnTIM13,ctTIM13;
-
-//extern u32 fnTIM8_TRG_COM_TIM14,ctTIM8_TRG_COM_TIM14; // this should be flipped to 2 different hooks
-extern u32 fnTIM8_TRG_COM,ctTIM8_TRG_COM;
-extern u32 fnTIM14,ctTIM14;
-
-extern u32 fnTIM8_CC,ctTIM8_CC;
-extern u32 fnFSMC,ctFSMC;
-extern u32 fnSDIO,ctSDIO;
-extern u32 fnTIM5,ctTIM5;
-extern u32 fnSPI3,ctSPI3;
-extern u32 fnUART4,ctUART4;
-extern u32 fnUART5,ctUART5;
-extern u32 fnTIM6_DAC,ctTIM6_DAC; // to be split in 2 hooks?
-extern u32 fnTIM7,ctTIM7;
-extern u32 fnDMA2s[8],ctDMA2s[8];
-extern u32 fnETH,ctETH;
-extern u32 fnETH_WKUP,ctETH_WKUP;
-extern u32 fnCAN2_TX1,ctCAN2_TX;
-extern u32 fnCAN2_RX0,ctCAN2_RX0;
-extern u32 fnCAN2_RX1,ctCAN2_RX1;
-extern u32 fnCAN2_SCE,ctCAN2_SCE;
-extern u32 fnOTG_FS,ctOTG_FS;
-extern u32 fnUSART6,ctUSART6;
-extern u32 fnI2C3_EV,ctI2C3_EV;
-extern u32 fnI2C3_ER,ctI2C3_ER;
-extern u32 fnOTG_HS_EP1_OUT,ctOTG_HS_EP1_OUT;
-extern u32 fnOTG_HS_EP1_IN,ctOTG_HS_EP1_IN;
-extern u32 fnOTG_HS_WKUP,ctOTG_HS_WKUP;
-extern u32 fnOTG_HS,ctOTG_HS;
-extern u32 fnDCMI,ctDCMI;
-extern u32 fnCRYP,ctCRYP;
-extern u32 fnHASH_RNG,ctHASH_RNG;
-extern u32 fnFPU,ctFPU;
-extern u32 fnSPI4,ctSPI4;
-extern u32 fnSPI5,ctSPI5;
-extern u32 fnSPI6,ctSPI6;
+#define NVIC_IRQn_Count 90
+
+// These are all the NVIC hooks (positive IRQs), in a single table
+// Every vector lands in NVIC_Dispatch(), which reads the active IRQn from IPSR and calls NVIC_Hooks[IRQn] (unless it is a lean one, see NVIC_BARE)
+// When a single IRQ channel is shared by several interrupt sources, its IRQn entry left unhooked runs a demux which calls the hooks of each source.
+// These are placed after the IRQn entries. Hooking the IRQn entry of a shared channel replaces its demux: the hook then serves the whole channel.
+typedef struct {
+  u32 fn; // u32 fn(u32 ct), 0: not hooked
+  u32 ct;
+} NVIC_Hook_t;
+
+typedef enum {
+  // 0..NVIC_IRQn_Count-1: the IRQn itself
+  NVIC_HOOK_EXTI0 = NVIC_IRQn_Count, // all the 16 EXTI lines, including 0..4, so a line is a plain index
+  NVIC_HOOK_EXTI15 = NVIC_HOOK_EXTI0 + 15,
+  NVIC_HOOK_ADC1, NVIC_HOOK_ADC2, NVIC_HOOK_ADC3, // ADC_IRQn
+  NVIC_HOOK_TIM1_BRK, NVIC_HOOK_TIM9, // TIM1_BRK_TIM9_IRQn
+  NVIC_HOOK_TIM1_UP, NVIC_HOOK_TIM10, // TIM1_UP_TIM10_IRQn
+  NVIC_HOOK_TIM1_TRG_COM, NVIC_HOOK_TIM11, // TIM1_TRG_COM_TIM11_IRQn
+  NVIC_HOOK_TIM8_BRK, NVIC_HOOK_TIM12, // TIM8_BRK_TIM12_IRQn
+  NVIC_HOOK_TIM8_UP, NVIC_HOOK_TIM13, // TIM8_UP_TIM13_IRQn
+  NVIC_HOOK_TIM8_TRG_COM, NVIC_HOOK_TIM14, // TIM8_TRG_COM_TIM14_IRQn
+  NVIC_HOOK_COUNT, // ~120 hooks = 1kb RAM
+  NVIC_NO_HOOK = 0xFFFF // for the peripherals without interrupt
+} NVIC_HookIndex_t;
+
+#define NVIC_HOOK_EXTI(n) (NVIC_HOOK_EXTI0 + (n))
+#define NVIC_HOOK_DMA1(n) (((n)<7) ? (DMA1_Stream0_IRQn + (n)) : DMA1_Stream7_IRQn)
+#define NVIC_HOOK_DMA2(n) (((n)<5) ? (DMA2_Stream0_IRQn + (n)) : (DMA2_Stream5_IRQn + (n) - 5))
+
+extern NVIC_Hook_t NVIC_Hooks[NVIC_HOOK_COUNT];
+
+void NVIC_Dispatch(void); // the one handler behind all the vectors
+void NVIC_Serve(u32 IRQn); // its body: storm guard, pre hook, hook (or the unhooked fallback), post hook
+u32 HookIRQn(u32 Hook, u32 fn, u32 ct); // Hook is an IRQn or a NVIC_HOOK_xxx, returns the previous fn
+u32 u32_fn_u32(u32 u); // does nothing: the placeholder hook
+
+// Lean vectors, chosen per IRQ by the value of its SebXXX define in sebEngine.h, like #define SebTIM2 NVIC_BARE (empty: NVIC_Dispatch())
+// NVIC_BARE: the hook or the unhooked fallback only. No storm guard, no pre/post hooks, so no NVIC_StatsEnable() on it
+// NVIC_DIRECT: the same, and the hook is called without test. It must be hooked before the IRQ is enabled and never set back to 0 (hook u32_fn_u32 instead)
+#define NVIC_BARE _BARE
+#define NVIC_DIRECT _DIRECT
+
+extern u32 fnPreNVICs[NVIC_IRQn_Count]; // u32 fn(u32 IRQn), called before the hook, 0: none
+extern u32 fnPostNVICs[NVIC_IRQn_Count]; // called after the hook
+
+// Interrupt storm guard: an IRQ entered more than MaxEntries times within Window_cy (DWT cycles) is masked in the NVIC.
+// A job posted on the main loop artery unmasks it once its window is over: whatever else is pending gets its turn in between.
+// Until then the job posts itself again (the main loop polls it). Called by hand (no artery), check NVIC_Storms[].Masked.
+typedef struct {
+  u32 WindowStart_cy;
+  u32 Window_cy;
+  u16 MaxEntries; // 0: not monitored
+  u16 Entries; // in the current window
+  u16 Storms; // telemetry: how many times this IRQ got masked
+  u16 Masked; // waiting for NVIC_StormRelease()
+} NVIC_Storm_t;
+
+extern NVIC_Storm_t NVIC_Storms[NVIC_IRQn_Count];
+extern u32 NVIC_StormCount; // all IRQs together
+
+void NewNVIC_StormGuard(u32 SA); // SA: a NewSA_MPSC() artery drained by the main loop (MPSCJobToDo), 0: none
+void NVIC_StormLimit(u32 IRQn, u32 MaxEntries, u32 Window_cy); // MaxEntries = 0 stops monitoring
+u32 NVIC_StormRelease(u32 u); // the release job: unmasks the masked IRQs whose window is over
+
+// Deferred work (bottom halves): a hook only posts a OneJob_t, PendSV at the lowest priority runs it with the interrupts enabled.
+// PendSV tail-chains after the last pending ISR, so the job is still done before going back to the main loop.
+// DeferJob is hook compatible: hook it with a OneJob_t* as context, and fnJob runs from PendSV. Deferred jobs must run to completion (no callback armed).
+// The PendSV_Handler() draining them is only built with SebPendSV defined in sebEngine.h (the ST templates already have one)
+void NewNVIC_Deferred(u32 SA); // SA: a NewSA_MPSC() artery, only drained by PendSV. Sets PendSV to the lowest priority
+u32 DeferJob(u32 Job); // any context, Job is a OneJob_t*, returns 0 if the artery is full (the job is not queued)
+extern u32 NVIC_DeferredLost; // telemetry: jobs not queued, artery full
+
+#ifdef NVIC_STATS
+// Per IRQ duration and period (time between entries) in DWT cycles, with a log2 histogram of the durations
+#define NVIC_STATS_BINS 16 // bin n: 2^n..2^(n+1)-1 cycles, the last one takes everything above
+
+typedef struct {
+  u32 Entry_cy; // DWT->CYCCNT at the last entry
+  u32 Min_cy;
+  u32 Max_cy;
+  u32 Sum_cy; // avg = Sum_cy / Count (wraps after 2^32 cycles of this IRQ)
+  u32 Count;
+  u32 MinPeriod_cy; // jitter = MaxPeriod_cy - MinPeriod_cy
+  u32 MaxPeriod_cy;
+  u16 Bins[NVIC_STATS_BINS]; // saturate at 0xFFFF
+  u32 TooLong_cy; // 0: not used
+  u32 fnTooLong; // hook called when a run is longer than TooLong_cy, if none: stops there
+  u32 ctTooLong;
+} NVIC_StatsTypeDef;
+
+extern NVIC_StatsTypeDef NVIC_Stats[NVIC_IRQn_Count];
+extern u32 NVIC_StatsMask[(NVIC_IRQn_Count+31)/32];
+
+u32 PreNVICs(u32 u);
+u32 PostNVICs(u32 u);
+void NVIC_StatsEnable(u32 IRQn, FunctionalState Enable); // clears the figures and starts, or stops
+void NVIC_StatsDump(u32 Print); // Print: the PrintfHk_t* to stream through with SebPrintf()
+#endif
+
+// The former per vector hook variables are now aliases into the table
+#define fnEXTIs(n) NVIC_Hooks[NVIC_HOOK_EXTI(n)].fn
+#define ctEXTIs(n) NVIC_Hooks[NVIC_HOOK_EXTI(n)].ct
+#define fnDMA1s(n) NVIC_Hooks[NVIC_HOOK_DMA1(n)].fn
+#define ctDMA1s(n) NVIC_Hooks[NVIC_HOOK_DMA1(n)].ct
+#define fnDMA2s(n) NVIC_Hooks[NVIC_HOOK_DMA2(n)].fn
+#define ctDMA2s(n) NVIC_Hooks[NVIC_HOOK_DMA2(n)].ct
+#define fnWWDG NVIC_Hooks[WWDG_IRQn].fn
+#define ctWWDG NVIC_Hooks[WWDG_IRQn].ct
+#define fnPVD NVIC_Hooks[PVD_IRQn].fn
+#define ctPVD NVIC_Hooks[PVD_IRQn].ct
+#define fnTAMP_STAMP NVIC_Hooks[TAMP_STAMP_IRQn].fn
+#define ctTAMP_STAMP NVIC_Hooks[TAMP_STAMP_IRQn].ct
+#define fnRTC_WKUP NVIC_Hooks[RTC_WKUP_IRQn].fn
+#define ctRTC_WKUP NVIC_Hooks[RTC_WKUP_IRQn].ct
+#define fnFLASH NVIC_Hooks[FLASH_IRQn].fn
+#define ctFLASH NVIC_Hooks[FLASH_IRQn].ct
+#define fnRCC NVIC_Hooks[RCC_IRQn].fn
+#define ctRCC NVIC_Hooks[RCC_IRQn].ct
+#define fnCAN1_TX NVIC_Hooks[CAN1_TX_IRQn].fn
+#define ctCAN1_TX NVIC_Hooks[CAN1_TX_IRQn].ct
+#define fnCAN1_RX0 NVIC_Hooks[CAN1_RX0_IRQn].fn
+#define ctCAN1_RX0 NVIC_Hooks[CAN1_RX0_IRQn].ct
+#define fnCAN1_RX1 NVIC_Hooks[CAN1_RX1_IRQn].fn
+#define ctCAN1_RX1 NVIC_Hooks[CAN1_RX1_IRQn].ct
+#define fnCAN1_SCE NVIC_Hooks[CAN1_SCE_IRQn].fn
+#define ctCAN1_SCE NVIC_Hooks[CAN1_SCE_IRQn].ct
+#define fnTIM1_CC NVIC_Hooks[TIM1_CC_IRQn].fn
+#define ctTIM1_CC NVIC_Hooks[TIM1_CC_IRQn].ct
+#define fnTIM2 NVIC_Hooks[TIM2_IRQn].fn
+#define ctTIM2 NVIC_Hooks[TIM2_IRQn].ct
+#define fnTIM3 NVIC_Hooks[TIM3_IRQn].fn
+#define ctTIM3 NVIC_Hooks[TIM3_IRQn].ct
+#define fnTIM4 NVIC_Hooks[TIM4_IRQn].fn
+#define ctTIM4 NVIC_Hooks[TIM4_IRQn].ct
+#define fnI2C1_EV NVIC_Hooks[I2C1_EV_IRQn].fn
+#define ctI2C1_EV NVIC_Hooks[I2C1_EV_IRQn].ct
+#define fnI2C1_ER NVIC_Hooks[I2C1_ER_IRQn].fn
+#define ctI2C1_ER NVIC_Hooks[I2C1_ER_IRQn].ct
+#define fnI2C2_EV NVIC_Hooks[I2C2_EV_IRQn].fn
+#define ctI2C2_EV NVIC_Hooks[I2C2_EV_IRQn].ct
+#define fnI2C2_ER NVIC_Hooks[I2C2_ER_IRQn].fn
+#define ctI2C2_ER NVIC_Hooks[I2C2_ER_IRQn].ct
+#define fnSPI1 NVIC_Hooks[SPI1_IRQn].fn
+#define ctSPI1 NVIC_Hooks[SPI1_IRQn].ct
+#define fnSPI2 NVIC_Hooks[SPI2_IRQn].fn
+#define ctSPI2 NVIC_Hooks[SPI2_IRQn].ct
+#define fnUSART1 NVIC_Hooks[USART1_IRQn].fn
+#define ctUSART1 NVIC_Hooks[USART1_IRQn].ct
+#define fnUSART2 NVIC_Hooks[USART2_IRQn].fn
+#define ctUSART2 NVIC_Hooks[USART2_IRQn].ct
+#define fnUSART3 NVIC_Hooks[USART3_IRQn].fn
+#define ctUSART3 NVIC_Hooks[USART3_IRQn].ct
+#define fnRTC_Alarm NVIC_Hooks[RTC_Alarm_IRQn].fn
+#define ctRTC_Alarm NVIC_Hooks[RTC_Alarm_IRQn].ct
+#define fnOTG_FS_WKUP NVIC_Hooks[OTG_FS_WKUP_IRQn].fn
+#define ctOTG_FS_WKUP NVIC_Hooks[OTG_FS_WKUP_IRQn].ct
+#define fnTIM8_CC NVIC_Hooks[TIM8_CC_IRQn].fn
+#define ctTIM8_CC NVIC_Hooks[TIM8_CC_IRQn].ct
+#define fnFSMC NVIC_Hooks[FSMC_IRQn].fn
+#define ctFSMC NVIC_Hooks[FSMC_IRQn].ct
+#define fnSDIO NVIC_Hooks[SDIO_IRQn].fn
+#define ctSDIO NVIC_Hooks[SDIO_IRQn].ct
+#define fnTIM5 NVIC_Hooks[TIM5_IRQn].fn
+#define ctTIM5 NVIC_Hooks[TIM5_IRQn].ct
+#define fnSPI3 NVIC_Hooks[SPI3_IRQn].fn
+#define ctSPI3 NVIC_Hooks[SPI3_IRQn].ct
+#define fnUART4 NVIC_Hooks[UART4_IRQn].fn
+#define ctUART4 NVIC_Hooks[UART4_IRQn].ct
+#define fnUART5 NVIC_Hooks[UART5_IRQn].fn
+#define ctUART5 NVIC_Hooks[UART5_IRQn].ct
+#define fnTIM6_DAC NVIC_Hooks[TIM6_DAC_IRQn].fn
+#define ctTIM6_DAC NVIC_Hooks[TIM6_DAC_IRQn].ct
+#define fnTIM7 NVIC_Hooks[TIM7_IRQn].fn
+#define ctTIM7 NVIC_Hooks[TIM7_IRQn].ct
+#define fnETH NVIC_Hooks[ETH_IRQn].fn
+#define ctETH NVIC_Hooks[ETH_IRQn].ct
+#define fnETH_WKUP NVIC_Hooks[ETH_WKUP_IRQn].fn
+#define ctETH_WKUP NVIC_Hooks[ETH_WKUP_IRQn].ct
+#define fnCAN2_TX NVIC_Hooks[CAN2_TX_IRQn].fn
+#define ctCAN2_TX NVIC_Hooks[CAN2_TX_IRQn].ct
+#define fnCAN2_RX0 NVIC_Hooks[CAN2_RX0_IRQn].fn
+#define ctCAN2_RX0 NVIC_Hooks[CAN2_RX0_IRQn].ct
+#define fnCAN2_RX1 NVIC_Hooks[CAN2_RX1_IRQn].fn
+#define ctCAN2_RX1 NVIC_Hooks[CAN2_RX1_IRQn].ct
+#define fnCAN2_SCE NVIC_Hooks[CAN2_SCE_IRQn].fn
+#define ctCAN2_SCE NVIC_Hooks[CAN2_SCE_IRQn].ct
+#define fnOTG_FS NVIC_Hooks[OTG_FS_IRQn].fn
+#define ctOTG_FS NVIC_Hooks[OTG_FS_IRQn].ct
+#define fnUSART6 NVIC_Hooks[USART6_IRQn].fn
+#define ctUSART6 NVIC_Hooks[USART6_IRQn].ct
+#define fnI2C3_EV NVIC_Hooks[I2C3_EV_IRQn].fn
+#define ctI2C3_EV NVIC_Hooks[I2C3_EV_IRQn].ct
+#define fnI2C3_ER NVIC_Hooks[I2C3_ER_IRQn].fn
+#define ctI2C3_ER NVIC_Hooks[I2C3_ER_IRQn].ct
+#define fnOTG_HS_EP1_OUT NVIC_Hooks[OTG_HS_EP1_OUT_IRQn].fn
+#define ctOTG_HS_EP1_OUT NVIC_Hooks[OTG_HS_EP1_OUT_IRQn].ct
+#define fnOTG_HS_EP1_IN NVIC_Hooks[OTG_HS_EP1_IN_IRQn].fn
+#define ctOTG_HS_EP1_IN NVIC_Hooks[OTG_HS_EP1_IN_IRQn].ct
+#define fnOTG_HS_WKUP NVIC_Hooks[OTG_HS_WKUP_IRQn].fn
+#define ctOTG_HS_WKUP NVIC_Hooks[OTG_HS_WKUP_IRQn].ct
+#define fnOTG_HS NVIC_Hooks[OTG_HS_IRQn].fn
+#define ctOTG_HS NVIC_Hooks[OTG_HS_IRQn].ct
+#define fnDCMI NVIC_Hooks[DCMI_IRQn].fn
+#define ctDCMI NVIC_Hooks[DCMI_IRQn].ct
+#define fnCRYP NVIC_Hooks[CRYP_IRQn].fn
+#define ctCRYP NVIC_Hooks[CRYP_IRQn].ct
+#define fnHASH_RNG NVIC_Hooks[HASH_RNG_IRQn].fn
+#define ctHASH_RNG NVIC_Hooks[HASH_RNG_IRQn].ct
+#define fnFPU NVIC_Hooks[FPU_IRQn].fn
+#define ctFPU NVIC_Hooks[FPU_IRQn].ct
+#define fnSPI4 NVIC_Hooks[SPI4_IRQn].fn
+#define ctSPI4 NVIC_Hooks[SPI4_IRQn].ct
+#define fnSPI5 NVIC_Hooks[SPI5_IRQn].fn
+#define ctSPI5 NVIC_Hooks[SPI5_IRQn].ct
+#define fnSPI6 NVIC_Hooks[SPI6_IRQn].fn
+#define ctSPI6 NVIC_Hooks[SPI6_IRQn].ct
+#define fnADC1 NVIC_Hooks[NVIC_HOOK_ADC1].fn
+#define ctADC1 NVIC_Hooks[NVIC_HOOK_ADC1].ct
+#define fnADC2 NVIC_Hooks[NVIC_HOOK_ADC2].fn
+#define ctADC2 NVIC_Hooks[NVIC_HOOK_ADC2].ct
+#define fnADC3 NVIC_Hooks[NVIC_HOOK_ADC3].fn
+#define ctADC3 NVIC_Hooks[NVIC_HOOK_ADC3].ct
+#define fnTIM1_BRK NVIC_Hooks[NVIC_HOOK_TIM1_BRK].fn
+#define ctTIM1_BRK NVIC_Hooks[NVIC_HOOK_TIM1_BRK].ct
+#define fnTIM9 NVIC_Hooks[NVIC_HOOK_TIM9].fn
+#define ctTIM9 NVIC_Hooks[NVIC_HOOK_TIM9].ct
+#define fnTIM1_UP NVIC_Hooks[NVIC_HOOK_TIM1_UP].fn
+#define ctTIM1_UP NVIC_Hooks[NVIC_HOOK_TIM1_UP].ct
+#define fnTIM10 NVIC_Hooks[NVIC_HOOK_TIM10].fn
+#define ctTIM10 NVIC_Hooks[NVIC_HOOK_TIM10].ct
+#define fnTIM1_TRG_COM NVIC_Hooks[NVIC_HOOK_TIM1_TRG_COM].fn
+#define ctTIM1_TRG_COM NVIC_Hooks[NVIC_HOOK_TIM1_TRG_COM].ct
+#define fnTIM11 NVIC_Hooks[NVIC_HOOK_TIM11].fn
+#define ctTIM11 NVIC_Hooks[NVIC_HOOK_TIM11].ct
+#define fnTIM8_BRK NVIC_Hooks[NVIC_HOOK_TIM8_BRK].fn
+#define ctTIM8_BRK NVIC_Hooks[NVIC_HOOK_TIM8_BRK].ct
+#define fnTIM12 NVIC_Hooks[NVIC_HOOK_TIM12].fn
+#define ctTIM12 NVIC_Hooks[NVIC_HOOK_TIM12].ct
+#define fnTIM8_UP NVIC_Hooks[NVIC_HOOK_TIM8_UP].fn
+#define ctTIM8_UP NVIC_Hooks[NVIC_HOOK_TIM8_UP].ct
+#define fnTIM13 NVIC_Hooks[NVIC_HOOK_TIM13].fn
+#define ctTIM13 NVIC_Hooks[NVIC_HOOK_TIM13].ct
+#define fnTIM8_TRG_COM NVIC_Hooks[NVIC_HOOK_TIM8_TRG_COM].fn
+#define ctTIM8_TRG_COM NVIC_Hooks[NVIC_HOOK_TIM8_TRG_COM].ct
+#define fnTIM14 NVIC_Hooks[NVIC_HOOK_TIM14].fn
+#define ctTIM14 NVIC_Hooks[NVIC_HOOK_TIM14].ct
 
 
 #endif
@@ -9,9 +9,195 @@ typedef struct {
  
 } OneJob_t; // for schedulers?
 
+//---------- trace: the job events in a RAM ring, with SEQUENCER_TRACE defined (otherwise no code at all)
+// An event is 2 words: [31:30] the event, [29:0] the core cycle counter (DWT), then the fnJob address
+// Dump SQ_Trace with the debugger, Count gives the order: the oldest event is at Count & (SQ_TRACE_SIZE-1) once the ring wrapped
+// Tools/SQ_TraceToChrome.py turns the raw dump into a Chrome trace, with the job names from the ELF
+// END is logged for each job return: when a callback was armed, the time until RESUME (same fnJob) is the time spent waiting for the interrupt
+#define SQ_TRACE_ENQUEUE 0
+#define SQ_TRACE_START 1
+#define SQ_TRACE_END 2
+#define SQ_TRACE_RESUME 3
+
+#define SQ_TRACE_SIZE 256 // events, power of two
+
+typedef struct {
+  u32 Stamp; // [31:30] event, [29:0] cycles
+  u32 fnJob;
+} SQ_TraceEvent_t;
+
+typedef struct {
+  SQ_TraceEvent_t Events[SQ_TRACE_SIZE];
+  u32 Count; // free running
+} SQ_Trace_t;
+
+#ifdef SEQUENCER_TRACE
+extern SQ_Trace_t SQ_Trace;
+void NewSQ_Trace(void); // enables the cycle counter, empties the ring
+void SQ_TraceEvent(u32 Event, u32 fnJob);
+#define SQ_TRACE(Event, fnJob) SQ_TraceEvent(Event, (u32)(fnJob))
+#else
+#define SQ_TRACE(Event, fnJob)
+#endif
+
+u32 AddJobToSA(StuffsArtery_t* SA, OneJob_t* Job); // AddToSA() for a job, traced
+
 u32 StartJobToDoInBackground(u32 u); // This creates a non blocking, interrupt based sequence run
 u32 StartJobToDoInForeground(u32 u); // This creates a blocking sequence run. Returns when complete
 u32 JobToDo(u32 u);
+u32 MPSCJobToDo(u32 u); // JobToDo() for a NewSA_MPSC() artery: any interrupt can post jobs, the drain runs without masking them
+u32 AddJobsToSA(StuffsArtery_t* SA, const OneJob_t* const* Jobs, u32 n); // a whole sequence is seen by JobToDo(), or nothing
+
+//---------- bus dispatcher: the arteries of several buses served round robin, one job at a time, from the main loop
+// A job returning with its callback armed leaves its bus waiting for the interrupt, meanwhile the CPU serves the other buses
+// The bus interrupts must be hooked to ResumeJobToDo (not JobToDo) with their artery, it hands the bus back to the dispatcher
+#define BUS_DISPATCH_MAX 8
+
+typedef struct {
+  StuffsArtery_t* SA[BUS_DISPATCH_MAX];
+  u32 Count;
+  u32 Next; // round robin
+  u32 Jobs; // stats
+  u32 Idle; // calls with no bus ready
+} BusDispatcher_t;
+
+u32 NewBusDispatcher(BusDispatcher_t* BD);
+u32 AddBusToDispatcher(BusDispatcher_t* BD, StuffsArtery_t* SA);
+u32 BusDispatcherJobToDo(u32 u); // one job on the next bus ready, returns 0 if no bus was ready
+u32 ResumeJobToDo(u32 u); // the interrupt ending an armed job: JobToDo() continues the sequence, or the dispatcher does
+
+//---------- priority lanes: one StuffsArtery_t of jobs per lane, lane 0 is the most urgent
+// The dispatcher always takes the next job from the most urgent non empty lane, found with one CLZ over the NonEmpty bitmap
+// Jobs must be added with AddJobToLane() so the bitmap stays in sync. Hook LanesJobToDo with the JobLanes_t for the interrupts resuming a sequence.
+#define JOB_LANES_MAX 32
+
+typedef struct {
+  StuffsArtery_t* Lane[JOB_LANES_MAX];
+  u32 NonEmpty; // bit 31 is lane 0, so __CLZ() gives the lane number directly
+  u8 FlagEmptied : 1; // all lanes are empty
+} JobLanes_t;
+
+u32 NewJobLanes(JobLanes_t* JL);
+u32 SetJobLane(JobLanes_t* JL, u32 Lane, StuffsArtery_t* SA);
+u32 AddJobToLane(JobLanes_t* JL, u32 Lane, u32 Job); // Job is a OneJob_t*
+u32 LanesJobToDo(u32 u);
+u32 StartLanesJobToDoInBackground(u32 u);
+u32 StartLanesJobToDoInForeground(u32 u);
+
+//---------- job programs: a whole sequence in const u32 words, run as one job by JobToDo()
+// An op word is [31:24] opcode, [23:0] argument. A call is followed by the function and its parameters, passed like OneJob_t.ctJobs
+// JP_CALL: a non zero return (callback armed) suspends the program, it is glued back Down on its artery and resumes on the callback
+// The artery is a classic or power of two one, or a lane of a JobLanes_t (not MPSC)
+// JP_TEST: the return is kept as the condition for JP_SKIP_IF/JP_SKIP_IFNOT (the function must not arm a callback)
+// JP_CALL_STRIDE/JP_TEST_STRIDE: parameter k (0..n-1) is increased by Stride x the index of the innermost loop (pointer walking a buffer)
+// JP_SKIP_IF(n): skip the next n ops if the condition is non zero. JP_JUMP(i): go to word index i. Loops can be nested JP_LOOP_DEPTH deep
+#define JP_OP_END 0
+#define JP_OP_CALL 1
+#define JP_OP_TEST 2
+#define JP_OP_SKIP_IF 3
+#define JP_OP_SKIP_IFNOT 4
+#define JP_OP_JUMP 5
+#define JP_OP_LOOP 6
+#define JP_OP_ENDLOOP 7
+
+#define JP_LOOP_DEPTH 4
+
+#define JP_CALL(fn,n) ((JP_OP_CALL<<24)|((n)<<20)), (u32)(fn) // then the n (0..4) parameters
+#define JP_CALL_STRIDE(fn,n,k,Stride) ((JP_OP_CALL<<24)|((n)<<20)|(((k)+1)<<16)|(Stride)), (u32)(fn)
+#define JP_TEST(fn,n) ((JP_OP_TEST<<24)|((n)<<20)), (u32)(fn)
+#define JP_TEST_STRIDE(fn,n,k,Stride) ((JP_OP_TEST<<24)|((n)<<20)|(((k)+1)<<16)|(Stride)), (u32)(fn)
+#define JP_SKIP_IF(nOps) ((JP_OP_SKIP_IF<<24)|(nOps))
+#define JP_SKIP_IFNOT(nOps) ((JP_OP_SKIP_IFNOT<<24)|(nOps))
+#define JP_JUMP(Index) ((JP_OP_JUMP<<24)|(Index))
+#define JP_LOOP(Count) ((JP_OP_LOOP<<24)|(Count))
+#define JP_ENDLOOP (JP_OP_ENDLOOP<<24)
+#define JP_END (JP_OP_END<<24)
+
+typedef struct {
+  const u32* Code; // the program, can be const (flash)
+  u32 PC; // word index of the next op
+  u32 Result; // from the last JP_TEST
+  u32 Args[4]; // the parameters of the current call (strides applied)
+  u32 Depth; // loop nesting
+  struct {
+    u32 Start; // word index of the first op of the loop
+    u32 Index;
+    u32 Count;
+  } Loop[JP_LOOP_DEPTH];
+  StuffsArtery_t* SA; // the artery running it
+  OneJob_t Job; // what is queued on the artery
+} JobProgram_t;
+
+u32 AddProgramToSA(StuffsArtery_t* SA, JobProgram_t* P, const u32* Code);
+u32 sq_JobProgram(u32 u); // the job running the program: ctJobs[0] is the JobProgram_t*
+
+//---------- move coalescing: an optional pass over the queued jobs, before the sequence starts
+// Back to back move jobs of the same function on the same bus (ctJobs[0]) are merged into one transfer when their buffers follow each other
+// Each buffer must be non zero and contiguous, and for the buses with a "more coming" flag the first job must have it (the merged job takes the flag of the last one)
+// The queued jobs are not modified (they can be const or recorded for replay): the merged job takes a free slot of the caller pool (up to 32 slots)
+// A slot is free again once its job left the queue: call it when no clipped job of SA is still running (its pool slot could be reused). A merged transfer stays under 64KB
+typedef struct {
+  u32 (*fnMove)(u32); // the sq_*_MoveJob
+  u8 iTX; // ctJobs index of the TX (or only) buffer
+  u8 iRX; // ctJobs index of the RX buffer, 0: none
+  u8 iCount; // ctJobs index of the byte count
+  u8 iMoreComing; // ctJobs index of the "more coming" flag, 0: none
+} MoveJobLayout_t;
+
+extern const MoveJobLayout_t MoveJobLayouts[]; // the bus moves of this repo which can always be merged: SPI_MasterHW
+extern const u32 MoveJobLayoutsCount;
+
+typedef struct {
+  const MoveJobLayout_t* Layouts;
+  u32 LayoutsCount;
+  OneJob_t* Pool; // the merged jobs
+  u32 PoolSize;
+  u32 PoolUsed; // slots queued after the last pass
+  u32 PoolQueued; // bit n: Pool[n] is queued
+
+  u32 Passes; // stats
+  u32 Scanned; // jobs looked at
+  u32 Removed; // jobs merged into the previous one
+  u32 Merged; // transfers created
+  u32 BytesMerged; // bytes moved by the merged transfers
+} JobCoalescer_t;
+
+u32 NewJobCoalescer(JobCoalescer_t* JC, const MoveJobLayout_t* Layouts, u32 LayoutsCount, OneJob_t* Pool, u32 PoolSize);
+u32 CoalesceSA_Moves(StuffsArtery_t* SA, JobCoalescer_t* JC); // returns the number of jobs removed. Nothing must be running on SA (classic mode, not recorded)
+
+//---------- deadline scheduler: earliest deadline first, polled by the main loop (one job per call, like MainLoopServicingSA)
+// Times are absolute Timer->Ticks, so keep one countdown of this timer armed (its hook can post the periodic jobs). Rollover safe up to 2^31 ticks ahead.
+// The caller table holds two binary heaps: the released jobs ordered by deadline from the bottom, the waiting ones ordered by release time from the top
+// A deadline is missed when the job returns after it: Missed and WorstLateness are the feedbacks for self tuning, fnMissed is called on each miss (or FlagMissed)
+typedef struct {
+  OneJob_t* Job;
+  u32 Release; // not started before this tick
+  u32 Deadline; // to be done by this tick
+} DeadlineJob_t;
+
+typedef struct {
+  DeadlineJob_t* Table; // points to the assigned table
+  u32 bCountLimit; // table size in jobs
+  u32 bReady; // released jobs, heap from Table[0]
+  u32 bWaiting; // jobs not released yet, heap from Table[bCountLimit-1]
+  u32 bCountMax; // for stats
+  Timer_t* Timer; // the time base
+
+  u32 Dispatched;
+  u32 Missed;
+  u32 WorstLateness; // in ticks
+
+  u32 (*fnMissed)(u32);
+  u32 ctMissed;
+
+  u8 FlagMissed; // main loop only
+  volatile u8 FlagEmptied; // cleared by AddJobToEDF() from interrupts: a byte of its own, no read-modify-write shared with FlagMissed
+} DeadlineScheduler_t;
+
+u32 NewEDF(DeadlineScheduler_t* E, u32 begin, s32 size, Timer_t* Timer); // size is in jobs
+u32 HookEDF_Missed(DeadlineScheduler_t* E, u32 (*fn)(u32), u32 ct);
+u32 AddJobToEDF(DeadlineScheduler_t* E, OneJob_t* Job, u32 Release, u32 Deadline); // can be called from interrupts
+u32 EDFJobToDo(u32 u); // runs the released job with the earliest deadline, if any. Jobs run to completion (no callback armed)
 
 #endif
 
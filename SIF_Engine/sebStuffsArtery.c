@@ -1,5 +1,6 @@
 
 #include "sebEngine.h"
+#include <string.h> // memset for the MPSC mode
 
 
 
@@ -17,6 +18,43 @@ u32 HookSA_Emptied(StuffsArtery_t* SA, u32 (*fn)(u32), u32 ct) {
   return 0;
 }
 
+u32 HookSA_HighWater(StuffsArtery_t* SA, u32 Level, u32 (*fn)(u32), u32 ct) {
+  
+  SA->fnHighWater = fn;
+  SA->ctHighWater = ct;
+  SA->bHighWater = Level;
+  return 0;
+}
+
+u32 HookSA_LowWater(StuffsArtery_t* SA, u32 Level, u32 (*fn)(u32), u32 ct) {
+  
+  SA->fnLowWater = fn;
+  SA->ctLowWater = ct;
+  SA->bLowWater = Level;
+  return 0;
+}
+
+// The count moved: did it reach a watermark? (the high one going up, the low one going down)
+static void SA_HighWater(StuffsArtery_t* SA, u32 WasCount) {
+  
+  if((SA->bHighWater==0)||(WasCount>=SA->bHighWater)||(SA->bCount<SA->bHighWater)) return;
+  if(SA->fnHighWater) {// tell someone?
+    SA->fnHighWater(SA->ctHighWater);
+  }else{
+    SA->FlagHighWater = 1;
+  };
+}
+
+static void SA_LowWater(StuffsArtery_t* SA) {
+  
+  if((SA->bCount!=SA->bLowWater)||(SA->bLowWater==0)) return;
+  if(SA->fnLowWater) {// tell someone?
+    SA->fnLowWater(SA->ctLowWater);
+  }else{
+    SA->FlagLowWater = 1;
+  };
+}
+
 //==========================================================
 // StrandCreation
 StuffsArtery_t* NewSA(StuffsArtery_t* SA, u32 begin, s32 size) { // size is the number of u32 in the buffer which starts in begin.
@@ -31,6 +69,10 @@ StuffsArtery_t* NewSA(StuffsArtery_t* SA, u32 begin, s32 size) { // size is the
   { // valid SRAM space
     SA->bCountLimit = size; // we validate the strand size (action can occur)
     SA->bCount = 0;
+    SA->Mask = 0; // not in power of two mode
+    SA->iUp = SA->iDown = 0;
+    SA->MPSC = 0; // a table reused after NewSA_MPSC() is classic again
+    SA->ReplayCount = 0; // nothing recorded
     return SA;
   }
   
@@ -74,12 +116,14 @@ u32 GlueSA_Down(StuffsArtery_t* SA) {
   SA->Table[SA->pbDown] = SA->In;
   SA->bCount++;
   if(SA->bCount>SA->bCountMax) SA->bCountMax = SA->bCount;// statistics
+  SA_HighWater(SA, SA->bCount - 1);
   
-  if(SA->bCount==1)
+  if(SA->bCount==1) {
     if(SA->fnNoLongerEmpty) {// if the strand not empty, tell someone?
-    return SA->fnNoLongerEmpty(SA->ctNoLongerEmpty);
-  }else{
-    SA->FlagNoLongerEmpty = 1;
+      return SA->fnNoLongerEmpty(SA->ctNoLongerEmpty);
+    }else{
+      SA->FlagNoLongerEmpty = 1;
+    };
   };
   
   return 0;
@@ -101,12 +145,14 @@ u32 ClipSA_Down(StuffsArtery_t* SA) { // 0 or 1, returns the bit pointer
     SA->pbDown = 0;//-SA->pbLowest; // jump to higher end
   
   // all write done, now doing actions and pending flags
-  if(SA->bCount==0)
+  SA_LowWater(SA);
+  if(SA->bCount==0) {
     if(SA->fnEmptied) {// if the strand turns empty, tell someone?
       return SA->fnEmptied(SA->ctEmptied);
     }else{
       SA->FlagEmptied = 1;
     };
+  };
 
   return 0;// return read valid bit
 }
@@ -135,13 +181,15 @@ u32 GlueSA_Up(StuffsArtery_t* SA) {
   SA->Table[SA->pbUp] = SA->In;
   SA->bCount++;
   if(SA->bCount>SA->bCountMax) SA->bCountMax = SA->bCount;
+  SA_HighWater(SA, SA->bCount - 1);
   
-  if(SA->bCount==1)
-      if(SA->fnNoLongerEmpty) {// if the strand not empty, tell someone?
+  if(SA->bCount==1) {
+    if(SA->fnNoLongerEmpty) {// if the strand not empty, tell someone?
       return SA->fnNoLongerEmpty(SA->ctNoLongerEmpty); //!!! this can activate interrupt IRQ...
     }else{
       SA->FlagNoLongerEmpty = 1;
     };
+  };
 
   return 0;
 }
@@ -161,12 +209,14 @@ u32 ClipSA_Up(StuffsArtery_t* SA) { // 0 or 1
   if(SA->pbUp>SA->pbHighest)//- -underflow if(SA->pbUp<SA->pbLowest) // circular memory space bottom reached.
     SA->pbUp = SA->pbHighest; // jump to higher end
 
-  if(SA->bCount==0)
+  SA_LowWater(SA);
+  if(SA->bCount==0) {
     if(SA->fnEmptied) {// if the strand turns empty, tell someone?
       return SA->fnEmptied(SA->ctEmptied);
     }else{
       SA->FlagEmptied = 1;
     };
+  };
 
   return 0;// return read valid bit
 }
@@ -182,3 +232,274 @@ u32 AddToSA(StuffsArtery_t* SA, u32 In) {
 }
 
 
+
+
+//============================================
+// Power of two mode: iDown and iUp (exclusive) run freely as u16 and are masked to index the table
+// The count is iUp - iDown: no u16 underflow trick to detect the rollover, full and empty never ambiguous
+// bCount is still updated for the pollers, but the classic Glue/Clip functions must not be mixed in: they don't move iUp/iDown.
+// The sequencer (JobToDo, lanes, dispatcher) checks Mask and uses these functions.
+StuffsArtery_t* NewSA_Pow2(StuffsArtery_t* SA, u32 begin, s32 size) {
+
+  if((size<=0)||(size>0x8000)||(size & (size - 1)))
+    while(1); // the size must be a power of two, and fit the u16 indexes
+  
+  NewSA(SA, begin, size);
+  SA->Mask = size - 1;
+  SA->iUp = SA->iDown = 0;
+  return SA;
+}
+
+u32 GlueSA_DownPow2(StuffsArtery_t* SA) {
+
+  u16 Down = SA->iDown - 1;
+  
+  if(SA->bCount>SA->Mask)
+    while(1); // too big! improve memory allocation
+  
+  SA->Table[Down & SA->Mask] = SA->In;
+  SA->iDown = Down;
+  SA->bCount = (u16)(SA->iUp - Down);
+  if(SA->bCount>SA->bCountMax) SA->bCountMax = SA->bCount;// statistics
+  SA_HighWater(SA, SA->bCount - 1);
+  
+  if(SA->bCount==1) {
+    if(SA->fnNoLongerEmpty) {// if the strand not empty, tell someone?
+      return SA->fnNoLongerEmpty(SA->ctNoLongerEmpty);
+    }else{
+      SA->FlagNoLongerEmpty = 1;
+    };
+  };
+  
+  return 0;
+}
+
+u32 ClipSA_DownPow2(StuffsArtery_t* SA) {
+
+  u16 Down = SA->iDown;
+  
+  if(SA->iUp==Down) // if strand empty, nothing to read from it, error
+    while(1); // error, nothing on this strand, check its size is non zero first!
+  
+  SA->Out = SA->Table[Down & SA->Mask];
+  SA->iDown = ++Down;
+  SA->bCount = (u16)(SA->iUp - Down);
+  
+  SA_LowWater(SA);
+  if(SA->bCount==0) {
+    if(SA->fnEmptied) {// if the strand turns empty, tell someone?
+      return SA->fnEmptied(SA->ctEmptied);
+    }else{
+      SA->FlagEmptied = 1;
+    };
+  };
+  
+  return 0;
+}
+
+u32 GlueSA_UpPow2(StuffsArtery_t* SA) {
+
+  u16 Up = SA->iUp;
+  
+  if(SA->bCount>SA->Mask)
+    while(1); // too big! improve memory allocation
+  
+  SA->Table[Up & SA->Mask] = SA->In;
+  SA->iUp = ++Up;
+  SA->bCount = (u16)(Up - SA->iDown);
+  if(SA->bCount>SA->bCountMax) SA->bCountMax = SA->bCount;
+  SA_HighWater(SA, SA->bCount - 1);
+  
+  if(SA->bCount==1) {
+    if(SA->fnNoLongerEmpty) {// if the strand not empty, tell someone?
+      return SA->fnNoLongerEmpty(SA->ctNoLongerEmpty); //!!! this can activate interrupt IRQ...
+    }else{
+      SA->FlagNoLongerEmpty = 1;
+    };
+  };
+  
+  return 0;
+}
+
+u32 ClipSA_UpPow2(StuffsArtery_t* SA) {
+
+  u16 Up = SA->iUp;
+  
+  if(Up==SA->iDown) // if strand empty, nothing to read from it, error
+    while(1); // error, nothing on this strand, check its size is non zero first!
+  
+  Up--;
+  SA->Out = SA->Table[Up & SA->Mask];
+  SA->iUp = Up;
+  SA->bCount = (u16)(Up - SA->iDown);
+  
+  SA_LowWater(SA);
+  if(SA->bCount==0) {
+    if(SA->fnEmptied) {// if the strand turns empty, tell someone?
+      return SA->fnEmptied(SA->ctEmptied);
+    }else{
+      SA->FlagEmptied = 1;
+    };
+  };
+  
+  return 0;
+}
+
+
+//============================================
+// Batch: n items glued Up under one critical section, published by a single count update
+// Whoever clips (even from an interrupt) sees the whole batch or nothing, the hooks are triggered once after the batch
+u32 GlueSA_UpN(StuffsArtery_t* SA, const u32* Items, u32 n) {
+
+  u32 Primask, i, Next, WasCount;
+
+  if(n==0) return 0; // nothing to glue
+
+  Primask = __get_PRIMASK();
+  __disable_irq();
+
+  WasCount = SA->bCount;
+  if((WasCount + n)>SA->bCountLimit)
+    while(1); // too big! improve memory allocation
+
+  if(SA->Mask) { // power of two mode
+    for(i=0;i<n;i++)
+      SA->Table[(u16)(SA->iUp + i) & SA->Mask] = Items[i];
+    SA->iUp += n;
+  }else{
+    if(WasCount==0) { // if strand empty: the batch starts on the arbitrary left side
+      Next = SA->pbDown = 0;
+    }else{
+      Next = SA->pbUp + 1;
+      if(Next>SA->pbHighest) // rollover if out of range
+        Next = 0;
+    };
+    for(i=0;i<n;i++) {
+      SA->Table[Next] = Items[i];
+      SA->pbUp = Next;
+      Next++;
+      if(Next>SA->pbHighest) // rollover if out of range
+        Next = 0;
+    };
+  };
+
+  SA->In = Items[n-1]; // as if glued one by one
+  SA->bCount = WasCount + n; // publish
+  if(SA->bCount>SA->bCountMax) SA->bCountMax = SA->bCount;
+
+  __set_PRIMASK(Primask);
+
+  SA_HighWater(SA, WasCount);
+  if(WasCount==0) {
+    if(SA->fnNoLongerEmpty) {// if the strand not empty, tell someone?
+      return SA->fnNoLongerEmpty(SA->ctNoLongerEmpty);
+    }else{
+      SA->FlagNoLongerEmpty = 1;
+    };
+  };
+
+  return 0;
+}
+
+
+//============================================
+// Multiple producers / single consumer: iUp is reserved by compare and swap, iDown belongs to the consumer
+// Each slot is published by its (non zero) item and released by the consumer writing 0 back, before iDown moves
+// The portable path (GCC/Clang atomics) is for host builds and tests.
+#if defined(__ARM_ARCH_7M__) || defined(__ARM_ARCH_7EM__)
+#define SA_MPSC_LDREX
+#endif
+
+StuffsArtery_t* NewSA_MPSC(StuffsArtery_t* SA, u32 begin, s32 size) {
+
+  NewSA_Pow2(SA, begin, size);
+  memset((u32*)begin, 0, size * sizeof(u32)); // all slots free
+  SA->MPSC = 1;
+  return SA;
+}
+
+static u32 SA_MPSC_Reserve(StuffsArtery_t* SA) { // returns the reserved index, or 0x10000 if full
+
+  u16 Up;
+#ifdef SA_MPSC_LDREX
+  do {
+    Up = __LDREXH(&SA->iUp);
+    if((u16)(Up - *(volatile u16*)&SA->iDown)>SA->Mask) {
+      __CLREX();
+      return 0x10000; // full
+    };
+  }while(__STREXH(Up + 1, &SA->iUp));
+#else
+  Up = __atomic_load_n(&SA->iUp, __ATOMIC_RELAXED);
+  do {
+    if((u16)(Up - __atomic_load_n(&SA->iDown, __ATOMIC_ACQUIRE))>SA->Mask)
+      return 0x10000; // full
+  }while(!__atomic_compare_exchange_n(&SA->iUp, &Up, (u16)(Up + 1), 1, __ATOMIC_ACQ_REL, __ATOMIC_RELAXED));
+#endif
+  return Up;
+}
+
+u32 GlueSA_MPSC(StuffsArtery_t* SA, u32 Item) {
+
+  u32 Up;
+
+  if(Item==0) while(1); // 0 marks a free slot, it can't be queued
+
+  Up = SA_MPSC_Reserve(SA);
+  if(Up>0xFFFF) return 0; // full
+
+  __DMB(); // what the item points to must be written before the item is published
+  *(volatile u32*)&SA->Table[Up & SA->Mask] = Item;
+  return 1;
+}
+
+u32 ClipSA_MPSC(StuffsArtery_t* SA) {
+
+  u16 Down = SA->iDown; // we own it
+  u32 Item = *(volatile u32*)&SA->Table[Down & SA->Mask];
+
+  if(Item==0) return 0; // empty, or the next producer did not write its slot yet
+
+  __DMB(); // read the item before releasing the slot
+  SA->Table[Down & SA->Mask] = 0;
+  __DMB(); // the slot must be free before the producers can see it
+  *(volatile u16*)&SA->iDown = Down + 1;
+
+  SA->Out = Item;
+  return Item;
+}
+
+u32 GetSA_MPSC_Count(StuffsArtery_t* SA) {
+
+  return (u16)(*(volatile u16*)&SA->iUp - *(volatile u16*)&SA->iDown);
+}
+
+
+//============================================
+// Replay mode (classic mode only): the items stay in the table when clipped, re-arming puts back the tail and the count
+u32 RecordSA_Replay(StuffsArtery_t* SA) {
+
+  if((SA->bCount==0)||(SA->Mask)) while(1); // nothing to record, or not in classic mode
+
+  SA->ReplayDown = SA->pbDown;
+  SA->ReplayCount = SA->bCount;
+  return 0;
+}
+
+u32 RearmSA_Replay(StuffsArtery_t* SA) {
+
+  u32 Up;
+
+  if(SA->ReplayCount==0) while(1); // nothing recorded
+  if(SA->bCount || SA->JobArmed) return 0; // still running, or its last job still waits for its callback (ResumeJobToDo() clears it)
+
+  Up = SA->ReplayDown + SA->ReplayCount - 1;
+  if(Up>SA->pbHighest) // rollover
+    Up -= SA->bCountLimit;
+
+  SA->pbDown = SA->ReplayDown;
+  SA->pbUp = Up;
+  SA->FlagEmptied = 0;
+  SA->bCount = SA->ReplayCount; // last, the sequence is armed
+  return 1;
+}
@@ -11,6 +11,13 @@ typedef struct {
   u16 bCountMax; // This is for stats, to know how much we use the memory in real case over time
   u16 pbDown; // current tail (low address)
   u16 pbUp; // current head (high address)
+  u16 iUp; // power of two mode: one past the head, free running
+  u16 iDown; // power of two mode: the tail, free running
+  u16 Mask; // power of two mode: size - 1
+  u16 bHighWater; // 0: not used
+  u16 bLowWater; // 0: not used (see fnEmptied)
+  u16 ReplayDown; // replay mode: where the recorded sequence starts
+  u16 ReplayCount; // replay mode: how many items, 0: nothing recorded
 
   u32 In; // the item (pointer to it) to glue
   u32 Out; // the item (pointer to it) that was clipped
@@ -27,9 +34,20 @@ typedef struct {
   u32 ctNoLongerEmpty;
   u32 (*fnEmptied)(u32);
   u32 ctEmptied;
+  u32 (*fnHighWater)(u32); // bCount reached bHighWater from below
+  u32 ctHighWater;
+  u32 (*fnLowWater)(u32); // bCount went down to bLowWater from above
+  u32 ctLowWater;
   
+  // not bitfields: the bus interrupt writes these while the main loop writes the flags below (a shared byte would lose updates)
+  volatile u8 JobArmed; // sequencer: the last job clipped (Out) armed a callback, the next JobToDo() is its resume
+  volatile u8 Dispatched; // sequencer: served by a BusDispatcher_t, the resume hands it back instead of running JobToDo()
+
   u8 FlagNoLongerEmpty : 1; 
   u8 FlagEmptied : 1; 
+  u8 FlagHighWater : 1;
+  u8 FlagLowWater : 1;
+  u8 MPSC : 1; // set by NewSA_MPSC, the artery is then only driven by the *_MPSC functions
 //  u8 FlagFull : 1; // unused
 //  u8 FlagNoLongerFull : 1; // unused
   
@@ -37,6 +55,10 @@ typedef struct {
 
 
 StuffsArtery_t* NewSA(StuffsArtery_t* SA, u32 begin, s32 size);
+u32 HookSA_NoLongerEmpty(StuffsArtery_t* SA, u32 (*fn)(u32), u32 ct);
+u32 HookSA_Emptied(StuffsArtery_t* SA, u32 (*fn)(u32), u32 ct);
+u32 HookSA_HighWater(StuffsArtery_t* SA, u32 Level, u32 (*fn)(u32), u32 ct); // wake a drainer once per batch
+u32 HookSA_LowWater(StuffsArtery_t* SA, u32 Level, u32 (*fn)(u32), u32 ct);
 
 u32 GetSA_Down(StuffsArtery_t* SA);
 u32 GetSA_Up(StuffsArtery_t* SA);
@@ -47,6 +69,28 @@ u32 GlueSA_Up(StuffsArtery_t* SA);
 u32 ClipSA_Up(StuffsArtery_t* SA);
 
 u32 AddToSA(StuffsArtery_t* SA, u32 In);
+// replay: clipping does not erase the items, so the current content can be recorded once and run again and again
+// Re-arming is O(1) and copies nothing: it can be done from an interrupt (timer countdown hook, EXTI...)
+// Don't glue on a recorded artery: the new items would overwrite the sequence
+u32 RecordSA_Replay(StuffsArtery_t* SA); // the current content becomes the sequence to replay
+u32 RearmSA_Replay(StuffsArtery_t* SA); // returns 0 if the previous run is not over (nothing done)
+u32 ReplaySA(u32 u); // hook compatible: re-arm and run JobToDo() on this artery
+u32 GlueSA_UpN(StuffsArtery_t* SA, const u32* Items, u32 n); // all or nothing for the clipping side, one critical section
+
+// power of two size (up to 32768): free running indexes and a mask, no rollover test
+StuffsArtery_t* NewSA_Pow2(StuffsArtery_t* SA, u32 begin, s32 size);
+u32 GlueSA_DownPow2(StuffsArtery_t* SA);
+u32 ClipSA_DownPow2(StuffsArtery_t* SA);
+u32 GlueSA_UpPow2(StuffsArtery_t* SA);
+u32 ClipSA_UpPow2(StuffsArtery_t* SA);
+
+// multiple producers (interrupts of any priority, main loop) / single consumer, without interrupt masking
+// Power of two size (up to 32768), items must be non zero (pointers): 0 marks a free slot. bCount and the hooks are not used.
+// A producer reserves its slot with LDREX/STREX on iUp, then writes it: a producer interrupted in between holds back the items after its own
+StuffsArtery_t* NewSA_MPSC(StuffsArtery_t* SA, u32 begin, s32 size);
+u32 GlueSA_MPSC(StuffsArtery_t* SA, u32 Item); // any context, returns 0 if full (the item is not queued)
+u32 ClipSA_MPSC(StuffsArtery_t* SA); // consumer only, returns 0 if nothing (yet) to clip
+u32 GetSA_MPSC_Count(StuffsArtery_t* SA); // snapshot, including the slots reserved and not yet written
 // the big question is should we create an array of pointer+size, pointer hooks, etc...
 // can we run a sequence with this?
 